@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <stdexcept>
 
 /**
@@ -15,3 +16,76 @@ public:
 	{
 	}
 };
+
+/**
+*	@brief Thrown to stop loading an asset that was cancelled
+*/
+class AssetLoadCancelledException : public std::runtime_error
+{
+public:
+	AssetLoadCancelledException()
+		: std::runtime_error("Asset loading was cancelled")
+	{
+	}
+};
+
+/**
+*	@brief Progress of an asset being loaded in the background. Can be used from any thread.
+*	Loading can be split into steps that each cover part of the overall progress,
+*	so code that only knows about its own work can report progress with @ref SetStepProgress.
+*/
+class AssetLoadProgress final
+{
+public:
+	/**
+	*	@brief Progress in the range [0, 1].
+	*/
+	float GetProgress() const { return _progress.load(std::memory_order_relaxed); }
+
+	void SetProgress(float progress) { _progress.store(progress, std::memory_order_relaxed); }
+
+	/**
+	*	@brief Starts a step that covers the range [start, end] of the overall progress.
+	*	Must not be called while other threads are still reporting progress for the previous step.
+	*/
+	void BeginStep(float start, float end)
+	{
+		_stepStart.store(start, std::memory_order_relaxed);
+		_stepEnd.store(end, std::memory_order_relaxed);
+		SetProgress(start);
+	}
+
+	/**
+	*	@brief Sets the progress of the current step.
+	*	@param fraction Progress of the step in the range [0, 1]
+	*/
+	void SetStepProgress(float fraction)
+	{
+		const float start = _stepStart.load(std::memory_order_relaxed);
+		const float end = _stepEnd.load(std::memory_order_relaxed);
+
+		SetProgress(start + ((end - start) * fraction));
+	}
+
+	bool IsCancelled() const { return _cancelled.load(std::memory_order_relaxed); }
+
+	void Cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+
+	/**
+	*	@brief Throws AssetLoadCancelledException if loading was cancelled.
+	*	Called by providers between steps to stop loading early.
+	*/
+	void ThrowIfCancelled() const
+	{
+		if (IsCancelled())
+		{
+			throw AssetLoadCancelledException();
+		}
+	}
+
+private:
+	std::atomic<float> _progress{0};
+	std::atomic<float> _stepStart{0};
+	std::atomic<float> _stepEnd{1};
+	std::atomic<bool> _cancelled{false};
+};
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cassert>
+#include <exception>
 
 #include <QFileInfo>
 #include <QMessageBox>
@@ -10,6 +11,8 @@
 #include "application/AssetManager.hpp"
 #include "application/Assets.hpp"
 
+#include "filesystem/FileSystem.hpp"
+
 #include "qt/QtLogging.hpp"
 
 #include "settings/ApplicationSettings.hpp"
@@ -18,15 +21,39 @@
 
 #include "ui/MainWindow.hpp"
 
+#include "utility/Profiling.hpp"
 #include "utility/Utility.hpp"
 
+namespace
+{
+// Loading uses a lot of memory for large models, so only a few files are loaded at the same time.
+constexpr int MaxConcurrentLoads = 2;
+}
+
+struct AssetList::PendingLoad
+{
+	QString FileName;
+	std::unique_ptr<IFileSystem> FileSystem;
+	AssetLoadProgress Progress;
+
+	// Set on the worker thread.
+	AssetFinalizer Finalizer;
+	std::string Error;
+};
+
 AssetList::AssetList(AssetManager* application, std::shared_ptr<spdlog::logger> logger)
 	: _application(application)
 	, _logger(logger)
 {
+	_loadThreadPool.setMaxThreadCount(MaxConcurrentLoads);
 }
 
-AssetList::~AssetList() = default;
+AssetList::~AssetList()
+{
+	// Results that arrive after this are discarded along with the object's pending events.
+	CancelPendingLoads();
+	WaitForPendingLoads();
+}
 
 int AssetList::IndexOf(const Asset* asset) const
 {
@@ -63,41 +90,45 @@ void AssetList::SetCurrent(Asset* asset)
 	emit ActiveAssetChanged(_currentAsset);
 }
 
-AssetLoadResult AssetList::TryLoad(const QString& fileName)
+void AssetList::Load(const QString& fileName)
 {
-	const AssetLoadResult loadResult = TryLoadCore(fileName);
+	if (const auto result = TryStartLoad(fileName); result)
+	{
+		NotifyLoadFinished(fileName, *result);
+	}
+}
 
-	return std::visit([&, this](auto&& result) -> AssetLoadResult
-		{
-			using T = std::decay_t<decltype(result)>;
+float AssetList::GetPendingLoadProgress() const
+{
+	if (_pendingLoads.empty())
+	{
+		return 0;
+	}
 
-			if constexpr (std::is_same_v<T, AssetLoadAction>)
-			{
-				switch (result)
-				{
-				case AssetLoadAction::Success:
-					_application->GetApplicationSettings()->GetRecentFiles()->Add(fileName);
-					break;
+	float progress = 0;
 
-				case AssetLoadAction::Failed:
-					_application->GetApplicationSettings()->GetRecentFiles()->Remove(fileName);
-					break;
-				}
-			}
-			else if constexpr (std::is_same_v<T, AssetLoadInExternalProgram>)
-			{
-				// Let the caller handle this.
-			}
-			else
-			{
-				static_assert(always_false_v<T>, "Unhandled Asset load return type");
-			}
+	for (const auto& load : _pendingLoads)
+	{
+		progress += load->Progress.GetProgress();
+	}
 
-			return result;
-		}, loadResult);
+	return progress / _pendingLoads.size();
 }
 
-AssetLoadResult AssetList::TryLoadCore(QString fileName)
+void AssetList::CancelPendingLoads()
+{
+	for (const auto& load : _pendingLoads)
+	{
+		load->Progress.Cancel();
+	}
+}
+
+void AssetList::WaitForPendingLoads()
+{
+	_loadThreadPool.waitForDone();
+}
+
+std::optional<AssetLoadResult> AssetList::TryStartLoad(QString fileName)
 {
 	fileName = fileName.trimmed();
 
@@ -133,8 +164,19 @@ AssetLoadResult AssetList::TryLoadCore(QString fileName)
 		}
 	}
 
+	if (std::any_of(_pendingLoads.begin(), _pendingLoads.end(), [&](const auto& load)
+		{
+			return load->FileName == fileName;
+		}))
+	{
+		_logger->trace("Asset \"{}\" is already being loaded", fileName);
+		return AssetLoadAction::Cancelled;
+	}
+
 	if (_application->GetApplicationSettings()->OneAssetAtATime)
 	{
+		CancelPendingLoads();
+
 		if (!TryClose(0, true))
 		{
 			//User canceled, abort load
@@ -142,9 +184,82 @@ AssetLoadResult AssetList::TryLoadCore(QString fileName)
 		}
 	}
 
+	const auto load = std::make_shared<PendingLoad>();
+
+	load->FileName = fileName;
+
+	// Game configurations can be changed on the main thread while the asset is loading.
+	load->FileSystem = std::make_unique<FileSystem>();
+	_application->InitializeFileSystem(*load->FileSystem, fileName);
+
+	_pendingLoads.push_back(load);
+
+	_loadThreadPool.start([this, load]
+		{
+			HLAM_PROFILE_SCOPE("AssetList::LoadInBackground");
+
+			try
+			{
+				load->Progress.ThrowIfCancelled();
+
+				load->Finalizer = _application->GetAssetProviderRegistry()->LoadInBackground(
+					load->FileName, std::move(load->FileSystem), load->Progress);
+			}
+			catch (const AssetLoadCancelledException&)
+			{
+				// Checked on the main thread.
+			}
+			catch (const std::exception& e)
+			{
+				load->Error = e.what();
+			}
+
+			QMetaObject::invokeMethod(this, [this, load]
+				{
+					OnBackgroundLoadFinished(load);
+				}, Qt::QueuedConnection);
+		});
+
+	emit PendingLoadsChanged();
+
+	return {};
+}
+
+void AssetList::OnBackgroundLoadFinished(const std::shared_ptr<PendingLoad>& load)
+{
+	std::erase(_pendingLoads, load);
+
+	AssetLoadResult result = AssetLoadAction::Failed;
+
+	if (load->Progress.IsCancelled())
+	{
+		_logger->trace("Cancelled loading asset \"{}\"", load->FileName);
+		result = AssetLoadAction::Cancelled;
+	}
+	else if (!load->Finalizer)
+	{
+		_logger->error("Error loading asset \"{}\":\n{}", load->FileName, load->Error);
+	}
+	else
+	{
+		result = FinishLoad(*load);
+	}
+
+	emit PendingLoadsChanged();
+
+	NotifyLoadFinished(load->FileName, result);
+}
+
+AssetLoadResult AssetList::FinishLoad(PendingLoad& load)
+{
+	const QString& fileName = load.FileName;
+
 	try
 	{
-		auto asset = _application->GetAssetProviderRegistry()->Load(fileName);
+		// Creating the asset uploads its graphics resources.
+		const TimerSuspender timerSuspender{_application};
+
+		auto asset = load.Finalizer();
 
 		return std::visit([&, this](auto&& result) -> AssetLoadResult
 			{
@@ -186,6 +301,25 @@ AssetLoadResult AssetList::TryLoadCore(QString fileName)
 	return AssetLoadAction::Failed;
 }
 
+void AssetList::NotifyLoadFinished(const QString& fileName, const AssetLoadResult& result)
+{
+	if (const auto action = std::get_if<AssetLoadAction>(&result); action)
+	{
+		switch (*action)
+		{
+		case AssetLoadAction::Success:
+			_application->GetApplicationSettings()->GetRecentFiles()->Add(fileName);
+			break;
+
+		case AssetLoadAction::Failed:
+			_application->GetApplicationSettings()->GetRecentFiles()->Remove(fileName);
+			break;
+		}
+	}
+
+	emit LoadFinished(fileName, result);
+}
+
 bool AssetList::TryClose(int index, bool verifyUnsavedChanges, bool allowCancel)
 {
 	assert(index != -1);
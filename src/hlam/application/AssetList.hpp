@@ -1,11 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <variant>
 #include <vector>
 
 #include <QObject>
 #include <QPointer>
+#include <QString>
+#include <QThreadPool>
 
 #include <spdlog/logger.h>
 
@@ -40,7 +43,29 @@ public:
 
 	void SetCurrent(Asset* asset);
 
-	AssetLoadResult TryLoad(const QString& fileName);
+	/**
+	*	@brief Loads the given file. Reading and converting the file is done on a worker thread,
+	*	only the last part of loading is done on the main thread.
+	*	@ref LoadFinished is emitted exactly once for each call, possibly before this returns.
+	*/
+	void Load(const QString& fileName);
+
+	std::size_t GetPendingLoadCount() const { return _pendingLoads.size(); }
+
+	/**
+	*	@brief Average progress of all pending loads in the range [0, 1].
+	*/
+	float GetPendingLoadProgress() const;
+
+	/**
+	*	@brief Cancels all pending loads. Cancelled loads finish with AssetLoadAction::Cancelled.
+	*/
+	void CancelPendingLoads();
+
+	/**
+	*	@brief Blocks until the worker thread part of all pending loads has finished.
+	*/
+	void WaitForPendingLoads();
 
 	bool TryClose(int index, bool verifyUnsavedChanges, bool allowCancel = true);
 
@@ -51,9 +76,28 @@ public:
 	bool RefreshCurrent();
 
 private:
-	AssetLoadResult TryLoadCore(QString fileName);
+	struct PendingLoad;
+
+	/**
+	*	@brief Starts loading the given file on a worker thread.
+	*	@return The result if loading finished immediately, for example if the file doesn't exist
+	*/
+	std::optional<AssetLoadResult> TryStartLoad(QString fileName);
+
+	void OnBackgroundLoadFinished(const std::shared_ptr<PendingLoad>& load);
+
+	AssetLoadResult FinishLoad(PendingLoad& load);
+
+	void NotifyLoadFinished(const QString& fileName, const AssetLoadResult& result);
 
 signals:
+	void LoadFinished(const QString& fileName, const AssetLoadResult& result);
+
+	/**
+	*	@brief Emitted when a load has started or finished.
+	*/
+	void PendingLoadsChanged();
+
 	void AssetAdded(int index);
 	void AboutToCloseAsset(int index);
 	void AboutToRemoveAsset(int index);
@@ -69,4 +113,7 @@ private:
 
 	std::vector<std::unique_ptr<Asset>> _assets;
 	QPointer<Asset> _currentAsset;
+
+	QThreadPool _loadThreadPool;
+	std::vector<std::shared_ptr<PendingLoad>> _pendingLoads;
 };
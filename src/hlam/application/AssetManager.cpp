@@ -7,6 +7,7 @@
 #include <QFileInfo>
 #include <QLayout>
 #include <QMessageBox>
+#include <QMouseEvent>
 #include <QOpenGLFunctions_1_1>
 #include <QOpenGLDebugLogger>
 #include <QProcess>
@@ -22,6 +23,8 @@
 #include "filesystem/IFileSystem.hpp"
 
 #include "graphics/IGraphicsContext.hpp"
+#include "graphics/OpenGLStateCache.hpp"
+#include "graphics/Scene.hpp"
 #include "graphics/TextureLoader.hpp"
 
 #include "plugins/IAssetManagerPlugin.hpp"
@@ -49,12 +52,22 @@
 #include "ui/options/gameconfigurations/OptionsPageFileSystem.hpp"
 #include "ui/options/gameconfigurations/OptionsPageGameConfigurations.hpp"
 
+#include "utility/Profiling.hpp"
 #include "utility/WorldTime.hpp"
 
 Q_LOGGING_CATEGORY(HLAM, "hlam")
 Q_LOGGING_CATEGORY(HLAMFileSystem, "hlam.filesystem")
 Q_LOGGING_CATEGORY(HLAMSoundSystem, "hlam.soundsystem")
 
+// Maximum amount of time simulated by a single tick.
+// Prevents the simulation from running many steps in a row to catch up after the program has stalled.
+constexpr double MaxSimulationTimePerTick = 0.25;
+
+static double GetCurrentRealTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 AssetManager::AssetManager(
 	QApplication* guiApplication,
 	const std::shared_ptr<ApplicationSettings>& applicationSettings,
@@ -70,6 +83,7 @@ AssetManager::AssetManager(
 
 	, _graphicsContext(std::move(graphicsContext))
 	, _openglFunctions(std::make_unique<QOpenGLFunctions_1_1>())
+	, _openglStateCache(std::make_unique<graphics::OpenGLStateCache>(_openglFunctions.get()))
 	, _textureLoader(std::make_unique<graphics::TextureLoader>(_openglFunctions.get()))
 
 	, _assetProviderRegistry(std::make_unique<AssetProviderRegistry>())
@@ -124,19 +138,28 @@ AssetManager::AssetManager(
 	OnApplicationStateChanged(_guiApplication->applicationState());
 
 	connect(this, &AssetManager::SettingsChanged, this, &AssetManager::OnSettingsChanged);
+	connect(this, &AssetManager::SettingsChanged, this, &AssetManager::RequestRedraw);
 
 	connect(_timer, &QTimer::timeout, this, &AssetManager::OnTimerTick);
 	connect(_applicationSettings.get(), &ApplicationSettings::TickRateChanged, this, &AssetManager::OnTickRateChanged);
 	connect(_applicationSettings.get(), &ApplicationSettings::StylePathChanged, this, &AssetManager::OnStylePathChanged);
 
 	connect(_applicationSettings.get(), &ApplicationSettings::ResizeTexturesToPowerOf2Changed,
-		this, [this](bool value) { _textureLoader->SetResizeToPowerOf2(value); });
+		this, [this](bool value)
+		{
+			_textureLoader->SetResizeToPowerOf2(value);
+			RequestRedraw();
+		});
 	connect(_applicationSettings.get(), &ApplicationSettings::TextureFiltersChanged,
 		this, [this](graphics::TextureFilter minFilter, graphics::TextureFilter magFilter, graphics::MipmapFilter mipmapFilter)
 		{
 			_textureLoader->SetTextureFilters(minFilter, magFilter, mipmapFilter);
+			RequestRedraw();
 		});
 
+	// The timer stops while nothing is changing, so any user input needs to wake it up.
+	_guiApplication->installEventFilter(this);
+
 	connect(_applicationSettings.get(), &ApplicationSettings::SceneWidgetSettingsChanged,
 		this, &AssetManager::RecreateSceneWidget);
 
@@ -208,9 +231,12 @@ void AssetManager::RecreateSceneWidget()
 
 	// The filter needs to be installed on the main window (handles dropping on any child widget),
 	// as well as the scene widget (has special behavior due to being OpenGL)
-	_sceneWidget = new SceneWidget(this, GetOpenGLFunctions(), GetTextureLoader());
+	_sceneWidget = new SceneWidget(this, GetOpenGLFunctions(), GetOpenGLStateCache(), GetTextureLoader());
 	_sceneWidget->installEventFilter(GetDragNDropEventFilter());
 
+	connect(_sceneWidget, &SceneWidget::AboutToDraw, this, &AssetManager::UpdateInterpolationFactor);
+	connect(_sceneWidget, &QOpenGLWindow::frameSwapped, this, &AssetManager::OnSceneWidgetFrameSwapped);
+
 	emit SceneWidgetRecreated();
 
 	// Delete the widget after notifying everybody so any remaining references to this can be removed.
@@ -220,6 +246,28 @@ void AssetManager::RecreateSceneWidget()
 	}
 }
 
+void AssetManager::RequestRedraw()
+{
+	if (_sceneWidget)
+	{
+		if (auto scene = _sceneWidget->GetScene(); scene)
+		{
+			scene->Invalidate();
+		}
+	}
+
+	WakeTimer();
+}
+
+void AssetManager::WakeTimer()
+{
+	// Don't restart the timer if it's been paused or stopped.
+	if (_isTimerIdle && _timerPauseCount == 0)
+	{
+		StartTimer();
+	}
+}
+
 bool AssetManager::IsInFullscreenMode()
 {
 	return _mainWindow->isFullScreen();
@@ -227,6 +275,8 @@ bool AssetManager::IsInFullscreenMode()
 
 void AssetManager::StartTimer()
 {
+	_idleTickCount = 0;
+	_isTimerIdle = false;
 	_timer->start(1000 / _applicationSettings->GetTickRate());
 }
 
@@ -333,9 +383,14 @@ void AssetManager::OnMainWindowClosing()
 	_mainWindow = nullptr;
 
 	_timer->stop();
+	_isTimerIdle = false;
 
 	GetApplicationSettings()->SaveSettings();
 
+	// Assets that are still loading may be using the providers.
+	_assets->CancelPendingLoads();
+	_assets->WaitForPendingLoads();
+
 	GetAssetProviderRegistry()->Shutdown();
 
 	GetSettings()->sync();
@@ -376,32 +431,130 @@ void AssetManager::OnSettingsChanged()
 
 void AssetManager::OnTimerTick()
 {
-	const auto timeMillis{std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()};
+	HLAM_PROFILE_SCOPE("AssetManager::OnTimerTick");
 
-	const double currentTime = timeMillis / 1000.0;
+	const double currentTime = GetCurrentRealTime();
 
-	double flFrameTime = currentTime - _worldTime->GetPreviousRealTime();
+	_simulationAccumulator += std::clamp(currentTime - _worldTime->GetRealTime(), 0.0, MaxSimulationTimePerTick);
 
+	_worldTime->SetPreviousRealTime(_worldTime->GetRealTime());
 	_worldTime->SetRealTime(currentTime);
 
-	if (flFrameTime > 1.0)
+	// The simulation always advances in steps of the same size regardless of how often the timer fires,
+	// so entity think functions and animation events behave the same at any frame rate.
+	const double simulationStep = GetSimulationStep();
+
+	if (_simulationAccumulator >= simulationStep)
+	{
+		auto asset = _assets->GetCurrent();
+
+		do
+		{
+			_simulationAccumulator -= simulationStep;
+			_worldTime->AdvanceTime(static_cast<float>(simulationStep));
+
+			if (asset)
+			{
+				asset->GetProvider()->Tick();
+			}
+		}
+		while (_simulationAccumulator >= simulationStep);
+	}
+
+	UpdateInterpolationFactor();
+
+	// Only draw frames when something has changed so no time is spent drawing identical frames.
+	auto scene = _sceneWidget ? _sceneWidget->GetScene() : nullptr;
+
+	if (scene && scene->NeedsRedraw())
+	{
+		_sceneWidget->update();
+
+		if (_isTimerIdle)
+		{
+			StartTimer();
+		}
+		else
+		{
+			_idleTickCount = 0;
+		}
+	}
+	else if (!_isTimerIdle && ++_idleTickCount >= _applicationSettings->GetTickRate())
 	{
-		flFrameTime = 0.1;
+		// Nothing has changed for a second, stop ticking until something does.
+		_isTimerIdle = true;
+		_timer->stop();
 	}
+}
+
+double AssetManager::GetSimulationStep() const
+{
+	return 1.0 / _applicationSettings->GetTickRate();
+}
 
-#if false
-	if (flFrameTime < (1.0 / /*max_fps.GetFloat()*/60.0f))
+void AssetManager::UpdateInterpolationFactor()
+{
+	// Time that has passed since the last tick hasn't been simulated yet either.
+	const double unsimulatedTime = _simulationAccumulator + (GetCurrentRealTime() - _worldTime->GetRealTime());
+
+	_worldTime->SetInterpolationFactor(static_cast<float>(std::clamp(unsimulatedTime / GetSimulationStep(), 0.0, 1.0)));
+}
+
+void AssetManager::OnSceneWidgetFrameSwapped()
+{
+	// Keep drawing at the display's refresh rate while animating so interpolation results in smooth motion.
+	// Nothing changes while the timer is paused.
+	if (_timerPauseCount > 0)
 	{
 		return;
 	}
-#endif
 
-	_worldTime->TimeChanged(currentTime);
+	if (auto scene = _sceneWidget ? _sceneWidget->GetScene() : nullptr; scene && scene->IsAnimating())
+	{
+		_sceneWidget->update();
+	}
+}
 
-	if (auto asset = _assets->GetCurrent(); asset)
+bool AssetManager::eventFilter(QObject* watched, QEvent* event)
+{
+	switch (event->type())
+	{
+	case QEvent::Type::MouseMove:
 	{
-		asset->GetProvider()->Tick();
+		// Moving the mouse without dragging doesn't change anything.
+		if (static_cast<QMouseEvent*>(event)->buttons() == Qt::MouseButton::NoButton)
+		{
+			break;
+		}
+
+		[[fallthrough]];
 	}
+
+	case QEvent::Type::MouseButtonPress:
+	case QEvent::Type::MouseButtonRelease:
+	case QEvent::Type::MouseButtonDblClick:
+	case QEvent::Type::Wheel:
+	case QEvent::Type::KeyPress:
+	case QEvent::Type::KeyRelease:
+	{
+		// Input on the scene widget moves the camera, so redraw right away.
+		// Input elsewhere may change the scene through the UI, which is detected once the timer is running again.
+		if (watched == _sceneWidget)
+		{
+			RequestRedraw();
+		}
+		else
+		{
+			WakeTimer();
+		}
+
+		break;
+	}
+
+	default: break;
+	}
+
+	return QObject::eventFilter(watched, event);
 }
 
 void AssetManager::OnTickRateChanged(int value)
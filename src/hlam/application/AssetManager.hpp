@@ -36,6 +36,7 @@ class WorldTime;
 namespace graphics
 {
 class IGraphicsContext;
+class OpenGLStateCache;
 class TextureLoader;
 }
 
@@ -84,6 +85,8 @@ public:
 
 	QOpenGLFunctions_1_1* GetOpenGLFunctions() { return _openglFunctions.get(); }
 
+	graphics::OpenGLStateCache* GetOpenGLStateCache() { return _openglStateCache.get(); }
+
 	graphics::TextureLoader* GetTextureLoader() { return _textureLoader.get(); }
 
 	bool AddPlugin(std::unique_ptr<IAssetManagerPlugin> plugin);
@@ -107,6 +110,19 @@ public:
 
 	void RecreateSceneWidget();
 
+	/**
+	*	@brief Marks the current scene as needing to be redrawn.
+	*	Call this after changing anything that affects how the scene looks that isn't detected automatically.
+	*	Input on the scene widget always triggers a redraw.
+	*/
+	void RequestRedraw();
+
+	/**
+	*	@brief Restarts the timer if it stopped because nothing was changing.
+	*	Scenes call this when they change so the change is drawn.
+	*/
+	void WakeTimer();
+
 	bool IsInFullscreenMode();
 
 	void StartTimer();
@@ -144,6 +160,11 @@ public:
 	void InitializeFileSystem(IFileSystem& fileSystem, const QString& fileName);
 
 private:
+	/**
+	*	@brief Time in seconds simulated by each simulation step.
+	*/
+	double GetSimulationStep() const;
+
 	template<typename TFunction, typename... Args>
 	void CallPlugins(TFunction&& function, Args&&... args)
 	{
@@ -153,6 +174,9 @@ private:
 		}
 	}
 
+protected:
+	bool eventFilter(QObject* watched, QEvent* event) override;
+
 signals:
 	void SettingsChanged();
 
@@ -169,6 +193,13 @@ private slots:
 
 	void OnTimerTick();
 
+	/**
+	*	@brief Updates the interpolation factor to match the current real time.
+	*/
+	void UpdateInterpolationFactor();
+
+	void OnSceneWidgetFrameSwapped();
+
 	void OnTickRateChanged(int value);
 
 	void OnStylePathChanged(const QString& stylePath);
@@ -187,6 +218,7 @@ private:
 	const std::unique_ptr<graphics::IGraphicsContext> _graphicsContext;
 	QOpenGLDebugLogger* _openGLLogger{};
 	const std::unique_ptr<QOpenGLFunctions_1_1> _openglFunctions;
+	const std::unique_ptr<graphics::OpenGLStateCache> _openglStateCache;
 	const std::unique_ptr<graphics::TextureLoader> _textureLoader;
 
 	// Plugin destructors should be called after the asset and options page destructors,
@@ -200,6 +232,13 @@ private:
 
 	int _timerPauseCount{0};
 
+	// Number of ticks in a row that didn't need to draw a frame.
+	int _idleTickCount{0};
+	bool _isTimerIdle{false};
+
+	// Real time that has passed but hasn't been simulated yet.
+	double _simulationAccumulator{0};
+
 	const std::unique_ptr<ISoundSystem> _soundSystem;
 	const std::unique_ptr<WorldTime> _worldTime;
 
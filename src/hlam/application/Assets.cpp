@@ -48,10 +48,10 @@ void AssetProviderRegistry::Shutdown()
 	}
 }
 
-std::variant<std::unique_ptr<Asset>, AssetLoadInExternalProgram> AssetProviderRegistry::Load(
-	const QString& fileName) const
+AssetFinalizer AssetProviderRegistry::LoadInBackground(const QString& fileName,
+	std::unique_ptr<IFileSystem>&& fileSystem, AssetLoadProgress& progress) const
 {
-	std::unique_ptr<FILE, decltype(::fclose)*> file{utf8_exclusive_read_fopen(fileName.toStdString().c_str(), true), &::fclose};
+	const FilePtr file{utf8_exclusive_read_fopen(fileName.toStdString().c_str(), true)};
 
 	if (!file)
 	{
@@ -63,7 +63,24 @@ std::variant<std::unique_ptr<Asset>, AssetLoadInExternalProgram> AssetProviderRe
 		if (provider->CanLoad(fileName, file.get()))
 		{
 			rewind(file.get());
-			return provider->Load(fileName, file.get());
+
+			if (auto finalizer = provider->LoadInBackground(fileName, file.get(), std::move(fileSystem), progress); finalizer)
+			{
+				return finalizer;
+			}
+
+			// The file is opened again on the main thread so it isn't held open while waiting.
+			return [provider = provider.get(), fileName]() -> AssetLoadData
+			{
+				const FilePtr file{utf8_exclusive_read_fopen(fileName.toStdString().c_str(), true)};
+
+				if (!file)
+				{
+					throw AssetException("Could not open asset: file does not exist or is currently opened by another program");
+				}
+
+				return provider->Load(fileName, file.get());
+			};
 		}
 
 		rewind(file.get());
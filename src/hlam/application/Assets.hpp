@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdio>
+#include <functional>
 #include <memory>
 #include <string>
 #include <variant>
@@ -12,15 +13,25 @@
 #include <QUndoStack>
 #include <QWidget>
 
+#include "application/AssetIO.hpp"
+
 class AssetProvider;
 class AssetManager;
+class ColorSettings;
+class IFileSystem;
 class QMenu;
 
+namespace graphics
+{
+class SceneContext;
+}
+
 enum class ProviderFeature
 {
 	None = 0,
 	AssetLoading = 1 << 0,
-	AssetSaving = 1 << 1
+	AssetSaving = 1 << 1,
+	Thumbnails = 1 << 2
 };
 
 Q_DECLARE_FLAGS(ProviderFeatures, ProviderFeature)
@@ -86,6 +97,11 @@ struct AssetLoadInExternalProgram
 
 using AssetLoadData = std::variant<std::unique_ptr<Asset>, AssetLoadInExternalProgram>;
 
+/**
+*	@brief Finishes loading an asset on the main thread after the rest of the work was done on a worker thread.
+*/
+using AssetFinalizer = std::function<AssetLoadData()>;
+
 /**
 *	@brief Provides a means of loading and saving assets
 */
@@ -136,14 +152,42 @@ public:
 	//TODO: pass a filesystem object to resolve additional file locations with
 	virtual AssetLoadData Load(const QString& fileName, FILE* file) = 0;
 
+	/**
+	*	@brief Does the part of loading that doesn't need the main thread, like reading and converting the file.
+	*	This is called on a worker thread, so it must not touch the UI, OpenGL or state shared with the main thread.
+	*	@param fileSystem File system initialized for the asset on the main thread
+	*	@return Function that finishes loading on the main thread,
+	*		or an empty function if the provider can only load assets on the main thread using Load
+	*/
+	virtual AssetFinalizer LoadInBackground(const QString& fileName, FILE* file,
+		std::unique_ptr<IFileSystem>&& fileSystem, AssetLoadProgress& progress)
+	{
+		return {};
+	}
+
 	/**
 	*	@brief Returns whether the given file is a candidate for loading when a file list is presented to the user.
+	*	This is called from worker threads by the file browser so it must be thread-safe.
 	*/
 	virtual bool IsCandidateForLoading(const QString& fileName, FILE* file) const
 	{
 		return CanLoad(fileName, file);
 	}
 
+	/**
+	*	@brief Draws a thumbnail of the given file. Only called if the provider has the Thumbnails feature.
+	*	This is called on a background thread with a context current that only the caller uses,
+	*	so it must not touch shared state or the application's graphics resources.
+	*	The viewport, projection and modelview are left to the provider.
+	*	@param colorSettings Copy of the application's colors owned by the caller
+	*	@return Whether anything was drawn
+	*/
+	virtual bool DrawThumbnail(const QString& fileName, FILE* file, graphics::SceneContext& sc,
+		ColorSettings& colorSettings) const
+	{
+		return false;
+	}
+
 protected:
 	AssetManager* const _application;
 };
@@ -166,7 +210,12 @@ public:
 	void Initialize();
 	void Shutdown();
 
-	std::variant<std::unique_ptr<Asset>, AssetLoadInExternalProgram> Load(const QString& fileName) const;
+	/**
+	*	@brief Loads as much of the given asset as possible on the calling worker thread.
+	*	@return Function to call on the main thread to finish loading the asset
+	*/
+	AssetFinalizer LoadInBackground(const QString& fileName,
+		std::unique_ptr<IFileSystem>&& fileSystem, AssetLoadProgress& progress) const;
 
 private:
 	std::vector<std::unique_ptr<AssetProvider>> _providers;
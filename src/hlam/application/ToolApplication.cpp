@@ -31,6 +31,8 @@
 #include "ui/AboutDialog.hpp"
 #include "ui/OpenGLGraphicsContext.hpp"
 
+#include "utility/Profiling.hpp"
+
 const QString LogBaseFileName{QStringLiteral("HLAM-Log.txt")};
 
 QString LogDirectory;
@@ -129,6 +131,11 @@ int ToolApplication::Run(int argc, char* argv[])
 
 		const auto commandLine = ParseCommandLine(QCoreApplication::arguments());
 
+		if (!commandLine.TraceFileName.isEmpty())
+		{
+			profiling::StartRecording();
+		}
+
 		auto settings = CreateSettings(argv[0], programName, commandLine.IsPortable);
 
 		_singleInstance = std::make_unique<SingleInstance>();
@@ -165,7 +172,18 @@ int ToolApplication::Run(int argc, char* argv[])
 			_application->LoadFile(commandLine.FileName);
 		}
 
-		return app.exec();
+		const int exitCode = app.exec();
+
+		// Only save the trace if it wasn't already saved using the menu.
+		if (!commandLine.TraceFileName.isEmpty() && profiling::IsRecording())
+		{
+			if (!profiling::StopRecording(commandLine.TraceFileName.toStdString().c_str()))
+			{
+				qCWarning(HLAM) << "Error saving profiling trace to" << commandLine.TraceFileName;
+			}
+		}
+
+		return exitCode;
 	}
 	catch (const std::exception& e)
 	{
@@ -189,6 +207,12 @@ ParsedCommandLine ToolApplication::ParseCommandLine(const QStringList& arguments
 	QCommandLineParser parser;
 
 	parser.addOption(QCommandLineOption{"portable", "Launch in portable mode"});
+
+	if (profiling::IsAvailable())
+	{
+		parser.addOption(QCommandLineOption{"trace",
+			"Record a profiling trace from startup and save it to <fileName> on exit", "fileName"});
+	}
 	parser.addPositionalArgument("fileName", "Filename of the model to load on startup", "[fileName]");
 
 	parser.process(arguments);
@@ -197,6 +221,11 @@ ParsedCommandLine ToolApplication::ParseCommandLine(const QStringList& arguments
 
 	result.IsPortable = parser.isSet("portable");
 
+	if (profiling::IsAvailable())
+	{
+		result.TraceFileName = parser.value("trace");
+	}
+
 	const auto positionalArguments = parser.positionalArguments();
 
 	if (!positionalArguments.empty())
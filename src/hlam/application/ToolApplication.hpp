@@ -21,6 +21,7 @@ struct ParsedCommandLine
 {
 	bool IsPortable{false};
 	QString FileName;
+	QString TraceFileName;
 };
 
 /**
@@ -2,14 +2,15 @@
 
 #include "entity/AxesEntity.hpp"
 
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/SceneContext.hpp"
 
 void AxesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 {
-	if (ShowAxes)
+	if (_showAxes)
 	{
-		sc.OpenGLFunctions->glDisable(GL_TEXTURE_2D);
-		sc.OpenGLFunctions->glDisable(GL_DEPTH_TEST);
+		sc.StateCache->Disable(GL_TEXTURE_2D);
+		sc.StateCache->Disable(GL_DEPTH_TEST);
 
 		const float flLength = 50.0f;
 
@@ -33,5 +34,6 @@ void AxesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 		sc.OpenGLFunctions->glVertex3f(0, 0, flLength);
 
 		sc.OpenGLFunctions->glEnd();
+		sc.StateCache->CountDrawCall(6);
 	}
 }
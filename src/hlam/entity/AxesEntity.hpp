@@ -15,5 +15,14 @@ public:
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) override;
 
-	bool ShowAxes = false;
+	bool ShouldShowAxes() const { return _showAxes; }
+
+	void SetShowAxes(bool value)
+	{
+		_showAxes = value;
+		MarkChanged();
+	}
+
+private:
+	bool _showAxes = false;
 };
@@ -3,16 +3,17 @@
 #include "entity/BackgroundEntity.hpp"
 
 #include "graphics/GraphicsUtils.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/SceneContext.hpp"
 
 void BackgroundEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 {
-	if (ShowBackground)
+	if (_showBackground)
 	{
 		// Update image if changed.
 		if (!_image.GetData().empty())
 		{
-			sc.OpenGLFunctions->glBindTexture(GL_TEXTURE_2D, _texture);
+			sc.StateCache->BindTexture(_texture);
 
 			sc.OpenGLFunctions->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
 				_image.GetWidth(), _image.GetHeight(), 0, GL_RGBA, GL_UNSIGNED_BYTE, _image.GetData().data());
@@ -22,7 +23,7 @@ void BackgroundEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 			_image = {};
 		}
 
-		graphics::DrawBackground(sc.OpenGLFunctions, _texture);
+		graphics::DrawBackground(sc.OpenGLFunctions, sc.StateCache, _texture);
 	}
 }
 
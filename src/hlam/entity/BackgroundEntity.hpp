@@ -29,11 +29,20 @@ public:
 	{
 		_imageName = std::move(imageName);
 		_image = std::move(image);
+		MarkChanged();
 	}
 
-	bool ShowBackground = false;
+	bool ShouldShowBackground() const { return _showBackground; }
+
+	void SetShowBackground(bool value)
+	{
+		_showBackground = value;
+		MarkChanged();
+	}
 
 private:
+	bool _showBackground = false;
+
 	GLuint _texture{0};
 	std::string _imageName;
 	graphics::Image _image;
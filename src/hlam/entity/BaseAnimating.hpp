@@ -24,5 +24,6 @@ public:
 	void SetFrameRate(const float frameRate)
 	{
 		_frameRate = std::max(0.f, frameRate);
+		MarkChanged();
 	}
 };
@@ -2,6 +2,7 @@
 #include <cassert>
 
 #include "entity/BaseEntity.hpp"
+#include "entity/EntityList.hpp"
 
 void BaseEntity::SetEntityContext(EntityContext* context)
 {
@@ -17,7 +18,16 @@ void BaseEntity::SetEntityList(EntityList* entityList)
 	_entityList = entityList;
 }
 
+void BaseEntity::MarkChanged()
+{
+	if (_entityList)
+	{
+		_entityList->MarkChanged();
+	}
+}
+
 void BaseEntity::SetTransparency(const float transparency)
 {
 	_transparency = std::clamp(transparency, 0.f, 1.f);
+	MarkChanged();
 }
@@ -99,6 +99,17 @@ public:
 
 	virtual float GetRenderDistance(const glm::vec3& cameraOrigin) const { return 1000000000.0f; }
 
+	/**
+	*	@brief Whether this entity changes every frame, in which case the scene is redrawn continuously.
+	*/
+	virtual bool IsAnimating() const { return false; }
+
+	/**
+	*	@brief Marks the entity as changed so the scene it's in is redrawn.
+	*	Call this after changing anything that affects how the entity is drawn.
+	*/
+	void MarkChanged();
+
 private:
 	EntityContext* _context{};
 	EntityList* _entityList{};
@@ -124,20 +135,27 @@ public:
 
 	const glm::vec3& GetOrigin() const { return _origin; }
 
-	void SetOrigin(const glm::vec3& origin) { _origin = origin; }
+	void SetOrigin(const glm::vec3& origin)
+	{
+		_origin = origin;
+		MarkChanged();
+	}
 
 	const glm::vec3& GetAngles() const { return _angles; }
 
-	void SetAngles(const glm::vec3& angles) { _angles = angles; }
+	void SetAngles(const glm::vec3& angles)
+	{
+		_angles = angles;
+		MarkChanged();
+	}
 
 	const glm::vec3& GetScale() const { return _scale; }
 
-	/**
-	*	@brief The returned vector can be modified and affects the scale.
-	*/
-	glm::vec3& GetScale() { return _scale; }
-
-	void SetScale(const glm::vec3& scale) { _scale = scale; }
+	void SetScale(const glm::vec3& scale)
+	{
+		_scale = scale;
+		MarkChanged();
+	}
 
 	float GetTransparency() const { return _transparency; }
 
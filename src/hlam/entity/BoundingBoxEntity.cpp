@@ -8,7 +8,7 @@
 
 void BoundingBoxEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 {
-	if (ShowBBox)
+	if (_showBBox)
 	{
 		if (auto entity = GetContext()->Asset->GetEntity(); entity)
 		{
@@ -17,7 +17,7 @@ void BoundingBoxEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass
 
 			const auto v = graphics::CreateBoxFromBounds(model->BoundingMin, model->BoundingMax);
 
-			graphics::DrawOutlinedBox(sc.OpenGLFunctions, v, {1.0f, 1.0f, 0.0f, 0.5f}, {0.5f, 0.5f, 0.0f, 1.0f});
+			graphics::DrawOutlinedBox(sc.OpenGLFunctions, sc.StateCache, v, {1.0f, 1.0f, 0.0f, 0.5f}, {0.5f, 0.5f, 0.0f, 1.0f});
 		}
 	}
 }
@@ -15,5 +15,14 @@ public:
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) override;
 
-	bool ShowBBox = false;
+	bool ShouldShowBBox() const { return _showBBox; }
+
+	void SetShowBBox(bool value)
+	{
+		_showBBox = value;
+		MarkChanged();
+	}
+
+private:
+	bool _showBBox = false;
 };
@@ -8,7 +8,7 @@
 
 void ClippingBoxEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 {
-	if (ShowCBox)
+	if (_showCBox)
 	{
 		if (auto entity = GetContext()->Asset->GetEntity(); entity)
 		{
@@ -17,7 +17,7 @@ void ClippingBoxEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass
 
 			const auto v = graphics::CreateBoxFromBounds(model->ClippingMin, model->ClippingMax);
 
-			graphics::DrawOutlinedBox(sc.OpenGLFunctions, v, {1.0f, 0.5f, 0.0f, 0.5f}, {0.5f, 0.25f, 0.0f, 1.0f});
+			graphics::DrawOutlinedBox(sc.OpenGLFunctions, sc.StateCache, v, {1.0f, 0.5f, 0.0f, 0.5f}, {0.5f, 0.25f, 0.0f, 1.0f});
 		}
 	}
 }
@@ -15,5 +15,14 @@ public:
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) override;
 
-	bool ShowCBox = false;
+	bool ShouldShowCBox() const { return _showCBox; }
+
+	void SetShowCBox(bool value)
+	{
+		_showCBox = value;
+		MarkChanged();
+	}
+
+private:
+	bool _showCBox = false;
 };
@@ -7,6 +7,7 @@
 #include "entity/HLMVStudioModelEntity.hpp"
 
 #include "graphics/GraphicsUtils.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/SceneContext.hpp"
 
 #include "settings/ColorSettings.hpp"
@@ -17,16 +18,16 @@
 
 void CrosshairEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 {
-	if (ShowCrosshair)
+	if (_showCrosshair)
 	{
 		const int centerX = sc.WindowWidth / 2;
 		const int centerY = sc.WindowHeight / 2;
 
-		sc.OpenGLFunctions->glDisable(GL_CULL_FACE);
+		sc.StateCache->Disable(GL_CULL_FACE);
 
-		sc.OpenGLFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		sc.StateCache->PolygonMode(GL_FILL);
 
-		sc.OpenGLFunctions->glDisable(GL_TEXTURE_2D);
+		sc.StateCache->Disable(GL_TEXTURE_2D);
 
 		auto colors = GetContext()->Asset->GetApplication()->GetColorSettings();
 
@@ -40,6 +41,7 @@ void CrosshairEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 		sc.OpenGLFunctions->glVertex2f(centerX - CROSSHAIR_LINE_WIDTH / 2, centerY + 1);
 
 		sc.OpenGLFunctions->glEnd();
+		sc.StateCache->CountDrawCall(1);
 
 		sc.OpenGLFunctions->glBegin(GL_LINES);
 
@@ -56,6 +58,7 @@ void CrosshairEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 		sc.OpenGLFunctions->glVertex2f(centerX, centerY + CROSSHAIR_LINE_END);
 
 		sc.OpenGLFunctions->glEnd();
+		sc.StateCache->CountDrawCall(8);
 
 		sc.OpenGLFunctions->glPointSize(1);
 		sc.OpenGLFunctions->glLineWidth(1);
@@ -20,5 +20,14 @@ public:
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) override;
 
-	bool ShowCrosshair = false;
+	bool ShouldShowCrosshair() const { return _showCrosshair; }
+
+	void SetShowCrosshair(bool value)
+	{
+		_showCrosshair = value;
+		MarkChanged();
+	}
+
+private:
+	bool _showCrosshair = false;
 };
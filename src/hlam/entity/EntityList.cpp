@@ -5,6 +5,9 @@
 
 #include "utility/WorldTime.hpp"
 
+#include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
+#include "application/AssetManager.hpp"
+
 std::shared_ptr<BaseEntity> EntityList::GetEntityByIndex(std::size_t index) const
 {
 	if (index >= _entities.size())
@@ -38,6 +41,7 @@ void EntityList::RunFrame()
 void EntityList::Add(const std::shared_ptr<BaseEntity>& entity)
 {
 	_entities.push_back(entity);
+	MarkChanged();
 }
 
 void EntityList::Destroy(const std::shared_ptr<BaseEntity>& entity)
@@ -58,9 +62,17 @@ void EntityList::Destroy(const std::shared_ptr<BaseEntity>& entity)
 
 	// Entity will still exist until last strong reference has been cleared.
 	_entities.erase(it);
+	MarkChanged();
 }
 
 void EntityList::DestroyAll()
 {
 	_entities.clear();
+	MarkChanged();
+}
+
+void EntityList::MarkChanged()
+{
+	_changed = true;
+	_context->Asset->GetApplication()->WakeTimer();
 }
@@ -69,6 +69,15 @@ public:
 
 	void DestroyAll();
 
+	/**
+	*	@brief Whether any entity has changed in a way that affects how it's drawn since the last call to @ref ClearChanged.
+	*/
+	bool HasChanged() const { return _changed; }
+
+	void MarkChanged();
+
+	void ClearChanged() { _changed = false; }
+
 private:
 	void Add(const std::shared_ptr<BaseEntity>& entity);
 
@@ -76,4 +85,6 @@ private:
 	EntityContext* const _context;
 
 	std::vector<std::shared_ptr<BaseEntity>> _entities;
+
+	bool _changed = true;
 };
@@ -6,6 +6,7 @@
 #include "entity/HLMVStudioModelEntity.hpp"
 
 #include "graphics/GraphicsUtils.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/SceneContext.hpp"
 
 #include "settings/ColorSettings.hpp"
@@ -21,12 +22,12 @@ void GroundEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 	auto asset = context->Asset;
 	auto settings = context->StudioSettings;
 
-	if (ShowGround)
+	if (_showGround)
 	{
 		// Update image if changed.
 		if (!_image.GetData().empty())
 		{
-			sc.OpenGLFunctions->glBindTexture(GL_TEXTURE_2D, _texture);
+			sc.StateCache->BindTexture(_texture);
 
 			sc.OpenGLFunctions->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
 				_image.GetWidth(), _image.GetHeight(), 0, GL_RGBA, GL_UNSIGNED_BYTE, _image.GetData().data());
@@ -38,16 +39,16 @@ void GroundEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 
 		// HACK: draw the mirrored model now.
 		// setup stencil buffer and draw mirror
-		if (MirrorOnGround)
+		if (_mirrorOnGround)
 		{
-			graphics::DrawMirroredModel(sc.OpenGLFunctions,
+			graphics::DrawMirroredModel(sc.OpenGLFunctions, sc.StateCache,
 				*GetContext()->StudioModelRenderer,
 				asset->GetEntity(),
-				asset->CurrentRenderMode,
-				asset->ShowWireframeOverlay,
+				asset->GetCurrentRenderMode(),
+				asset->ShouldShowWireframeOverlay(),
 				asset->GetGroundEntity()->GetOrigin(),
 				settings->GetGroundLength(),
-				asset->EnableBackfaceCulling);
+				asset->ShouldEnableBackfaceCulling());
 		}
 
 		glm::vec2 textureOffset{0};
@@ -64,7 +65,7 @@ void GroundEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 				const auto& sequence = *model->Sequences[entity->GetSequence()];
 
 				//Scale offset to current frame
-				const float currentFrame = entity->GetFrame() / (sequence.NumFrames - 1);
+				const float currentFrame = entity->GetInterpolatedFrame() / (sequence.NumFrames - 1);
 
 				float delta;
 
@@ -97,7 +98,7 @@ void GroundEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 
 		_groundTextureOffset += textureOffset;
 
-		const float groundTextureLength = EnableGroundTextureTiling ? GroundTextureLength : settings->GetGroundLength();
+		const float groundTextureLength = _enableGroundTextureTiling ? _groundTextureLength : settings->GetGroundLength();
 
 		//Prevent the offset from overflowing
 		_groundTextureOffset.x = std::fmod(_groundTextureOffset.x, groundTextureLength);
@@ -107,14 +108,14 @@ void GroundEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 
 		std::optional<GLuint> texture;
 
-		if (EnableTexture)
+		if (_enableTexture)
 		{
 			texture = _hasTexture ? _texture : GetContext()->Asset->GetProvider()->GetDefaultGroundTexture();
 		}
 
-		graphics::DrawGround(sc.OpenGLFunctions,
+		graphics::DrawGround(sc.OpenGLFunctions, sc.StateCache,
 			GetOrigin(), settings->GetGroundLength(), groundTextureLength, _groundTextureOffset, texture,
-			colors->GetColor(studiomodel::GroundColor), MirrorOnGround);
+			colors->GetColor(studiomodel::GroundColor), _mirrorOnGround);
 	}
 }
 
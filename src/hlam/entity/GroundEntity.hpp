@@ -35,20 +35,62 @@ public:
 		_imageName = std::move(imageName);
 		_image = std::move(image);
 		_hasTexture = true;
+		MarkChanged();
 	}
 
 	void ClearImage()
 	{
 		_hasTexture = false;
+		MarkChanged();
 	}
 
-	bool ShowGround = false;
-	bool MirrorOnGround = false;
-	bool EnableTexture = false;
-	bool EnableGroundTextureTiling{false};
-	int GroundTextureLength{16};
+	bool ShouldShowGround() const { return _showGround; }
+
+	void SetShowGround(bool value)
+	{
+		_showGround = value;
+		MarkChanged();
+	}
+
+	bool ShouldMirrorOnGround() const { return _mirrorOnGround; }
+
+	void SetMirrorOnGround(bool value)
+	{
+		_mirrorOnGround = value;
+		MarkChanged();
+	}
+
+	bool ShouldEnableTexture() const { return _enableTexture; }
+
+	void SetEnableTexture(bool value)
+	{
+		_enableTexture = value;
+		MarkChanged();
+	}
+
+	bool ShouldEnableGroundTextureTiling() const { return _enableGroundTextureTiling; }
+
+	void SetEnableGroundTextureTiling(bool value)
+	{
+		_enableGroundTextureTiling = value;
+		MarkChanged();
+	}
+
+	int GetGroundTextureLength() const { return _groundTextureLength; }
+
+	void SetGroundTextureLength(int value)
+	{
+		_groundTextureLength = value;
+		MarkChanged();
+	}
 
 private:
+	bool _showGround = false;
+	bool _mirrorOnGround = false;
+	bool _enableTexture = false;
+	bool _enableGroundTextureTiling{false};
+	int _groundTextureLength{16};
+
 	int _groundSequence{-1};
 	float _previousGroundFrame{0};
 
@@ -1,4 +1,5 @@
 #include <array>
+#include <cstddef>
 
 #include <QOpenGLFunctions_1_1>
 
@@ -10,6 +11,7 @@
 #include "entity/GuidelinesEntity.hpp"
 
 #include "graphics/GraphicsUtils.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/SceneContext.hpp"
 
 #include "utility/mathlib.hpp"
@@ -27,16 +29,16 @@ void GuidelinesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 	const float adjustedWidth = sc.WindowHeight * (aspectRatio.x / aspectRatio.y);
 	const float adjustedHeight = sc.WindowWidth * (aspectRatio.y / aspectRatio.x);
 
-	if (ShowGuidelines)
+	if (_showGuidelines)
 	{
 		const int centerX = sc.WindowWidth / 2;
 		const int centerY = sc.WindowHeight / 2;
 
-		sc.OpenGLFunctions->glDisable(GL_CULL_FACE);
+		sc.StateCache->Disable(GL_CULL_FACE);
 
-		sc.OpenGLFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		sc.StateCache->PolygonMode(GL_FILL);
 
-		sc.OpenGLFunctions->glDisable(GL_TEXTURE_2D);
+		sc.StateCache->Disable(GL_TEXTURE_2D);
 
 		auto colors = GetContext()->Asset->GetApplication()->GetColorSettings();
 
@@ -45,6 +47,8 @@ void GuidelinesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 		sc.OpenGLFunctions->glPointSize(GUIDELINES_LINE_WIDTH);
 		sc.OpenGLFunctions->glLineWidth(GUIDELINES_LINE_WIDTH);
 
+		std::size_t pointCount = 0;
+
 		sc.OpenGLFunctions->glBegin(GL_POINTS);
 
 		for (int yPos = sc.WindowHeight - GUIDELINES_LINE_LENGTH;
@@ -52,9 +56,13 @@ void GuidelinesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 			yPos -= GUIDELINES_OFFSET)
 		{
 			sc.OpenGLFunctions->glVertex2f(centerX - GUIDELINES_LINE_WIDTH, yPos);
+			++pointCount;
 		}
 
 		sc.OpenGLFunctions->glEnd();
+		sc.StateCache->CountDrawCall(pointCount);
+
+		std::size_t lineVertexCount = 0;
 
 		sc.OpenGLFunctions->glBegin(GL_LINES);
 
@@ -64,9 +72,11 @@ void GuidelinesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 		{
 			sc.OpenGLFunctions->glVertex2f(centerX, yPos);
 			sc.OpenGLFunctions->glVertex2f(centerX, yPos - GUIDELINES_LINE_LENGTH);
+			lineVertexCount += 2;
 		}
 
 		sc.OpenGLFunctions->glEnd();
+		sc.StateCache->CountDrawCall(lineVertexCount);
 
 		sc.OpenGLFunctions->glLineWidth(GUIDELINES_EDGE_WIDTH);
 
@@ -90,14 +100,15 @@ void GuidelinesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 		}
 
 		sc.OpenGLFunctions->glEnd();
+		sc.StateCache->CountDrawCall(4);
 
 		sc.OpenGLFunctions->glPointSize(1);
 		sc.OpenGLFunctions->glLineWidth(1);
 	}
 
-	if (!ShowOffscreenAreas)
+	if (!_showOffscreenAreas)
 	{
-		sc.OpenGLFunctions->glDisable(GL_DEPTH_TEST);
+		sc.StateCache->Disable(GL_DEPTH_TEST);
 		sc.OpenGLFunctions->glColor4f(0, 0, 0, 1);
 
 		Rect rectangles[2]{};
@@ -132,6 +143,7 @@ void GuidelinesEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 			sc.OpenGLFunctions->glVertex2f(rect.Left, rect.Bottom);
 			sc.OpenGLFunctions->glVertex2f(rect.Left, rect.Top);
 			sc.OpenGLFunctions->glEnd();
+			sc.StateCache->CountDrawCall(6);
 		}
 	}
 }
@@ -22,6 +22,23 @@ public:
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) override;
 
-	bool ShowGuidelines = false;
-	bool ShowOffscreenAreas = true;
+	bool ShouldShowGuidelines() const { return _showGuidelines; }
+
+	void SetShowGuidelines(bool value)
+	{
+		_showGuidelines = value;
+		MarkChanged();
+	}
+
+	bool ShouldShowOffscreenAreas() const { return _showOffscreenAreas; }
+
+	void SetShowOffscreenAreas(bool value)
+	{
+		_showOffscreenAreas = value;
+		MarkChanged();
+	}
+
+private:
+	bool _showGuidelines = false;
+	bool _showOffscreenAreas = true;
 };
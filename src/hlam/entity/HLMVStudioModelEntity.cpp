@@ -60,12 +60,23 @@ void HLMVStudioModelEntity::HandleAnimEvent(const AnimEvent& event)
 	*/
 }
 
+bool HLMVStudioModelEntity::IsAnimating() const
+{
+	return GetContext()->Asset->ShouldPlaySequence() && GetFrameRate() > 0 && GetNumFrames() > 1
+		&& !HasFinishedSequence();
+}
+
 void HLMVStudioModelEntity::AnimThink()
 {
-	if (GetContext()->Asset->PlaySequence)
+	if (GetContext()->Asset->ShouldPlaySequence())
 	{
 		const float flTime = AdvanceFrame(0.0f, 0.1f);
 
 		DispatchAnimEvents();
 	}
+	else
+	{
+		// Paused animations shouldn't keep moving between the last two frames.
+		ResetFrameInterpolation();
+	}
 }
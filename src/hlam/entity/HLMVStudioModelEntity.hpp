@@ -14,5 +14,7 @@ public:
 
 	virtual void HandleAnimEvent(const AnimEvent& event) override;
 
+	bool IsAnimating() const override;
+
 	void AnimThink();
 };
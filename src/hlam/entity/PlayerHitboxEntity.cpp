@@ -5,7 +5,7 @@
 
 void PlayerHitboxEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 {
-	if (ShowPlayerHitbox)
+	if (_showPlayerHitbox)
 	{
 		//Draw a transparent green box to display the player hitbox
 		const glm::vec3 bbmin{-16, -16, 0};
@@ -13,6 +13,6 @@ void PlayerHitboxEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPas
 
 		auto v = graphics::CreateBoxFromBounds(bbmin, bbmax);
 
-		graphics::DrawOutlinedBox(sc.OpenGLFunctions, v, {0.0f, 1.0f, 0.0f, 0.5f}, {0.0f, 0.5f, 0.0f, 1.f});
+		graphics::DrawOutlinedBox(sc.OpenGLFunctions, sc.StateCache, v, {0.0f, 1.0f, 0.0f, 0.5f}, {0.0f, 0.5f, 0.0f, 1.f});
 	}
 }
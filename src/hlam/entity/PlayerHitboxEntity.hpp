@@ -15,5 +15,14 @@ public:
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) override;
 
-	bool ShowPlayerHitbox = false;
+	bool ShouldShowPlayerHitbox() const { return _showPlayerHitbox; }
+
+	void SetShowPlayerHitbox(bool value)
+	{
+		_showPlayerHitbox = value;
+		MarkChanged();
+	}
+
+private:
+	bool _showPlayerHitbox = false;
 };
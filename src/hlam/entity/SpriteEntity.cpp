@@ -37,6 +37,11 @@ void SpriteEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 	GetContext()->SpriteRenderer->DrawSprite(info, renderer::DrawFlag::NONE);
 }
 
+bool SpriteEntity::IsAnimating() const
+{
+	return _sprite && _sprite->numframes > 1;
+}
+
 void SpriteEntity::AnimThink()
 {
 	_frame += GetContext()->Time->GetFrameTime() * 10;
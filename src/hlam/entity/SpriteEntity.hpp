@@ -20,6 +20,8 @@ public:
 
 	virtual void Draw(graphics::SceneContext& sc, RenderPasses renderPass) override;
 
+	bool IsAnimating() const override;
+
 	void AnimThink();
 
 	sprite::msprite_t* GetSprite() const { return _sprite; }
@@ -8,6 +8,7 @@
 #include "entity/StudioModelEntity.hpp"
 
 #include "graphics/GraphicsUtils.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/SceneContext.hpp"
 
 #include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
@@ -44,30 +45,30 @@ void StudioModelEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass
 
 	/*
 	// setup stencil buffer and draw mirror
-	if (asset->GetGroundEntity()->MirrorOnGround)
+	if (asset->GetGroundEntity()->ShouldMirrorOnGround())
 	{
-		graphics::DrawMirroredModel(sc.OpenGLFunctions,
+		graphics::DrawMirroredModel(sc.OpenGLFunctions, sc.StateCache,
 			*GetContext()->StudioModelRenderer, this,
-			asset->CurrentRenderMode,
-			asset->ShowWireframeOverlay,
+			asset->GetCurrentRenderMode(),
+			asset->ShouldShowWireframeOverlay(),
 			asset->GetGroundEntity()->GetOrigin(),
 			settings->GetGroundLength(),
-			asset->EnableBackfaceCulling);
+			asset->ShouldEnableBackfaceCulling());
 	}
 	*/
 
-	graphics::SetupRenderMode(sc.OpenGLFunctions, asset->CurrentRenderMode, asset->EnableBackfaceCulling);
+	graphics::SetupRenderMode(sc.StateCache, asset->GetCurrentRenderMode(), asset->ShouldEnableBackfaceCulling());
 
 	const glm::vec3& vecScale = GetScale();
 
 	//Determine if an odd number of scale values are negative. The cull face has to be changed if so.
 	const float flScale = vecScale.x * vecScale.y * vecScale.z;
 
-	sc.OpenGLFunctions->glCullFace(flScale > 0 ? GL_FRONT : GL_BACK);
+	sc.StateCache->CullFace(flScale > 0 ? GL_FRONT : GL_BACK);
 
 	renderer::DrawFlags flags = renderer::DrawFlag::NONE;
 
-	if (asset->ShowWireframeOverlay)
+	if (asset->ShouldShowWireframeOverlay())
 	{
 		flags |= renderer::DrawFlag::WIREFRAME_OVERLAY;
 	}
@@ -77,38 +78,38 @@ void StudioModelEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass
 		flags |= renderer::DrawFlag::IS_VIEW_MODEL;
 	}
 
-	if (asset->DrawShadows)
+	if (asset->ShouldDrawShadows())
 	{
 		flags |= renderer::DrawFlag::DRAW_SHADOWS;
 	}
 
-	if (asset->FixShadowZFighting)
+	if (asset->ShouldFixShadowZFighting())
 	{
 		flags |= renderer::DrawFlag::FIX_SHADOW_Z_FIGHTING;
 	}
 
 	//TODO: these should probably be made separate somehow
-	if (asset->ShowHitboxes)
+	if (asset->ShouldShowHitboxes())
 	{
 		flags |= renderer::DrawFlag::DRAW_HITBOXES;
 	}
 
-	if (asset->ShowBones)
+	if (asset->ShouldShowBones())
 	{
 		flags |= renderer::DrawFlag::DRAW_BONES;
 	}
 
-	if (asset->ShowAttachments)
+	if (asset->ShouldShowAttachments())
 	{
 		flags |= renderer::DrawFlag::DRAW_ATTACHMENTS;
 	}
 
-	if (asset->ShowEyePosition)
+	if (asset->ShouldShowEyePosition())
 	{
 		flags |= renderer::DrawFlag::DRAW_EYE_POSITION;
 	}
 
-	if (asset->ShowNormals)
+	if (asset->ShouldShowNormals())
 	{
 		flags |= renderer::DrawFlag::DRAW_NORMALS;
 	}
@@ -124,19 +125,19 @@ void StudioModelEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass
 		renderInfo.Origin.z -= 1;
 	}
 
-	if (asset->DrawSingleBoneIndex != -1)
+	if (asset->GetDrawSingleBoneIndex() != -1)
 	{
-		GetContext()->StudioModelRenderer->DrawSingleBone(renderInfo, asset->DrawSingleBoneIndex);
+		GetContext()->StudioModelRenderer->DrawSingleBone(renderInfo, asset->GetDrawSingleBoneIndex());
 	}
 
-	if (asset->DrawSingleAttachmentIndex != -1)
+	if (asset->GetDrawSingleAttachmentIndex() != -1)
 	{
-		GetContext()->StudioModelRenderer->DrawSingleAttachment(renderInfo, asset->DrawSingleAttachmentIndex);
+		GetContext()->StudioModelRenderer->DrawSingleAttachment(renderInfo, asset->GetDrawSingleAttachmentIndex());
 	}
 
-	if (asset->DrawSingleHitboxIndex != -1)
+	if (asset->GetDrawSingleHitboxIndex() != -1)
 	{
-		GetContext()->StudioModelRenderer->DrawSingleHitbox(renderInfo, asset->DrawSingleHitboxIndex);
+		GetContext()->StudioModelRenderer->DrawSingleHitbox(renderInfo, asset->GetDrawSingleHitboxIndex());
 	}
 }
 
@@ -178,7 +179,7 @@ studiomdl::ModelRenderInfo StudioModelEntity::GetRenderInfo() const
 
 	renderInfo.Transparency = GetTransparency();
 	renderInfo.Sequence = GetSequence();
-	renderInfo.Frame = GetFrame();
+	renderInfo.Frame = GetInterpolatedFrame();
 	renderInfo.Bodygroup = GetBodygroup();
 	renderInfo.Skin = GetSkin();
 
@@ -213,6 +214,8 @@ float StudioModelEntity::AdvanceFrame(float deltaTime, const float maximum)
 
 	const auto& sequenceDescriptor = *_editableModel->Sequences[_sequence];
 
+	_previousFrame = _frame;
+
 	if (deltaTime == 0)
 	{
 		deltaTime = (GetContext()->Time->GetTime() - _animTime);
@@ -235,21 +238,7 @@ float StudioModelEntity::AdvanceFrame(float deltaTime, const float maximum)
 
 	const float oldFrame = _frame;
 
-	bool shouldLoop;
-
-	switch (_loopingMode)
-	{
-	default:
-	case StudioLoopingMode::AlwaysLoop:
-		shouldLoop = true;
-		break;
-	case StudioLoopingMode::NeverLoop:
-		shouldLoop = false;
-		break;
-	case StudioLoopingMode::UseSequenceSetting:
-		shouldLoop = (sequenceDescriptor.Flags & STUDIO_LOOPING) != 0;
-		break;
-	}
+	const bool shouldLoop = ShouldLoop();
 
 	const float increment = deltaTime * sequenceDescriptor.FPS * _frameRate;
 
@@ -396,12 +385,76 @@ void StudioModelEntity::SetFrame(float frame)
 		_frame -= (int)(_frame / (sequenceDescriptor.NumFrames - 1)) * (sequenceDescriptor.NumFrames - 1);
 	}
 
+	ResetFrameInterpolation();
 	_animTime = GetContext()->Time->GetTime();
+	MarkChanged();
+}
+
+float StudioModelEntity::GetInterpolatedFrame() const
+{
+	if (!_editableModel || _sequence < 0 || _sequence >= _editableModel->Sequences.size())
+	{
+		return _frame;
+	}
+
+	const int numFrames = _editableModel->Sequences[_sequence]->NumFrames;
+
+	if (numFrames <= 1)
+	{
+		return _frame;
+	}
+
+	// Looping sequences wrap around to the first frame.
+	const bool wrapped = _previousFrame > _frame;
+
+	const float frame = wrapped ? _frame + (numFrames - 1) : _frame;
+
+	float interpolatedFrame = _previousFrame + ((frame - _previousFrame) * GetContext()->Time->GetInterpolationFactor());
+
+	if (wrapped && interpolatedFrame >= numFrames - 1)
+	{
+		interpolatedFrame -= numFrames - 1;
+	}
+
+	return interpolatedFrame;
 }
 
 void StudioModelEntity::SetEditableModel(studiomdl::EditableStudioModel* model)
 {
 	_editableModel = model;
+	MarkChanged();
+}
+
+bool StudioModelEntity::ShouldLoop() const
+{
+	switch (_loopingMode)
+	{
+	default:
+	case StudioLoopingMode::AlwaysLoop: return true;
+	case StudioLoopingMode::NeverLoop: return false;
+	case StudioLoopingMode::UseSequenceSetting:
+	{
+		if (!_editableModel || _sequence < 0 || _sequence >= _editableModel->Sequences.size())
+		{
+			return false;
+		}
+
+		return (_editableModel->Sequences[_sequence]->Flags & STUDIO_LOOPING) != 0;
+	}
+	}
+}
+
+bool StudioModelEntity::HasFinishedSequence() const
+{
+	if (ShouldLoop())
+	{
+		return false;
+	}
+
+	const int numFrames = GetNumFrames();
+
+	// The frame stays on the last frame once it gets there, interpolation catches up on the next advance.
+	return numFrames > 1 && _frame >= (numFrames - 1) && _previousFrame == _frame;
 }
 
 int StudioModelEntity::GetNumFrames() const
@@ -433,7 +486,9 @@ void StudioModelEntity::SetSequence(int sequence)
 
 	_sequence = sequence;
 	_frame = 0;
+	ResetFrameInterpolation();
 	_lastEventCheck = 0;
+	MarkChanged();
 }
 
 void StudioModelEntity::GetSequenceInfo(float& frameRate, float& groundSpeed) const
@@ -484,6 +539,7 @@ void StudioModelEntity::SetBodygroup(const int bodygroup, const int value)
 	}
 
 	_editableModel->CalculateBodygroup(bodygroup, value, _bodygroup);
+	MarkChanged();
 }
 
 void StudioModelEntity::SetSkin(const int skin)
@@ -496,6 +552,7 @@ void StudioModelEntity::SetSkin(const int skin)
 	if (skin >= 0 && skin < _editableModel->SkinFamilies.size())
 	{
 		_skin = skin;
+		MarkChanged();
 	}
 }
 
@@ -589,6 +646,7 @@ void StudioModelEntity::SetController(const int controller, float value)
 	setting = std::clamp(setting, 0, 255);
 
 	_controller[controller] = setting;
+	MarkChanged();
 }
 
 void StudioModelEntity::SetMouth(std::uint8_t value)
@@ -599,6 +657,7 @@ void StudioModelEntity::SetMouth(std::uint8_t value)
 	}
 
 	_mouth = value;
+	MarkChanged();
 }
 
 std::uint8_t StudioModelEntity::GetBlendingByIndex(const int blender) const
@@ -720,6 +779,7 @@ void StudioModelEntity::SetBlending(const int blender, float value)
 	{
 		_blending[blender] = setting.value();
 		_blendingValues[blender] = value;
+		MarkChanged();
 	}
 }
 
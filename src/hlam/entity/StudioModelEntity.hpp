@@ -82,6 +82,16 @@ public:
 public:
 	void SetFrame(float frame);
 
+	/**
+	*	Gets the frame to draw, interpolated between the frame before and after the last simulation step.
+	*/
+	float GetInterpolatedFrame() const;
+
+	/**
+	*	Makes the frame to draw match the current frame until the next time the frame advances.
+	*/
+	void ResetFrameInterpolation() { _previousFrame = _frame; }
+
 private:
 	studiomdl::EditableStudioModel* _editableModel = nullptr;
 
@@ -96,6 +106,7 @@ private:
 
 	float _lastEventCheck = 0;				//Last time we checked for animation events.
 	float _animTime = 0;				//Time when the frame was set.
+	float _previousFrame = 0;				//Frame before the last time the frame advanced.
 
 	StudioLoopingMode _loopingMode = StudioLoopingMode::AlwaysLoop;
 
@@ -167,6 +178,7 @@ public:
 	{
 		//TODO: verify that this is a correct value
 		_bodygroup = value;
+		MarkChanged();
 	}
 
 	int GetSkin() const { return _skin; }
@@ -216,6 +228,8 @@ public:
 			assert(!"Invalid blend mode");
 			break;
 		}
+
+		MarkChanged();
 	}
 
 	/**
@@ -253,8 +267,19 @@ public:
 	void SetLoopingMode(StudioLoopingMode value)
 	{
 		_loopingMode = value;
+		MarkChanged();
 	}
 
+	/**
+	*	@brief Whether the current sequence starts over after its last frame.
+	*/
+	bool ShouldLoop() const;
+
+	/**
+	*	@brief Whether the current sequence doesn't loop and has stopped on its last frame.
+	*/
+	bool HasFinishedSequence() const;
+
 	/**
 	*	Extracts the bounding box from the current sequence.
 	*/
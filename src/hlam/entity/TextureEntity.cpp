@@ -1,10 +1,14 @@
+#include <vector>
+
 #include <QOpenGLFunctions_1_1>
 
+#include <glm/vec2.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "entity/HLMVStudioModelEntity.hpp"
 #include "entity/TextureEntity.hpp"
 
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/SceneContext.hpp"
 
 #include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
@@ -27,40 +31,41 @@ void TextureEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 
 	const auto& texture = *model->Textures[_textureIndex];
 
-	const float w = texture.Data.Width * TextureScale;
-	const float h = texture.Data.Height * TextureScale;
+	const float w = texture.Data.Width * _textureScale;
+	const float h = texture.Data.Height * _textureScale;
 
 	sc.OpenGLFunctions->glMatrixMode(GL_MODELVIEW);
 	sc.OpenGLFunctions->glPushMatrix();
 	sc.OpenGLFunctions->glLoadIdentity();
 
-	sc.OpenGLFunctions->glDisable(GL_CULL_FACE);
-	sc.OpenGLFunctions->glDisable(GL_BLEND);
+	sc.StateCache->Disable(GL_CULL_FACE);
+	sc.StateCache->Disable(GL_BLEND);
 
-	sc.OpenGLFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-	const float x = ((static_cast<float>(sc.WindowWidth) - w) / 2) + XOffset;
-	const float y = ((static_cast<float>(sc.WindowHeight) - h) / 2) + YOffset;
+	sc.StateCache->PolygonMode(GL_FILL);
+	const float x = ((static_cast<float>(sc.WindowWidth) - w) / 2) + _xOffset;
+	const float y = ((static_cast<float>(sc.WindowHeight) - h) / 2) + _yOffset;
 
-	sc.OpenGLFunctions->glDisable(GL_DEPTH_TEST);
+	sc.StateCache->Disable(GL_DEPTH_TEST);
 
-	if (ShowUVMap && !OverlayUVMap)
+	if (_showUVMap && !_overlayUVMap)
 	{
 		sc.OpenGLFunctions->glColor4f(0.0f, 0.0f, 0.0f, 1.0f);
-		sc.OpenGLFunctions->glDisable(GL_TEXTURE_2D);
+		sc.StateCache->Disable(GL_TEXTURE_2D);
 		sc.OpenGLFunctions->glRectf(x, y, x + w, y + h);
+		sc.StateCache->CountDrawCall(4);
 	}
 
-	if (!ShowUVMap || OverlayUVMap)
+	if (!_showUVMap || _overlayUVMap)
 	{
 		if (texture.Flags & STUDIO_NF_MASKED)
 		{
-			sc.OpenGLFunctions->glEnable(GL_ALPHA_TEST);
-			sc.OpenGLFunctions->glAlphaFunc(GL_GREATER, 0.5f);
+			sc.StateCache->Enable(GL_ALPHA_TEST);
+			sc.StateCache->AlphaFunc(GL_GREATER, 0.5f);
 		}
 
-		sc.OpenGLFunctions->glEnable(GL_TEXTURE_2D);
+		sc.StateCache->Enable(GL_TEXTURE_2D);
 		sc.OpenGLFunctions->glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-		sc.OpenGLFunctions->glBindTexture(GL_TEXTURE_2D, texture.TextureId);
+		sc.StateCache->BindTexture(texture.TextureId);
 
 		sc.OpenGLFunctions->glBegin(GL_TRIANGLE_STRIP);
 
@@ -77,63 +82,65 @@ void TextureEntity::Draw(graphics::SceneContext& sc, RenderPasses renderPass)
 		sc.OpenGLFunctions->glVertex2f(x + w, y + h);
 
 		sc.OpenGLFunctions->glEnd();
+		sc.StateCache->CountDrawCall(4);
 
-		sc.OpenGLFunctions->glBindTexture(GL_TEXTURE_2D, 0);
+		sc.StateCache->BindTexture(0);
 
 		if (texture.Flags & STUDIO_NF_MASKED)
 		{
-			sc.OpenGLFunctions->glDisable(GL_ALPHA_TEST);
+			sc.StateCache->Disable(GL_ALPHA_TEST);
 		}
 	}
 
-	if (ShowUVMap)
+	if (_showUVMap)
 	{
-		sc.OpenGLFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		sc.OpenGLFunctions->glDisable(GL_TEXTURE_2D);
+		sc.StateCache->PolygonMode(GL_LINE);
+		sc.StateCache->Disable(GL_TEXTURE_2D);
 
 		sc.OpenGLFunctions->glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 
-		if (AntiAliasLines)
+		if (_antiAliasLines)
 		{
-			sc.OpenGLFunctions->glEnable(GL_BLEND);
-			sc.OpenGLFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			sc.OpenGLFunctions->glEnable(GL_LINE_SMOOTH);
+			sc.StateCache->Enable(GL_BLEND);
+			sc.StateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			sc.StateCache->Enable(GL_LINE_SMOOTH);
 		}
 		else
 		{
-			sc.OpenGLFunctions->glDisable(GL_BLEND);
+			sc.StateCache->Disable(GL_BLEND);
 		}
 
-		int i;
+		sc.StateCache->EnableClientState(GL_VERTEX_ARRAY);
+
+		std::vector<glm::vec2> coordinates;
 
 		for (const auto mesh : _meshes)
 		{
-			auto triCommands = mesh->Triangles.data();
+			if (mesh->CookedIndices.empty())
+			{
+				continue;
+			}
 
-			while (i = *(triCommands++))
+			coordinates.clear();
+			coordinates.reserve(mesh->CookedVertices.size());
+
+			for (const auto& vertex : mesh->CookedVertices)
 			{
-				if (i < 0)
-				{
-					sc.OpenGLFunctions->glBegin(GL_TRIANGLE_FAN);
-					i = -i;
-				}
-				else
-				{
-					sc.OpenGLFunctions->glBegin(GL_TRIANGLE_STRIP);
-				}
-
-				for (; i > 0; i--, triCommands += 4)
-				{
-					// FIX: put these in as integer coords, not floats
-					sc.OpenGLFunctions->glVertex2f(x + triCommands[2] * TextureScale, y + triCommands[3] * TextureScale);
-				}
-				sc.OpenGLFunctions->glEnd();
+				// FIX: put these in as integer coords, not floats
+				coordinates.emplace_back(x + vertex.S * _textureScale, y + vertex.T * _textureScale);
 			}
+
+			sc.OpenGLFunctions->glVertexPointer(2, GL_FLOAT, sizeof(glm::vec2), coordinates.data());
+			sc.OpenGLFunctions->glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(mesh->CookedIndices.size()),
+				GL_UNSIGNED_INT, mesh->CookedIndices.data());
+			sc.StateCache->CountDrawCall(mesh->CookedIndices.size());
 		}
 
-		if (AntiAliasLines)
+		sc.StateCache->DisableClientState(GL_VERTEX_ARRAY);
+
+		if (_antiAliasLines)
 		{
-			sc.OpenGLFunctions->glDisable(GL_LINE_SMOOTH);
+			sc.StateCache->Disable(GL_LINE_SMOOTH);
 		}
 	}
 
@@ -158,6 +165,8 @@ void TextureEntity::SetTextureIndex(int textureIndex, int meshIndex)
 
 void TextureEntity::SetMeshIndex(int meshIndex)
 {
+	MarkChanged();
+
 	if (_textureIndex == -1)
 	{
 		_meshes.clear();
@@ -27,16 +27,59 @@ public:
 
 	void SetMeshIndex(int meshIndex);
 
-	float TextureScale = 1;
+	float GetTextureScale() const { return _textureScale; }
 
-	int XOffset = 0;
-	int YOffset = 0;
+	void SetTextureScale(float value)
+	{
+		_textureScale = value;
+		MarkChanged();
+	}
 
-	bool ShowUVMap = false;
-	bool OverlayUVMap = false;
-	bool AntiAliasLines = false;
+	int GetXOffset() const { return _xOffset; }
+
+	int GetYOffset() const { return _yOffset; }
+
+	void SetOffset(int x, int y)
+	{
+		_xOffset = x;
+		_yOffset = y;
+		MarkChanged();
+	}
+
+	bool ShouldShowUVMap() const { return _showUVMap; }
+
+	void SetShowUVMap(bool value)
+	{
+		_showUVMap = value;
+		MarkChanged();
+	}
+
+	bool ShouldOverlayUVMap() const { return _overlayUVMap; }
+
+	void SetOverlayUVMap(bool value)
+	{
+		_overlayUVMap = value;
+		MarkChanged();
+	}
+
+	bool ShouldAntiAliasLines() const { return _antiAliasLines; }
+
+	void SetAntiAliasLines(bool value)
+	{
+		_antiAliasLines = value;
+		MarkChanged();
+	}
 
 private:
+	float _textureScale = 1;
+
+	int _xOffset = 0;
+	int _yOffset = 0;
+
+	bool _showUVMap = false;
+	bool _overlayUVMap = false;
+	bool _antiAliasLines = false;
+
 	int _textureIndex = -1;
 	std::vector<const studiomdl::StudioMesh*> _meshes;
 };
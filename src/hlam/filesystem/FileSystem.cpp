@@ -1,14 +1,23 @@
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
 #include <iterator>
+#include <system_error>
 
 #include <fmt/format.h>
 
 #include "filesystem/FileSystem.hpp"
+#include "filesystem/PakFile.hpp"
 
 #include "utility/IOUtils.hpp"
-#include "utility/Platform.hpp"
+#include "utility/StringUtils.hpp"
+
+namespace
+{
+// Coarsest directory timestamp resolution in common use (FAT, exFAT and many SMB shares).
+constexpr std::chrono::seconds DirectoryTimestampGranularity{2};
+}
 
 bool FileSystem::HasSearchPath(std::string_view path) const
 {
@@ -44,6 +53,11 @@ void FileSystem::RemoveSearchPath(std::string_view path)
 
 	if (const auto it = std::find(_searchPaths.begin(), _searchPaths.end(), path); it != _searchPaths.end())
 	{
+		{
+			const std::lock_guard lock{_cacheMutex};
+			_archives.erase(*it);
+		}
+
 		_searchPaths.erase(it);
 	}
 }
@@ -51,6 +65,9 @@ void FileSystem::RemoveSearchPath(std::string_view path)
 void FileSystem::RemoveAllSearchPaths()
 {
 	_searchPaths.clear();
+
+	const std::lock_guard lock{_cacheMutex};
+	_archives.clear();
 }
 
 std::string FileSystem::GetAbsolutePath(std::string_view fileName)
@@ -67,9 +84,9 @@ std::string FileSystem::GetAbsolutePath(std::string_view fileName)
 		candidate.clear();
 		fmt::format_to(std::back_inserter(candidate), "{}/{}", path, fileName);
 
-		if (TryFindFileName(candidate, candidate))
+		if (auto realFileName = FindFileName(candidate); !realFileName.empty())
 		{
-			return candidate;
+			return realFileName;
 		}
 	}
 
@@ -121,8 +138,12 @@ FilePtr FileSystem::TryOpenAbsolute(const std::string& fileName, bool binary, bo
 	}
 
 	// Try to find the file using case insensitive search.
-	std::string realFileName;
-	return TryFindFileName(fileName, realFileName);
+	if (const auto realFileName = FindFileName(fileName); !realFileName.empty() && realFileName != fileName)
+	{
+		return TryOpenFile(realFileName, binary, exclusive);
+	}
+
+	return {};
 }
 
 FilePtr FileSystem::TryOpen(std::string_view fileName, bool binary, bool exclusive) const
@@ -145,44 +166,173 @@ FilePtr FileSystem::TryOpen(std::string_view fileName, bool binary, bool exclusi
 	return {};
 }
 
-FilePtr FileSystem::TryFindFileName(const std::string& fileName, std::string& realFileName) const
+std::optional<FileView> FileSystem::TryMap(std::string_view fileName) const
 {
-	const std::filesystem::path absoluteFileName = std::filesystem::u8path(fileName);
-	const std::filesystem::path absoluteDirectory = absoluteFileName.parent_path();
-	const std::string baseFileName = reinterpret_cast<const char*>(absoluteFileName.filename().u8string().c_str());
+	if (fileName.empty())
+	{
+		return {};
+	}
+
+	std::string candidate;
 
-	try
+	for (const auto& path : _searchPaths)
 	{
-		for (const auto& candidate : std::filesystem::directory_iterator(absoluteDirectory))
 		{
-			if (!candidate.is_regular_file() && !candidate.is_symlink())
+			const std::lock_guard lock{_cacheMutex};
+
+			for (const auto& archive : GetArchives(path))
 			{
-				continue;
+				if (const auto data = archive->Find(fileName); data)
+				{
+					return FileView{*data, archive};
+				}
 			}
+		}
 
-			const std::filesystem::path& candidatePath = candidate.path();
-			const std::string candidateName = reinterpret_cast<const char*>(candidatePath.filename().u8string().c_str());
+		candidate.clear();
+		fmt::format_to(std::back_inserter(candidate), "{}/{}", path, fileName);
 
-			if (0 == strcasecmp(baseFileName.c_str(), candidateName.c_str()))
-			{
-				std::string candidateFileName = reinterpret_cast<const char*>(candidatePath.u8string().c_str());
+		FilePtr file = TryOpenAbsolute(candidate, true);
 
-				auto file = TryOpenFile(candidateFileName, true, false);
+		if (!file)
+		{
+			continue;
+		}
 
-				if (file)
+		if (const auto [data, size] = MapFileIntoMemory(file.get()); data)
+		{
+			std::shared_ptr<const std::byte> storage{data, [size](const std::byte* data)
 				{
-					realFileName = std::move(candidateFileName);
-					return file;
-				}
-			}
+					UnmapFileFromMemory(data, size);
+				}};
+
+			return FileView{{data, size}, std::move(storage)};
+		}
+
+		// Empty files can't be mapped.
+		auto [buffer, size] = ReadFileIntoBuffer(file.get());
+
+		if (!buffer)
+		{
+			return FileView{};
+		}
+
+		std::shared_ptr<const std::byte[]> storage{std::move(buffer)};
+
+		return FileView{{storage.get(), size}, std::move(storage)};
+	}
+
+	return {};
+}
+
+std::string FileSystem::FindFileName(const std::string& fileName) const
+{
+	const std::filesystem::path absoluteFileName = std::filesystem::u8path(fileName);
+	const std::string baseFileName = reinterpret_cast<const char*>(absoluteFileName.filename().u8string().c_str());
+
+	const auto index = GetDirectoryIndex(absoluteFileName.parent_path());
+
+	if (const auto it = index->FileNames.find(UTIL_ToLower(baseFileName)); it != index->FileNames.end())
+	{
+		return reinterpret_cast<const char*>((absoluteFileName.parent_path() / std::filesystem::u8path(it->second)).u8string().c_str());
+	}
+
+	return {};
+}
+
+std::shared_ptr<const FileSystem::DirectoryIndex> FileSystem::GetDirectoryIndex(
+	const std::filesystem::path& directory) const
+{
+	std::error_code ec;
+	auto lastWriteTime = std::filesystem::last_write_time(directory, ec);
+
+	if (ec)
+	{
+		lastWriteTime = std::filesystem::file_time_type::min();
+	}
+
+	std::string key = reinterpret_cast<const char*>(directory.u8string().c_str());
+
+	{
+		const std::lock_guard lock{_cacheMutex};
+
+		// Adding, removing or renaming files changes the directory's modification time.
+		// Timestamps are coarse on some filesystems, so changes made in the same tick as the scan
+		// can only be ruled out once the scan happened a full tick after the last modification.
+		if (const auto it = _directoryIndices.find(key); it != _directoryIndices.end()
+			&& it->second->LastWriteTime == lastWriteTime
+			&& (lastWriteTime == std::filesystem::file_time_type::min()
+				|| (it->second->IndexTime - lastWriteTime) >= DirectoryTimestampGranularity))
+		{
+			return it->second;
 		}
 	}
-	catch (const std::filesystem::filesystem_error&)
+
+	auto index = std::make_shared<DirectoryIndex>();
+
+	index->LastWriteTime = lastWriteTime;
+	index->IndexTime = std::filesystem::file_time_type::clock::now();
+
+	if (!ec)
 	{
-		// Can't do anything about this. Maybe log the error?
+		IndexDirectory(directory, *index);
 	}
 
-	realFileName.clear();
+	// Another thread may have scanned the directory at the same time, in which case either result is fine.
+	const std::lock_guard lock{_cacheMutex};
 
-	return {};
+	_directoryIndices.insert_or_assign(std::move(key), index);
+
+	return index;
+}
+
+void FileSystem::IndexDirectory(const std::filesystem::path& directory, DirectoryIndex& index)
+{
+	std::error_code ec;
+
+	for (std::filesystem::directory_iterator entry{directory, ec}, end; !ec && entry != end; entry.increment(ec))
+	{
+		std::error_code entryError;
+
+		if (!entry->is_regular_file(entryError) && !entry->is_symlink(entryError))
+		{
+			continue;
+		}
+
+		std::string name = reinterpret_cast<const char*>(entry->path().filename().u8string().c_str());
+
+		// If multiple files differ only by case the first one found is used.
+		index.FileNames.try_emplace(UTIL_ToLower(name), std::move(name));
+	}
+}
+
+const std::vector<std::shared_ptr<const PakFile>>& FileSystem::GetArchives(const std::string& searchPath) const
+{
+	auto [it, inserted] = _archives.try_emplace(searchPath);
+
+	if (inserted)
+	{
+		std::string fileName;
+
+		// Archives are numbered consecutively, the engine stops at the first one that is missing.
+		for (int i = 0;; ++i)
+		{
+			fileName.clear();
+			fmt::format_to(std::back_inserter(fileName), "{}/pak{}.pak", searchPath, i);
+
+			auto archive = PakFile::TryOpen(fileName);
+
+			if (!archive)
+			{
+				break;
+			}
+
+			it->second.push_back(std::move(archive));
+		}
+
+		// Higher numbered archives override lower numbered ones.
+		std::reverse(it->second.begin(), it->second.end());
+	}
+
+	return it->second;
 }
@@ -1,15 +1,27 @@
 #pragma once
 
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "filesystem/IFileSystem.hpp"
 
+class PakFile;
+
 /**
 *	@ingroup FileSystem
 *
 *	@{
 */
 
+/**
+*	@brief Filesystem that finds files using case insensitive lookup.
+*	Directories that files are looked up in are indexed the first time they are used
+*	and re-indexed when they are modified, so each lookup is a single hash table probe.
+*/
 class FileSystem final : public IFileSystem
 {
 public:
@@ -35,11 +47,52 @@ public:
 
 	FilePtr TryOpen(std::string_view fileName, bool binary, bool exclusive = false) const override final;
 
+	std::optional<FileView> TryMap(std::string_view fileName) const override final;
+
 private:
-	FilePtr TryFindFileName(const std::string& fileName, std::string& realFileName) const;
+	struct DirectoryIndex
+	{
+		std::filesystem::file_time_type LastWriteTime;
+
+		// When the directory was scanned, used to detect changes that the directory's timestamp can't show.
+		std::filesystem::file_time_type IndexTime;
+
+		// Maps lowercase file names to the names of the files on disk.
+		std::unordered_map<std::string, std::string> FileNames;
+	};
+
+	/**
+	*	@brief Finds the name of a file on disk using case insensitive lookup of the file name.
+	*	@return The absolute name of the file if it exists, an empty string otherwise.
+	*/
+	std::string FindFileName(const std::string& fileName) const;
+
+	/**
+	*	@brief Gets the index for the given directory, indexing it if needed.
+	*	Directories are scanned without holding the cache mutex so lookups in other directories aren't blocked.
+	*/
+	std::shared_ptr<const DirectoryIndex> GetDirectoryIndex(const std::filesystem::path& directory) const;
+
+	static void IndexDirectory(const std::filesystem::path& directory, DirectoryIndex& index);
+
+	/**
+	*	@brief Gets the archives in the given search path in the order they are searched, opening them if needed.
+	*	Must be called with the cache mutex locked.
+	*/
+	const std::vector<std::shared_ptr<const PakFile>>& GetArchives(const std::string& searchPath) const;
 
 private:
 	std::vector<std::string> _searchPaths;
+
+	// Guards the directory index and archive caches.
+	mutable std::mutex _cacheMutex;
+
+	// Keyed by directory name. Directories that don't exist have an empty index so they aren't scanned again.
+	// Indices are replaced instead of modified so they can be used after the mutex is released.
+	mutable std::unordered_map<std::string, std::shared_ptr<const DirectoryIndex>> _directoryIndices;
+
+	// Keyed by search path.
+	mutable std::unordered_map<std::string, std::vector<std::shared_ptr<const PakFile>>> _archives;
 };
 
 /** @} */
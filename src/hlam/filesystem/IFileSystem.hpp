@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -13,8 +17,21 @@
 *	@{
 */
 
+/**
+*	@brief Read-only view of the contents of a file.
+*/
+struct FileView
+{
+	std::span<const std::byte> Data;
+
+	// Keeps the memory that Data refers to alive.
+	std::shared_ptr<const void> Storage;
+};
+
 /**
 *	@brief Represents the SteamPipe filesystem. This can find game resources.
+*	Each search path can contain PAK archives named pak0.pak, pak1.pak, etc. which are searched before loose files,
+*	highest numbered archive first, like the engine does.
 */
 class IFileSystem
 {
@@ -47,7 +64,7 @@ public:
 
 	/**
 	*	@brief Gets an absolute path to a file.
-	*	The file must exist.
+	*	The file must exist. Files stored in archives don't have a path, use @ref TryMap to access those.
 	*	@param fileName File to get a path to.
 	*	@return The path to the file if a path could be formed, an empty string otherwise.
 	*/
@@ -75,6 +92,13 @@ public:
 	*	@param exclusive Whether to open the file using exclusive mode (no other programs have an open write handle to it).
 	*/
 	virtual FilePtr TryOpen(std::string_view fileName, bool binary, bool exclusive = false) const = 0;
+
+	/**
+	*	@brief Tries to map the file with the given filename into memory.
+	*	Unlike the other functions this also finds files stored in archives. The contents of those are not copied.
+	*	@param fileName Relative name of the file to map.
+	*/
+	virtual std::optional<FileView> TryMap(std::string_view fileName) const = 0;
 };
 
 /** @} */
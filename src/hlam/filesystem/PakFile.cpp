@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "filesystem/PakFile.hpp"
+
+#include "utility/IOUtils.hpp"
+#include "utility/StringUtils.hpp"
+
+namespace
+{
+constexpr char PakFileId[4]{'P', 'A', 'C', 'K'};
+
+struct PakHeader
+{
+	char Id[4];
+	std::int32_t DirectoryOffset;
+	std::int32_t DirectoryLength;
+};
+
+struct PakDirectoryEntry
+{
+	char Name[56];
+	std::int32_t FilePosition;
+	std::int32_t FileLength;
+};
+
+static_assert(sizeof(PakHeader) == 12);
+static_assert(sizeof(PakDirectoryEntry) == 64);
+}
+
+std::shared_ptr<const PakFile> PakFile::TryOpen(const std::string& fileName)
+{
+	const FilePtr file{utf8_fopen(fileName.c_str(), "rb")};
+
+	if (!file)
+	{
+		return {};
+	}
+
+	// Archives can be hundreds of megabytes in size and only a few files are used, so don't read ahead.
+	const auto [data, size] = MapFileIntoMemory(file.get(), false);
+
+	if (!data)
+	{
+		return {};
+	}
+
+	std::shared_ptr<PakFile> pakFile{new PakFile(data, size)};
+
+	PakHeader header;
+
+	if (size < sizeof(header))
+	{
+		return {};
+	}
+
+	std::memcpy(&header, data, sizeof(header));
+
+	if (std::memcmp(header.Id, PakFileId, sizeof(PakFileId)) != 0
+		|| header.DirectoryOffset < 0
+		|| header.DirectoryLength < 0
+		|| (header.DirectoryLength % sizeof(PakDirectoryEntry)) != 0
+		|| static_cast<std::size_t>(header.DirectoryOffset) + header.DirectoryLength > size)
+	{
+		return {};
+	}
+
+	const std::size_t entryCount = header.DirectoryLength / sizeof(PakDirectoryEntry);
+
+	pakFile->_files.reserve(entryCount);
+
+	for (std::size_t i = 0; i < entryCount; ++i)
+	{
+		PakDirectoryEntry entry;
+		std::memcpy(&entry, data + header.DirectoryOffset + (i * sizeof(entry)), sizeof(entry));
+
+		// Skip entries that point outside the archive instead of rejecting the entire archive.
+		if (entry.FilePosition < 0 || entry.FileLength < 0
+			|| static_cast<std::size_t>(entry.FilePosition) + entry.FileLength > size)
+		{
+			continue;
+		}
+
+		const std::string_view name{entry.Name, strnlen(entry.Name, sizeof(entry.Name))};
+
+		// The engine uses the first entry if a name occurs more than once.
+		pakFile->_files.try_emplace(NormalizeFileName(name),
+			std::span<const std::byte>{data + entry.FilePosition, static_cast<std::size_t>(entry.FileLength)});
+	}
+
+	return pakFile;
+}
+
+PakFile::PakFile(const std::byte* data, std::size_t size)
+	: _data(data)
+	, _size(size)
+{
+}
+
+PakFile::~PakFile()
+{
+	UnmapFileFromMemory(_data, _size);
+}
+
+std::optional<std::span<const std::byte>> PakFile::Find(std::string_view fileName) const
+{
+	if (const auto it = _files.find(NormalizeFileName(fileName)); it != _files.end())
+	{
+		return it->second;
+	}
+
+	return {};
+}
+
+std::string PakFile::NormalizeFileName(std::string_view fileName)
+{
+	auto normalized = UTIL_ToLower(fileName);
+
+	std::replace(normalized.begin(), normalized.end(), '\\', '/');
+
+	return normalized;
+}
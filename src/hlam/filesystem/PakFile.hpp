@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+*	@ingroup FileSystem
+*
+*	@{
+*/
+
+/**
+*	@brief Read-only PAK archive, as used by Quake and GoldSource games.
+*	The archive is memory mapped and its directory is read once into a case insensitive index,
+*	so looking up a file is a single hash table probe and its contents are never copied.
+*/
+class PakFile final
+{
+public:
+	/**
+	*	@brief Opens the given archive.
+	*	@return The archive, or null if the file doesn't exist or isn't a valid PAK archive.
+	*/
+	static std::shared_ptr<const PakFile> TryOpen(const std::string& fileName);
+
+	~PakFile();
+
+	PakFile(const PakFile&) = delete;
+	PakFile& operator=(const PakFile&) = delete;
+
+	std::size_t GetFileCount() const { return _files.size(); }
+
+	/**
+	*	@brief Finds a file in the archive. Case and the type of slashes used are ignored.
+	*	@return The contents of the file, which remain valid for as long as the archive exists,
+	*		or an empty optional if the archive doesn't contain the file.
+	*/
+	std::optional<std::span<const std::byte>> Find(std::string_view fileName) const;
+
+private:
+	PakFile(const std::byte* data, std::size_t size);
+
+	static std::string NormalizeFileName(std::string_view fileName);
+
+private:
+	const std::byte* const _data;
+	const std::size_t _size;
+
+	// Maps normalized file names to file contents.
+	std::unordered_map<std::string, std::span<const std::byte>> _files;
+};
+
+/** @} */
@@ -2,8 +2,6 @@
 
 #include "formats/DrawConstants.hpp"
 
-class QOpenGLFunctions_1_1;
-
 /**
 *	@defgroup SpriteRenderer Sprite Renderer
 *
@@ -24,8 +22,6 @@ class ISpriteRenderer
 public:
 	virtual ~ISpriteRenderer() {}
 
-	virtual void SetOpenGLFunctions(QOpenGLFunctions_1_1* openglFunctions) = 0;
-
 	virtual void DrawSprite(const SpriteRenderInfo& renderInfo, const renderer::DrawFlags flags) = 0;
 
 	/**
@@ -8,6 +8,7 @@
 #include <glm/vec4.hpp>
 
 #include "graphics/OpenGL.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 
 #include "formats/sprite/SpriteFileFormat.hpp"
 #include "formats/sprite/SpriteRenderer.hpp"
@@ -17,8 +18,11 @@
 
 namespace sprite
 {
-SpriteRenderer::SpriteRenderer(const std::shared_ptr<spdlog::logger>& logger, WorldTime* worldTime)
+SpriteRenderer::SpriteRenderer(const std::shared_ptr<spdlog::logger>& logger,
+	QOpenGLFunctions_1_1* openglFunctions, graphics::OpenGLStateCache* stateCache, WorldTime* worldTime)
 	: _logger(logger)
+	, _openglFunctions(openglFunctions)
+	, _stateCache(stateCache)
 	, _worldTime(worldTime)
 {
 }
@@ -154,9 +158,9 @@ void SpriteRenderer::DrawSprite(const glm::vec3& origin, const glm::vec2& size,
 		frame = pGroup->frames[iIndex];
 	}
 
-	_openglFunctions->glEnable(GL_TEXTURE_2D);
+	_stateCache->Enable(GL_TEXTURE_2D);
 	_openglFunctions->glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	_openglFunctions->glBindTexture(GL_TEXTURE_2D, frame->gl_texturenum);
+	_stateCache->BindTexture(frame->gl_texturenum);
 
 	//TODO: set up the sprite's orientation in the world according to its type.
 	//TODO: the size of the sprite should change based on its distance from the viewer.
@@ -169,45 +173,45 @@ void SpriteRenderer::DrawSprite(const glm::vec3& origin, const glm::vec2& size,
 	case TexFormat::SPR_NORMAL:
 	{
 		_openglFunctions->glTexEnvi(GL_TEXTURE_2D, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-		_openglFunctions->glDisable(GL_BLEND);
+		_stateCache->Disable(GL_BLEND);
 		break;
 	}
 
 	case TexFormat::SPR_ADDITIVE:
 	{
-		_openglFunctions->glEnable(GL_BLEND);
-		_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+		_stateCache->Enable(GL_BLEND);
+		_stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE);
 		break;
 	}
 
 	case TexFormat::SPR_INDEXALPHA:
 	case TexFormat::SPR_ALPHTEST:
 	{
-		_openglFunctions->glEnable(GL_BLEND);
-		_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		_stateCache->Enable(GL_BLEND);
+		_stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		break;
 	}
 	}
 
 	if (texFormat == TexFormat::SPR_ALPHTEST)
 	{
-		_openglFunctions->glEnable(GL_ALPHA_TEST);
-		_openglFunctions->glAlphaFunc(GL_GREATER, 0.0f);
+		_stateCache->Enable(GL_ALPHA_TEST);
+		_stateCache->AlphaFunc(GL_GREATER, 0.0f);
 	}
 	else
 	{
-		_openglFunctions->glDisable(GL_ALPHA_TEST);
+		_stateCache->Disable(GL_ALPHA_TEST);
 	}
 
 	const glm::vec4 vecRect{origin.x - size.x / 2, origin.y - size.y / 2, origin.x + size.x / 2, origin.y + size.y / 2};
 
 	if (!(flags & renderer::DrawFlag::NODRAW))
 	{
-		_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-		_openglFunctions->glEnable(GL_TEXTURE_2D);
-		_openglFunctions->glEnable(GL_CULL_FACE);
-		_openglFunctions->glEnable(GL_DEPTH_TEST);
-		_openglFunctions->glShadeModel(GL_SMOOTH);
+		_stateCache->PolygonMode(GL_FILL);
+		_stateCache->Enable(GL_TEXTURE_2D);
+		_stateCache->Enable(GL_CULL_FACE);
+		_stateCache->Enable(GL_DEPTH_TEST);
+		_stateCache->ShadeModel(GL_SMOOTH);
 		_openglFunctions->glColor4f(1, 1, 1, 1);
 
 		_openglFunctions->glBegin(GL_TRIANGLE_STRIP);
@@ -225,14 +229,15 @@ void SpriteRenderer::DrawSprite(const glm::vec3& origin, const glm::vec2& size,
 		_openglFunctions->glVertex3f(vecRect.z, vecRect.w, origin.z);
 
 		_openglFunctions->glEnd();
+		_stateCache->CountDrawCall(4);
 	}
 
 	if (flags & renderer::DrawFlag::WIREFRAME_OVERLAY)
 	{
-		_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		_openglFunctions->glDisable(GL_TEXTURE_2D);
-		_openglFunctions->glDisable(GL_CULL_FACE);
-		_openglFunctions->glDisable(GL_DEPTH_TEST);
+		_stateCache->PolygonMode(GL_LINE);
+		_stateCache->Disable(GL_TEXTURE_2D);
+		_stateCache->Disable(GL_CULL_FACE);
+		_stateCache->Disable(GL_DEPTH_TEST);
 		_openglFunctions->glColor4f(1, 1, 1, 1);
 
 		_openglFunctions->glBegin(GL_TRIANGLE_STRIP);
@@ -246,6 +251,7 @@ void SpriteRenderer::DrawSprite(const glm::vec3& origin, const glm::vec2& size,
 		_openglFunctions->glVertex3f(vecRect.z, vecRect.w, origin.z);
 
 		_openglFunctions->glEnd();
+		_stateCache->CountDrawCall(4);
 	}
 }
 }
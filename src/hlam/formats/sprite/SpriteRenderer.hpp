@@ -12,8 +12,14 @@
 #include "formats/sprite/ISpriteRenderer.hpp"
 #include "formats/sprite/SpriteFileFormat.hpp"
 
+class QOpenGLFunctions_1_1;
 class WorldTime;
 
+namespace graphics
+{
+class OpenGLStateCache;
+}
+
 namespace sprite
 {
 struct msprite_t;
@@ -24,17 +30,13 @@ private:
 	static constexpr float DEFAULT_FRAMERATE{10};
 
 public:
-	SpriteRenderer(const std::shared_ptr<spdlog::logger>& logger, WorldTime* worldTime);
+	SpriteRenderer(const std::shared_ptr<spdlog::logger>& logger,
+		QOpenGLFunctions_1_1* openglFunctions, graphics::OpenGLStateCache* stateCache, WorldTime* worldTime);
 	~SpriteRenderer();
 
 	SpriteRenderer(const SpriteRenderer&) = delete;
 	SpriteRenderer& operator=(const SpriteRenderer&) = delete;
 
-	void SetOpenGLFunctions(QOpenGLFunctions_1_1* openglFunctions) override
-	{
-		_openglFunctions = openglFunctions;
-	}
-
 	void DrawSprite(const SpriteRenderInfo& renderInfo, const renderer::DrawFlags flags) override;
 
 	void DrawSprite2D(const float x, const float y, const float width, const float height,
@@ -53,7 +55,8 @@ private:
 
 private:
 	std::shared_ptr<spdlog::logger> _logger;
-	QOpenGLFunctions_1_1* _openglFunctions = nullptr;
+	QOpenGLFunctions_1_1* const _openglFunctions;
+	graphics::OpenGLStateCache* const _stateCache;
 	WorldTime* _worldTime;
 };
 }
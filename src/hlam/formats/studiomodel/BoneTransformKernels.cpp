@@ -0,0 +1,304 @@
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include <glm/common.hpp>
+#include <glm/vec4.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "formats/studiomodel/BoneTransformKernels.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HLAM_BONE_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace studiomdl
+{
+namespace
+{
+void AngleToQuaternion(const BoneVectors& angles, BoneQuaternions& quaternions, std::size_t bone)
+{
+	const glm::quat q{glm::vec3{angles[0][bone], angles[1][bone], angles[2][bone]}};
+
+	quaternions[0][bone] = q.x;
+	quaternions[1][bone] = q.y;
+	quaternions[2][bone] = q.z;
+	quaternions[3][bone] = q.w;
+}
+
+/**
+*	@brief Same as glm::slerp, except that identical quaternions are left untouched instead of being mixed.
+*/
+void SlerpQuaternion(float s, const BoneQuaternions& from, BoneQuaternions& to, std::size_t bone)
+{
+	if (to[0][bone] == from[0][bone] && to[1][bone] == from[1][bone]
+		&& to[2][bone] == from[2][bone] && to[3][bone] == from[3][bone])
+	{
+		return;
+	}
+
+	const glm::quat q = glm::slerp(
+		glm::quat{to[3][bone], to[0][bone], to[1][bone], to[2][bone]},
+		glm::quat{from[3][bone], from[0][bone], from[1][bone], from[2][bone]},
+		s);
+
+	to[0][bone] = q.x;
+	to[1][bone] = q.y;
+	to[2][bone] = q.z;
+	to[3][bone] = q.w;
+}
+
+#ifdef HLAM_BONE_KERNELS_SSE2
+__m128 Select(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+/**
+*	@brief Computes the sine and cosine of 4 values at once.
+*	Uses the Cephes range reduction and polynomials, accurate to within a few ulp for the angles used by bones.
+*/
+void SinCos(__m128 x, __m128& sine, __m128& cosine)
+{
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+
+	__m128 signBitSin = _mm_and_ps(x, signMask);
+	x = _mm_andnot_ps(signMask, x);
+
+	// Scale by 4/Pi and round to an even integer to find the octant.
+	__m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+	octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+
+	const __m128 y = _mm_cvtepi32_ps(octant);
+
+	const __m128 swapSignBitSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+	const __m128 polynomialMask = _mm_castsi128_ps(
+		_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+	const __m128 signBitCos = _mm_castsi128_ps(
+		_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+
+	signBitSin = _mm_xor_ps(signBitSin, swapSignBitSin);
+
+	// Extended precision modular arithmetic: x - y * Pi/4
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+	x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+
+	const __m128 z = _mm_mul_ps(x, x);
+
+	// Cosine polynomial for the first octant.
+	__m128 cosPoly = _mm_set1_ps(2.443315711809948e-5f);
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(-1.388731625493765e-3f));
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(4.166664568298827e-2f));
+	cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+	cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.f));
+
+	// Sine polynomial for the first octant.
+	__m128 sinPoly = _mm_set1_ps(-1.9515295891e-4f);
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(8.3321608736e-3f));
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(-1.6666654611e-1f));
+	sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+	// Pick the right polynomial for each octant.
+	const __m128 sinResult = _mm_or_ps(_mm_and_ps(polynomialMask, sinPoly), _mm_andnot_ps(polynomialMask, cosPoly));
+	const __m128 cosResult = _mm_or_ps(_mm_and_ps(polynomialMask, cosPoly), _mm_andnot_ps(polynomialMask, sinPoly));
+
+	sine = _mm_xor_ps(sinResult, signBitSin);
+	cosine = _mm_xor_ps(cosResult, signBitCos);
+}
+
+/**
+*	@brief Computes the arc cosine of 4 values in the range [0, 1] at once.
+*	Uses the Cephes arc sine polynomial, accurate to within a few ulp.
+*/
+__m128 ArcCosPositive(__m128 x)
+{
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	// Above 0.5 use acos(x) = 2 * asin(sqrt((1 - x) / 2)) to keep the polynomial's input small.
+	const __m128 largeMask = _mm_cmpgt_ps(x, half);
+	const __m128 a = Select(largeMask, _mm_sqrt_ps(_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.f), x), half)), x);
+	const __m128 z = _mm_mul_ps(a, a);
+
+	__m128 asinPoly = _mm_set1_ps(4.2163199048e-2f);
+	asinPoly = _mm_add_ps(_mm_mul_ps(asinPoly, z), _mm_set1_ps(2.4181311049e-2f));
+	asinPoly = _mm_add_ps(_mm_mul_ps(asinPoly, z), _mm_set1_ps(4.5470025998e-2f));
+	asinPoly = _mm_add_ps(_mm_mul_ps(asinPoly, z), _mm_set1_ps(7.4953002686e-2f));
+	asinPoly = _mm_add_ps(_mm_mul_ps(asinPoly, z), _mm_set1_ps(1.6666752422e-1f));
+
+	const __m128 asinA = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(asinPoly, z), a), a);
+
+	return Select(largeMask, _mm_add_ps(asinA, asinA), _mm_sub_ps(_mm_set1_ps(1.57079632679489661923f), asinA));
+}
+#endif
+}
+
+void AnglesToQuaternions(std::size_t count, const BoneVectors& angles, BoneQuaternions& quaternions)
+{
+	assert(count <= MAXSTUDIOBONES);
+
+	std::size_t bone = 0;
+
+#ifdef HLAM_BONE_KERNELS_SSE2
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	for (; bone + 4 <= count; bone += 4)
+	{
+		__m128 sx, cx, sy, cy, sz, cz;
+
+		SinCos(_mm_mul_ps(_mm_loadu_ps(&angles[0][bone]), half), sx, cx);
+		SinCos(_mm_mul_ps(_mm_loadu_ps(&angles[1][bone]), half), sy, cy);
+		SinCos(_mm_mul_ps(_mm_loadu_ps(&angles[2][bone]), half), sz, cz);
+
+		const __m128 cycz = _mm_mul_ps(cy, cz);
+		const __m128 sysz = _mm_mul_ps(sy, sz);
+		const __m128 sycz = _mm_mul_ps(sy, cz);
+		const __m128 cysz = _mm_mul_ps(cy, sz);
+
+		// Same formula as glm's euler angle constructor.
+		_mm_storeu_ps(&quaternions[0][bone], _mm_sub_ps(_mm_mul_ps(sx, cycz), _mm_mul_ps(cx, sysz)));
+		_mm_storeu_ps(&quaternions[1][bone], _mm_add_ps(_mm_mul_ps(cx, sycz), _mm_mul_ps(sx, cysz)));
+		_mm_storeu_ps(&quaternions[2][bone], _mm_sub_ps(_mm_mul_ps(cx, cysz), _mm_mul_ps(sx, sycz)));
+		_mm_storeu_ps(&quaternions[3][bone], _mm_add_ps(_mm_mul_ps(cx, cycz), _mm_mul_ps(sx, sysz)));
+	}
+#endif
+
+	for (; bone < count; ++bone)
+	{
+		AngleToQuaternion(angles, quaternions, bone);
+	}
+}
+
+void SlerpQuaternions(std::size_t count, float s, const BoneQuaternions& from, BoneQuaternions& to)
+{
+	assert(count <= MAXSTUDIOBONES);
+
+	std::size_t bone = 0;
+
+#ifdef HLAM_BONE_KERNELS_SSE2
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 fraction = _mm_set1_ps(s);
+	const __m128 inverseFraction = _mm_set1_ps(1.f - s);
+	const __m128 lerpThreshold = _mm_set1_ps(1.f - std::numeric_limits<float>::epsilon());
+
+	for (; bone + 4 <= count; bone += 4)
+	{
+		__m128 x[4], y[4];
+
+		for (std::size_t component = 0; component < 4; ++component)
+		{
+			x[component] = _mm_loadu_ps(&to[component][bone]);
+			y[component] = _mm_loadu_ps(&from[component][bone]);
+		}
+
+		const __m128 unchangedMask = _mm_and_ps(
+			_mm_and_ps(_mm_cmpeq_ps(x[0], y[0]), _mm_cmpeq_ps(x[1], y[1])),
+			_mm_and_ps(_mm_cmpeq_ps(x[2], y[2]), _mm_cmpeq_ps(x[3], y[3])));
+
+		// Summed in the same order as glm's quaternion dot product.
+		__m128 cosTheta = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(x[3], y[3]), _mm_mul_ps(x[0], y[0])),
+			_mm_add_ps(_mm_mul_ps(x[1], y[1]), _mm_mul_ps(x[2], y[2])));
+
+		// Take the short way around the sphere.
+		const __m128 flipSign = _mm_and_ps(_mm_cmplt_ps(cosTheta, zero), signMask);
+
+		cosTheta = _mm_xor_ps(cosTheta, flipSign);
+
+		for (auto& component : y)
+		{
+			component = _mm_xor_ps(component, flipSign);
+		}
+
+		// Nearly identical rotations are mixed linearly to avoid dividing by a sine close to 0.
+		const __m128 lerpMask = _mm_cmpgt_ps(cosTheta, lerpThreshold);
+
+		const __m128 angle = ArcCosPositive(_mm_min_ps(cosTheta, _mm_set1_ps(1.f)));
+
+		__m128 sinAngle, sinX, sinY, unused;
+
+		SinCos(angle, sinAngle, unused);
+		SinCos(_mm_mul_ps(angle, inverseFraction), sinX, unused);
+		SinCos(_mm_mul_ps(angle, fraction), sinY, unused);
+
+		const __m128 inverseSinAngle = _mm_div_ps(_mm_set1_ps(1.f), sinAngle);
+
+		for (std::size_t component = 0; component < 4; ++component)
+		{
+			const __m128 lerp = _mm_add_ps(_mm_mul_ps(x[component], inverseFraction), _mm_mul_ps(y[component], fraction));
+			const __m128 slerp = _mm_mul_ps(
+				_mm_add_ps(_mm_mul_ps(x[component], sinX), _mm_mul_ps(y[component], sinY)), inverseSinAngle);
+
+			_mm_storeu_ps(&to[component][bone], Select(unchangedMask, x[component], Select(lerpMask, lerp, slerp)));
+		}
+	}
+#endif
+
+	for (; bone < count; ++bone)
+	{
+		SlerpQuaternion(s, from, to, bone);
+	}
+}
+
+void LerpVectors(std::size_t count, float s, const BoneVectors& from, BoneVectors& to)
+{
+	assert(count <= MAXSTUDIOBONES);
+
+	const float s1 = 1.0 - s;
+
+	// Simple enough for the compiler to vectorize.
+	for (std::size_t component = 0; component < to.size(); ++component)
+	{
+		auto& dest = to[component];
+		const auto& source = from[component];
+
+		for (std::size_t bone = 0; bone < count; ++bone)
+		{
+			dest[bone] = dest[bone] * s1 + source[bone] * s;
+		}
+	}
+}
+
+void GrowBoundsByTransformedPoints(const glm::mat4x4& transform, std::span<const glm::vec3> points,
+	glm::vec3& mins, glm::vec3& maxs)
+{
+#ifdef HLAM_BONE_KERNELS_SSE2
+	const __m128 column0 = _mm_loadu_ps(&transform[0].x);
+	const __m128 column1 = _mm_loadu_ps(&transform[1].x);
+	const __m128 column2 = _mm_loadu_ps(&transform[2].x);
+	const __m128 column3 = _mm_loadu_ps(&transform[3].x);
+
+	__m128 min = _mm_setr_ps(mins.x, mins.y, mins.z, 0);
+	__m128 max = _mm_setr_ps(maxs.x, maxs.y, maxs.z, 0);
+
+	for (const auto& point : points)
+	{
+		const __m128 result = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(point.x)), _mm_mul_ps(column1, _mm_set1_ps(point.y))),
+			_mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(point.z)), column3));
+
+		min = _mm_min_ps(min, result);
+		max = _mm_max_ps(max, result);
+	}
+
+	alignas(16) float results[2][4];
+
+	_mm_store_ps(results[0], min);
+	_mm_store_ps(results[1], max);
+
+	mins = glm::vec3{results[0][0], results[0][1], results[0][2]};
+	maxs = glm::vec3{results[1][0], results[1][1], results[1][2]};
+#else
+	for (const auto& point : points)
+	{
+		const glm::vec3 result{transform * glm::vec4{point, 1}};
+
+		mins = glm::min(mins, result);
+		maxs = glm::max(maxs, result);
+	}
+#endif
+}
+}
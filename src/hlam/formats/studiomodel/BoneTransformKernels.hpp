@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "formats/studiomodel/StudioModelFileFormat.hpp"
+
+namespace studiomdl
+{
+/**
+*	@brief Per-bone vectors stored as a structure of arrays, indexed as [component][bone].
+*	Lets bones be processed in batches instead of one bone and one axis at a time.
+*/
+using BoneVectors = std::array<std::array<float, MAXSTUDIOBONES>, 3>;
+
+/**
+*	@brief Per-bone quaternions stored as a structure of arrays, indexed as [component][bone].
+*	Components are stored in x, y, z, w order.
+*/
+using BoneQuaternions = std::array<std::array<float, MAXSTUDIOBONES>, 4>;
+
+/**
+*	@brief Converts euler angles to quaternions for the first @p count bones.
+*	Equivalent to constructing a @c glm::quat from each set of angles.
+*	Uses SSE2 to convert 4 bones at a time when available.
+*/
+void AnglesToQuaternions(std::size_t count, const BoneVectors& angles, BoneQuaternions& quaternions);
+
+/**
+*	@brief Spherically interpolates the first @p count quaternions from @p to towards @p from, storing the result in @p to.
+*	Equivalent to @c glm::slerp, except that identical quaternions are left untouched.
+*	Uses SSE2 to interpolate 4 bones at a time when available.
+*/
+void SlerpQuaternions(std::size_t count, float s, const BoneQuaternions& from, BoneQuaternions& to);
+
+/**
+*	@brief Linearly interpolates the first @p count vectors from @p to towards @p from, storing the result in @p to.
+*/
+void LerpVectors(std::size_t count, float s, const BoneVectors& from, BoneVectors& to);
+
+/**
+*	@brief Transforms @p points by @p transform and grows the given bounds to contain the results.
+*	Uses SSE2 to transform a whole point at a time when available.
+*/
+void GrowBoundsByTransformedPoints(const glm::mat4x4& transform, std::span<const glm::vec3> points,
+	glm::vec3& mins, glm::vec3& maxs);
+}
@@ -1,5 +1,11 @@
 #include <algorithm>
 #include <array>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -9,12 +15,15 @@
 #include "formats/studiomodel/EditableStudioModel.hpp"
 
 #include "utility/mathlib.hpp"
+#include "utility/Profiling.hpp"
 
 namespace studiomdl
 {
 const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 	const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo)
 {
+	HLAM_PROFILE_SCOPE("BoneTransformer::SetUpBones");
+
 	int sequenceIndex = transformInfo.SequenceIndex;
 
 	if (sequenceIndex != -1 && (sequenceIndex < -1 || sequenceIndex >= studioModel.Sequences.size()))
@@ -26,6 +35,14 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 
 	const auto& sequence = sequenceIndex  != -1 ? *studioModel.Sequences[sequenceIndex] : emptySequence;
 
+	const auto decodedAnimation = _decodedAnimationCache.Get(sequence, studioModel.Bones.size());
+
+	const auto calculateRotations = [&](std::size_t blend, TransformState& transformState)
+	{
+		CalculateRotations(studioModel, transformInfo, sequence,
+			sequence.AnimationBlends[blend].data(), decodedAnimation, blend, transformState);
+	};
+
 	if (sequence.AnimationBlends.size() == 9)
 	{
 		const auto blendX = static_cast<double>(transformInfo.Blenders[0]);
@@ -42,19 +59,19 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 			{
 				interpolantY = (blendY - 127.0) * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[5].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[7].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[8].data(), _transformStates[3]);
+				calculateRotations(4, _transformStates[0]);
+				calculateRotations(5, _transformStates[1]);
+				calculateRotations(7, _transformStates[2]);
+				calculateRotations(8, _transformStates[3]);
 			}
 			else
 			{
 				interpolantY = blendY * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[1].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[2].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[5].data(), _transformStates[3]);
+				calculateRotations(1, _transformStates[0]);
+				calculateRotations(2, _transformStates[1]);
+				calculateRotations(4, _transformStates[2]);
+				calculateRotations(5, _transformStates[3]);
 			}
 		}
 		else
@@ -65,19 +82,19 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 			{
 				interpolantY = blendY * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[0].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[1].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[3].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[3]);
+				calculateRotations(0, _transformStates[0]);
+				calculateRotations(1, _transformStates[1]);
+				calculateRotations(3, _transformStates[2]);
+				calculateRotations(4, _transformStates[3]);
 			}
 			else
 			{
 				interpolantY = (blendY - 127.0) * 2;
 
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[3].data(), _transformStates[0]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[4].data(), _transformStates[1]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[6].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[7].data(), _transformStates[3]);
+				calculateRotations(3, _transformStates[0]);
+				calculateRotations(4, _transformStates[1]);
+				calculateRotations(6, _transformStates[2]);
+				calculateRotations(7, _transformStates[3]);
 			}
 		}
 
@@ -90,19 +107,19 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 	}
 	else if (sequence.AnimationBlends.size() > 0)
 	{
-		CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[0].data(), _transformStates[0]);
+		calculateRotations(0, _transformStates[0]);
 
 		if (sequence.AnimationBlends.size() > 1)
 		{
-			CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[1].data(), _transformStates[1]);
+			calculateRotations(1, _transformStates[1]);
 			float s = transformInfo.Blenders[0] / 255.0;
 
 			SlerpBones(studioModel, s, _transformStates[1], _transformStates[0]);
 
 			if (sequence.AnimationBlends[0].size() == 4)
 			{
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[2].data(), _transformStates[2]);
-				CalculateRotations(studioModel, transformInfo, sequence, sequence.AnimationBlends[3].data(), _transformStates[3]);
+				calculateRotations(2, _transformStates[2]);
+				calculateRotations(3, _transformStates[3]);
 
 				s = transformInfo.Blenders[0] / 255.0;
 				SlerpBones(studioModel, s, _transformStates[3], _transformStates[2]);
@@ -116,14 +133,20 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 	{
 		std::array<StudioAnimation, MAXSTUDIOBONES> dummyAnims;
 
-		CalculateRotations(studioModel, transformInfo, sequence, dummyAnims.data(), _transformStates[0]);
+		CalculateRotations(studioModel, transformInfo, sequence, dummyAnims.data(), nullptr, 0, _transformStates[0]);
 	}
 
 	for (std::size_t i = 0; i < studioModel.Bones.size(); ++i)
 	{
 		const auto& bone = *studioModel.Bones[i];
 
-		const auto bonematrix = glm::translate(_transformStates[0].Positions[i]) * glm::toMat4(_transformStates[0].Quaternions[i]);
+		const auto& positions = _transformStates[0].Positions;
+		const auto& quaternions = _transformStates[0].Quaternions;
+
+		const glm::vec3 position{positions[0][i], positions[1][i], positions[2][i]};
+		const glm::quat quaternion{quaternions[3][i], quaternions[0][i], quaternions[1][i], quaternions[2][i]};
+
+		const auto bonematrix = glm::translate(position) * glm::toMat4(quaternion);
 
 		if (!bone.Parent)
 		{
@@ -142,37 +165,78 @@ const std::array<glm::mat4x4, MAXSTUDIOBONES>& BoneTransformer::SetUpBones(
 
 void BoneTransformer::CalculateRotations(
 	const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
-	const StudioSequence& sequence, const StudioAnimation* anims, TransformState& transformState)
+	const StudioSequence& sequence, const StudioAnimation* anims,
+	const DecodedAnimation* decodedAnimation, std::size_t blend, TransformState& transformState)
 {
 	const int frame = (int)transformInfo.Frame;
 	const float s = (transformInfo.Frame - frame);
 
+	// Both paths decode the same frame so cached and uncached animations look identical.
+	// The cache only holds frames that exist in the sequence.
+	const int decodedFrame = std::clamp(frame, 0, std::max(0, sequence.NumFrames - 1));
+
 	// add in programatic controllers
 	std::array<float, MAXSTUDIOCONTROLLERS> boneAdjust;
 	CalculateBoneAdjust(studioModel, transformInfo, boneAdjust);
 
-	for (std::size_t i = 0; i < studioModel.Bones.size(); ++i)
+	const std::size_t numBones = studioModel.Bones.size();
+
+	// Angles to interpolate between, converted to quaternions in one batch once all bones have been decoded
+	BoneVectors angles1, angles2;
+
+	for (std::size_t i = 0; i < numBones; ++i)
 	{
 		const auto& bone = *studioModel.Bones[i];
-		const auto& anim = anims[i];
 
-		CalculateBoneQuaternion(frame, s, bone, anim, boneAdjust, transformState.Quaternions[i]);
-		CalculateBonePosition(frame, s, bone, anim, boneAdjust, transformState.Positions[i]);
+		std::array<DecodedAnimationValue, STUDIO_NUM_COORDINATE_AXES> decodedValues;
+		const DecodedAnimationValue* values;
+
+		if (decodedAnimation)
+		{
+			values = decodedAnimation->GetValues(blend, i, decodedFrame);
+		}
+		else
+		{
+			const auto& anim = anims[i];
+
+			for (int axis = 0; axis < STUDIO_NUM_COORDINATE_AXES; ++axis)
+			{
+				if (!anim.Data[axis].empty())
+				{
+					decodedValues[axis] = axis < 3 ? DecodePositionValues(anim, axis, decodedFrame) : DecodeRotationValues(anim, axis, decodedFrame);
+				}
+			}
+
+			values = decodedValues.data();
+		}
+
+		CalculateBoneAngles(i, bone, values + 3, boneAdjust, angles1, angles2);
+		CalculateBonePosition(i, s, bone, values, boneAdjust, transformState.Positions);
 	}
 
+	auto& quaternions = transformState.Quaternions;
+
+	BoneQuaternions quaternions2;
+
+	AnglesToQuaternions(numBones, angles1, quaternions);
+	AnglesToQuaternions(numBones, angles2, quaternions2);
+
+	// Bones whose angles don't change between frames have identical quaternions, which are left as they are.
+	SlerpQuaternions(numBones, s, quaternions2, quaternions);
+
 	if (sequence.MotionType & STUDIO_X)
 	{
-		transformState.Positions[sequence.MotionBone][0] = 0.0;
+		transformState.Positions[0][sequence.MotionBone] = 0.0;
 	}
 
 	if (sequence.MotionType & STUDIO_Y)
 	{
-		transformState.Positions[sequence.MotionBone][1] = 0.0;
+		transformState.Positions[1][sequence.MotionBone] = 0.0;
 	}
 
 	if (sequence.MotionType & STUDIO_Z)
 	{
-		transformState.Positions[sequence.MotionBone][2] = 0.0;
+		transformState.Positions[2][sequence.MotionBone] = 0.0;
 	}
 }
 
@@ -224,159 +288,163 @@ void BoneTransformer::CalculateBoneAdjust(
 	}
 }
 
-void BoneTransformer::CalculateBoneQuaternion(
-	const int frame, const float s, const StudioBone& bone, const StudioAnimation& anim,
-	const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, glm::quat& q)
+void BoneTransformer::CalculateBoneAngles(
+	const std::size_t index, const StudioBone& bone, const DecodedAnimationValue* values,
+	const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, BoneVectors& angles1, BoneVectors& angles2)
 {
-	glm::vec3 angle1{}, angle2{};
-
 	for (std::size_t j = 0; j < 3; ++j)
 	{
 		const auto& axis = bone.Axes[j + 3];
 
-		if (anim.Data[j + 3].empty())
+		angles1[j][index] = axis.Value + values[j].Value1 * axis.Scale;
+		angles2[j][index] = axis.Value + values[j].Value2 * axis.Scale;
+
+		if (axis.Controller)
 		{
-			angle2[j] = angle1[j] = axis.Value; // default;
+			angles1[j][index] += boneAdjust[axis.Controller->ArrayIndex];
+			angles2[j][index] += boneAdjust[axis.Controller->ArrayIndex];
 		}
-		else
-		{
-			auto panimvalue = anim.Data[j + 3].data();
-			auto k = frame;
-
-			while (panimvalue->num.total <= k)
-			{
-				k -= panimvalue->num.total;
-				panimvalue += panimvalue->num.valid + 1;
-			}
-
-			// Bah, missing blend!
-			if (panimvalue->num.valid > k)
-			{
-				angle1[j] = panimvalue[k + 1].value;
+	}
+}
 
-				if (panimvalue->num.valid > k + 1)
-				{
-					angle2[j] = panimvalue[k + 2].value;
-				}
-				else
-				{
-					if (panimvalue->num.total > k + 1)
-					{
-						angle2[j] = angle1[j];
-					}
-					else
-					{
-						angle2[j] = panimvalue[panimvalue->num.valid + 2].value;
-					}
-				}
-			}
-			else
-			{
-				angle1[j] = panimvalue[panimvalue->num.valid].value;
+void BoneTransformer::CalculateBonePosition(
+	const std::size_t index, const float s, const StudioBone& bone, const DecodedAnimationValue* values,
+	const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, BoneVectors& positions)
+{
+	for (std::size_t j = 0; j < 3; ++j)
+	{
+		const auto& axis = bone.Axes[j];
+		const auto& value = values[j];
 
-				if (panimvalue->num.total > k + 1)
-				{
-					angle2[j] = angle1[j];
-				}
-				else
-				{
-					angle2[j] = panimvalue[panimvalue->num.valid + 2].value;
-				}
-			}
+		float pos = axis.Value; // default;
 
-			angle1[j] = axis.Value + angle1[j] * axis.Scale;
-			angle2[j] = axis.Value + angle2[j] * axis.Scale;
+		if (value.Interpolate)
+		{
+			pos += (value.Value1 * (1.0 - s) + s * value.Value2) * axis.Scale;
+		}
+		else
+		{
+			pos += value.Value1 * axis.Scale;
 		}
 
 		if (axis.Controller)
 		{
-			angle1[j] += boneAdjust[axis.Controller->ArrayIndex];
-			angle2[j] += boneAdjust[axis.Controller->ArrayIndex];
+			pos += boneAdjust[axis.Controller->ArrayIndex];
 		}
+
+		positions[j][index] = pos;
 	}
+}
+
+void BoneTransformer::SlerpBones(
+	const EditableStudioModel& studioModel, float s, const TransformState& fromState, TransformState& toState)
+{
+	s = std::clamp(s, 0.0f, 1.0f);
 
-	if (!VectorCompare(angle1, angle2))
+	SlerpQuaternions(studioModel.Bones.size(), s, fromState.Quaternions, toState.Quaternions);
+	LerpVectors(studioModel.Bones.size(), s, fromState.Positions, toState.Positions);
+}
+
+void SetUpBonesBatch(const EditableStudioModel& studioModel, std::span<const BoneTransformInfo> poses,
+	std::span<glm::mat4x4> boneTransforms, unsigned int maxThreads)
+{
+	const std::size_t numBones = studioModel.Bones.size();
+
+	if (boneTransforms.size() < poses.size() * numBones)
 	{
-		const glm::quat q1{angle1};
-		const glm::quat q2{angle2};
+		throw std::invalid_argument("Bone transform buffer is too small for the requested poses");
+	}
 
-		q = glm::slerp(q1, q2, s);
+	if (poses.empty() || numBones == 0)
+	{
+		return;
 	}
-	else
+
+	if (maxThreads == 0)
 	{
-		q = glm::quat{angle1};
+		maxThreads = std::max(1u, std::thread::hardware_concurrency());
 	}
-}
 
-void BoneTransformer::CalculateBonePosition(
-	const int frame, const float s, const StudioBone& bone, const StudioAnimation& anim,
-	const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, glm::vec3& pos)
-{
-	for (std::size_t j = 0; j < 3; ++j)
+	const std::size_t taskCount = std::min<std::size_t>(maxThreads, poses.size());
+	const std::size_t posesPerTask = (poses.size() + taskCount - 1) / taskCount;
+
+	const auto setUpPoses = [&](std::size_t first)
 	{
-		const auto& axis = bone.Axes[j];
+		const std::size_t last = std::min(first + posesPerTask, poses.size());
 
-		pos[j] = axis.Value; // default;
+		// Each task only sees part of the sequence, so decoding all of it would cost more than it saves.
+		auto transformer = std::make_unique<BoneTransformer>();
+		transformer->GetDecodedAnimationCache().SetBudget(0);
 
-		if (!anim.Data[j].empty())
+		for (std::size_t i = first; i < last; ++i)
 		{
-			auto panimvalue = anim.Data[j].data();
+			const auto& bones = transformer->SetUpBones(studioModel, poses[i]);
+			std::copy_n(bones.begin(), numBones, boneTransforms.begin() + (i * numBones));
+		}
+	};
 
-			auto k = frame;
+	std::vector<std::future<void>> tasks;
 
-			// find span of values that includes the frame we want
-			while (panimvalue->num.total <= k)
-			{
-				k -= panimvalue->num.total;
-				panimvalue += panimvalue->num.valid + 1;
-			}
+	tasks.reserve(taskCount - 1);
 
-			// if we're inside the span
-			if (panimvalue->num.valid > k)
-			{
-				// and there's more data in the span
-				if (panimvalue->num.valid > k + 1)
-				{
-					pos[j] += (panimvalue[k + 1].value * (1.0 - s) + s * panimvalue[k + 2].value) * axis.Scale;
-				}
-				else
-				{
-					pos[j] += panimvalue[k + 1].value * axis.Scale;
-				}
-			}
-			else
+	for (std::size_t first = posesPerTask; first < poses.size(); first += posesPerTask)
+	{
+		tasks.push_back(std::async(std::launch::async, setUpPoses, first));
+	}
+
+	std::exception_ptr error;
+
+	try
+	{
+		setUpPoses(0);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	// Wait for all tasks to finish before reporting errors since they reference the caller's buffers.
+	for (auto& task : tasks)
+	{
+		try
+		{
+			task.get();
+		}
+		catch (...)
+		{
+			if (!error)
 			{
-				// are we at the end of the repeating values section and there's another section with data?
-				if (panimvalue->num.total <= k + 1)
-				{
-					pos[j] += (panimvalue[panimvalue->num.valid].value * (1.0 - s) + s * panimvalue[panimvalue->num.valid + 2].value) * axis.Scale;
-				}
-				else
-				{
-					pos[j] += panimvalue[panimvalue->num.valid].value * axis.Scale;
-				}
+				error = std::current_exception();
 			}
 		}
+	}
 
-		if (axis.Controller)
-		{
-			pos[j] += boneAdjust[axis.Controller->ArrayIndex];
-		}
+	if (error)
+	{
+		std::rethrow_exception(error);
 	}
 }
 
-void BoneTransformer::SlerpBones(
-	const EditableStudioModel& studioModel, float s, const TransformState& fromState, TransformState& toState)
+void SetUpBonesForFrames(const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
+	int firstFrame, int frameCount, std::span<glm::mat4x4> boneTransforms, unsigned int maxThreads)
 {
-	s = std::clamp(s, 0.0f, 1.0f);
+	std::vector<BoneTransformInfo> poses;
 
-	const float s1 = 1.0 - s;
+	poses.reserve(std::max(0, frameCount));
 
-	for (std::size_t i = 0; i < studioModel.Bones.size(); ++i)
+	for (int frame = firstFrame; frame < firstFrame + frameCount; ++frame)
 	{
-		toState.Quaternions[i] = glm::slerp(toState.Quaternions[i], fromState.Quaternions[i], s);
-
-		toState.Positions[i] = toState.Positions[i] * s1 + fromState.Positions[i] * s;
+		poses.push_back(BoneTransformInfo
+			{
+				transformInfo.SequenceIndex,
+				static_cast<float>(frame),
+				transformInfo.Scale,
+				transformInfo.Blenders,
+				transformInfo.Controllers,
+				transformInfo.Mouth
+			});
 	}
+
+	SetUpBonesBatch(studioModel, poses, boneTransforms, maxThreads);
 }
 }
@@ -3,6 +3,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 #include <glm/mat4x4.hpp>
@@ -10,6 +11,8 @@
 #include <glm/vec4.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "formats/studiomodel/BoneTransformKernels.hpp"
+#include "formats/studiomodel/DecodedAnimationCache.hpp"
 #include "formats/studiomodel/StudioModelFileFormat.hpp"
 
 namespace studiomdl
@@ -39,8 +42,8 @@ private:
 
 	struct TransformState
 	{
-		std::array<glm::vec3, MAXSTUDIOBONES> Positions;
-		std::array<glm::quat, MAXSTUDIOBONES> Quaternions;
+		BoneVectors Positions;
+		BoneQuaternions Quaternions;
 	};
 
 public:
@@ -54,20 +57,28 @@ public:
 	const std::array<glm::mat4x4, MAXSTUDIOBONES>& SetUpBones(
 		const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo);
 
+	/**
+	*	@brief Cache of decoded animations used to avoid decoding sequences that are played repeatedly
+	*/
+	DecodedAnimationCache& GetDecodedAnimationCache() { return _decodedAnimationCache; }
+
+	const DecodedAnimationCache& GetDecodedAnimationCache() const { return _decodedAnimationCache; }
+
 private:
 	static void CalculateRotations(
 		const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
-		const StudioSequence& sequence, const StudioAnimation* anims, TransformState& transformState);
+		const StudioSequence& sequence, const StudioAnimation* anims,
+		const DecodedAnimation* decodedAnimation, std::size_t blend, TransformState& transformState);
 
 	static void CalculateBoneAdjust(
 		const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
 		std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust);
-	static void CalculateBoneQuaternion(
-		const int frame, const float s, const StudioBone& bone, const StudioAnimation& anim,
-		const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, glm::quat& q);
+	static void CalculateBoneAngles(
+		const std::size_t index, const StudioBone& bone, const DecodedAnimationValue* values,
+		const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, BoneVectors& angles1, BoneVectors& angles2);
 	static void CalculateBonePosition(
-		const int frame, const float s, const StudioBone&, const StudioAnimation& anim,
-		const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, glm::vec3& pos);
+		const std::size_t index, const float s, const StudioBone& bone, const DecodedAnimationValue* values,
+		const std::array<float, MAXSTUDIOCONTROLLERS>& boneAdjust, BoneVectors& positions);
 	static void SlerpBones(
 		const EditableStudioModel& studioModel, float s, const TransformState& fromState, TransformState& toState);
 
@@ -76,5 +87,28 @@ private:
 	std::array<TransformState, TransformStatesCount> _transformStates{};
 
 	std::array<glm::mat4x4, MAXSTUDIOBONES> _boneTransform{};
+
+	DecodedAnimationCache _decodedAnimationCache;
 };
+
+/**
+*	@brief Sets up the bones for each of the given poses, spreading the work over multiple threads.
+*	@param studioModel Model to set up. Must not be modified until this returns.
+*	@param poses Inputs for each pose to set up.
+*	@param boneTransforms Receives the bone matrices of each pose in order, @c studioModel.Bones.size() matrices per pose.
+*	@param maxThreads Maximum number of threads to use, or 0 to use one per hardware thread.
+*	@throws std::invalid_argument If @p boneTransforms is too small to hold all poses.
+*/
+void SetUpBonesBatch(const EditableStudioModel& studioModel, std::span<const BoneTransformInfo> poses,
+	std::span<glm::mat4x4> boneTransforms, unsigned int maxThreads = 0);
+
+/**
+*	@brief Sets up the bones for a range of frames of a sequence, spreading the work over multiple threads.
+*	@param transformInfo Sequence and remaining inputs to use for each frame. Its frame is ignored.
+*	@param firstFrame First frame to set up.
+*	@param frameCount Number of frames to set up.
+*	@see SetUpBonesBatch
+*/
+void SetUpBonesForFrames(const EditableStudioModel& studioModel, const BoneTransformInfo& transformInfo,
+	int firstFrame, int frameCount, std::span<glm::mat4x4> boneTransforms, unsigned int maxThreads = 0);
 }
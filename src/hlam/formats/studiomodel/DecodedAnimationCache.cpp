@@ -0,0 +1,187 @@
+#include <cassert>
+#include <iterator>
+
+#include "formats/studiomodel/DecodedAnimationCache.hpp"
+#include "formats/studiomodel/EditableStudioModel.hpp"
+
+namespace studiomdl
+{
+DecodedAnimationValue DecodePositionValues(const StudioAnimation& anim, int axis, int frame)
+{
+	// find span of values that includes the frame we want
+	const auto panimvalue = anim.FindSpan(axis, frame);
+
+	DecodedAnimationValue result;
+
+	// if we're inside the span
+	if (panimvalue->num.valid > frame)
+	{
+		result.Value1 = panimvalue[frame + 1].value;
+
+		// and there's more data in the span
+		result.Interpolate = panimvalue->num.valid > frame + 1;
+		result.Value2 = result.Interpolate ? panimvalue[frame + 2].value : result.Value1;
+	}
+	else
+	{
+		result.Value1 = panimvalue[panimvalue->num.valid].value;
+
+		// are we at the end of the repeating values section and there's another section with data?
+		result.Interpolate = panimvalue->num.total <= frame + 1;
+		result.Value2 = result.Interpolate ? panimvalue[panimvalue->num.valid + 2].value : result.Value1;
+	}
+
+	return result;
+}
+
+DecodedAnimationValue DecodeRotationValues(const StudioAnimation& anim, int axis, int frame)
+{
+	const auto panimvalue = anim.FindSpan(axis, frame);
+
+	DecodedAnimationValue result;
+
+	// Bah, missing blend!
+	if (panimvalue->num.valid > frame)
+	{
+		result.Value1 = panimvalue[frame + 1].value;
+
+		if (panimvalue->num.valid > frame + 1)
+		{
+			result.Value2 = panimvalue[frame + 2].value;
+			return result;
+		}
+	}
+	else
+	{
+		result.Value1 = panimvalue[panimvalue->num.valid].value;
+	}
+
+	if (panimvalue->num.total > frame + 1)
+	{
+		result.Value2 = result.Value1;
+	}
+	else
+	{
+		result.Value2 = panimvalue[panimvalue->num.valid + 2].value;
+	}
+
+	return result;
+}
+
+void DecodedAnimationCache::SetBudget(std::size_t budgetInBytes)
+{
+	_budgetInBytes = budgetInBytes;
+	EvictToBudget(_budgetInBytes);
+}
+
+void DecodedAnimationCache::Clear()
+{
+	_lookup.clear();
+	_entries.clear();
+	_sizeInBytes = 0;
+}
+
+const DecodedAnimation* DecodedAnimationCache::Get(const StudioSequence& sequence, std::size_t numBones)
+{
+	if (_budgetInBytes == 0 || sequence.AnimationBlends.empty() || sequence.NumFrames <= 0 || numBones == 0)
+	{
+		return nullptr;
+	}
+
+	auto owner = sequence.AnimationBlends.GetDataHandle();
+	const void* const key = owner.lock().get();
+
+	if (auto it = _lookup.find(key); it != _lookup.end())
+	{
+		const auto entry = it->second;
+		const auto& animation = *entry->Animation;
+
+		// An expired owner means the data this was decoded from was destroyed and the address reused.
+		if (!entry->Owner.expired()
+			&& animation.NumBones == numBones
+			&& animation.NumFrames == static_cast<std::size_t>(sequence.NumFrames))
+		{
+			_entries.splice(_entries.begin(), _entries, entry);
+			return entry->Animation.get();
+		}
+
+		Remove(entry);
+	}
+
+	const std::size_t requiredSize = sizeof(DecodedAnimation)
+		+ (sequence.AnimationBlends.size() * numBones * sequence.NumFrames
+			* STUDIO_NUM_COORDINATE_AXES * sizeof(DecodedAnimationValue));
+
+	if (requiredSize > _budgetInBytes)
+	{
+		return nullptr;
+	}
+
+	EvictToBudget(_budgetInBytes - requiredSize);
+
+	auto animation = Decode(sequence, numBones);
+
+	assert(animation->GetSizeInBytes() == requiredSize);
+
+	_sizeInBytes += requiredSize;
+	_entries.push_front(Entry{key, std::move(owner), std::move(animation)});
+	_lookup.emplace(key, _entries.begin());
+
+	return _entries.front().Animation.get();
+}
+
+std::unique_ptr<DecodedAnimation> DecodedAnimationCache::Decode(const StudioSequence& sequence, std::size_t numBones)
+{
+	auto animation = std::make_unique<DecodedAnimation>();
+
+	animation->NumBlends = sequence.AnimationBlends.size();
+	animation->NumBones = numBones;
+	animation->NumFrames = static_cast<std::size_t>(sequence.NumFrames);
+
+	animation->Values.resize(
+		animation->NumBlends * animation->NumBones * animation->NumFrames * STUDIO_NUM_COORDINATE_AXES);
+
+	auto value = animation->Values.begin();
+
+	for (std::size_t blend = 0; blend < animation->NumBlends; ++blend)
+	{
+		const auto& anims = sequence.AnimationBlends[blend];
+
+		for (std::size_t bone = 0; bone < animation->NumBones; ++bone)
+		{
+			const auto& anim = anims[bone];
+
+			for (int frame = 0; frame < sequence.NumFrames; ++frame)
+			{
+				for (int axis = 0; axis < STUDIO_NUM_COORDINATE_AXES; ++axis, ++value)
+				{
+					// Empty axes use only the bone's default value.
+					if (anim.Data[axis].empty())
+					{
+						continue;
+					}
+
+					*value = axis < 3 ? DecodePositionValues(anim, axis, frame) : DecodeRotationValues(anim, axis, frame);
+				}
+			}
+		}
+	}
+
+	return animation;
+}
+
+void DecodedAnimationCache::Remove(EntryList::iterator it)
+{
+	_lookup.erase(it->Key);
+	_sizeInBytes -= it->Animation->GetSizeInBytes();
+	_entries.erase(it);
+}
+
+void DecodedAnimationCache::EvictToBudget(std::size_t budgetInBytes)
+{
+	while (_sizeInBytes > budgetInBytes && !_entries.empty())
+	{
+		Remove(std::prev(_entries.end()));
+	}
+}
+}
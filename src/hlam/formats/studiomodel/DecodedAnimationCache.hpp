@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "formats/studiomodel/StudioModelFileFormat.hpp"
+
+namespace studiomdl
+{
+struct StudioAnimation;
+struct StudioSequence;
+
+/**
+*	@brief Pair of raw animation values to interpolate between for a single frame.
+*	These are the values stored in the file, before the bone's value and scale are applied.
+*/
+struct DecodedAnimationValue
+{
+	float Value1{};
+	float Value2{};
+
+	/**
+	*	@brief Whether the position is interpolated between @ref Value1 and @ref Value2.
+	*	Only set for position axes; positions that aren't interpolated use @ref Value1 as-is.
+	*/
+	bool Interpolate{};
+};
+
+/**
+*	@brief Fully decoded animation values for every frame of every blend in a sequence.
+*/
+struct DecodedAnimation
+{
+	std::size_t NumBlends{};
+	std::size_t NumBones{};
+	std::size_t NumFrames{};
+
+	//Laid out as [blend][bone][frame][axis] so each bone's data is contiguous
+	std::vector<DecodedAnimationValue> Values;
+
+	std::size_t GetSizeInBytes() const
+	{
+		return sizeof(DecodedAnimation) + (Values.size() * sizeof(DecodedAnimationValue));
+	}
+
+	/**
+	*	@brief Gets the values for all axes of the given bone at the given frame.
+	*	@param frame Frame to get. Clamped to the last frame.
+	*/
+	const DecodedAnimationValue* GetValues(std::size_t blend, std::size_t bone, std::size_t frame) const
+	{
+		frame = std::min(frame, NumFrames - 1);
+		return &Values[(((blend * NumBones) + bone) * NumFrames + frame) * STUDIO_NUM_COORDINATE_AXES];
+	}
+};
+
+/**
+*	@brief Decodes the values to interpolate between for the given frame of a position axis.
+*	@param axis Axis whose data to decode. Must not be empty.
+*/
+DecodedAnimationValue DecodePositionValues(const StudioAnimation& anim, int axis, int frame);
+
+/**
+*	@brief Decodes the values to interpolate between for the given frame of a rotation axis.
+*	@param axis Axis whose data to decode. Must not be empty.
+*/
+DecodedAnimationValue DecodeRotationValues(const StudioAnimation& anim, int axis, int frame);
+
+/**
+*	@brief Caches fully decoded animations for recently played sequences, up to a memory budget.
+*	Least recently used sequences are evicted first. Not thread safe.
+*/
+class DecodedAnimationCache final
+{
+public:
+	static constexpr std::size_t DefaultBudgetInBytes = 32 * 1024 * 1024;
+
+	DecodedAnimationCache() = default;
+	~DecodedAnimationCache() = default;
+
+	DecodedAnimationCache(const DecodedAnimationCache&) = delete;
+	DecodedAnimationCache& operator=(const DecodedAnimationCache&) = delete;
+
+	std::size_t GetBudget() const { return _budgetInBytes; }
+
+	/**
+	*	@brief Sets the memory budget. A budget of 0 disables the cache.
+	*/
+	void SetBudget(std::size_t budgetInBytes);
+
+	std::size_t GetSizeInBytes() const { return _sizeInBytes; }
+
+	void Clear();
+
+	/**
+	*	@brief Gets the decoded animation for the given sequence, decoding it on first use.
+	*	@return The decoded animation, or nullptr if the sequence has no animation data
+	*		or does not fit in the budget. Valid until the next call to a non-const member.
+	*/
+	const DecodedAnimation* Get(const StudioSequence& sequence, std::size_t numBones);
+
+private:
+	struct Entry
+	{
+		const void* Key{};
+
+		//Expires when the sequence's animation data is destroyed
+		std::weak_ptr<const void> Owner;
+		std::unique_ptr<DecodedAnimation> Animation;
+	};
+
+	using EntryList = std::list<Entry>;
+
+	static std::unique_ptr<DecodedAnimation> Decode(const StudioSequence& sequence, std::size_t numBones);
+
+	void Remove(EntryList::iterator it);
+
+	void EvictToBudget(std::size_t budgetInBytes);
+
+private:
+	std::size_t _budgetInBytes{DefaultBudgetInBytes};
+	std::size_t _sizeInBytes{};
+
+	//Most recently used first
+	EntryList _entries;
+	std::unordered_map<const void*, EntryList::iterator> _lookup;
+};
+}
@@ -1,9 +1,17 @@
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+#include <future>
 #include <limits>
+#include <thread>
+#include <unordered_map>
 
+#include <glm/common.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/rotate_vector.hpp>
 
+#include "formats/studiomodel/BoneTransformKernels.hpp"
 #include "formats/studiomodel/BoneTransformer.hpp"
 #include "formats/studiomodel/EditableStudioModel.hpp"
 
@@ -14,8 +22,144 @@
 
 namespace studiomdl
 {
+const StudioAnimationBlends::Blends& StudioAnimationBlends::GetBlends() const
+{
+	static const Blends EmptyBlends;
+
+	if (!_state)
+	{
+		return EmptyBlends;
+	}
+
+	std::call_once(_state->Once, [this]()
+		{
+			_state->Data = _state->Load();
+			assert(_state->Data.size() == _count);
+
+			// Release whatever the loader is keeping alive.
+			_state->Load = {};
+		});
+
+	return _state->Data;
+}
+
+void StudioAnimation::BuildSpanIndex()
+{
+	for (int axis = 0; axis < STUDIO_NUM_COORDINATE_AXES; ++axis)
+	{
+		const auto& data = Data[axis];
+		auto& spans = Spans[axis];
+
+		spans.clear();
+
+		int frame = 0;
+
+		for (std::size_t index = 0; index < data.size(); index += data[index].num.valid + 1)
+		{
+			spans.push_back({frame, static_cast<int>(index)});
+			frame += data[index].num.total;
+		}
+	}
+}
+
+const mstudioanimvalue_t* StudioAnimation::FindSpan(int axis, int& frame) const
+{
+	auto panimvalue = Data[axis].data();
+
+	if (const auto& spans = Spans[axis]; frame >= 0 && !spans.empty())
+	{
+		//Last span that starts at or before the frame. Spans with no frames share their start with the next span,
+		//so this is the same span that a linear scan would stop at.
+		const auto span = std::upper_bound(spans.begin(), spans.end(), frame,
+			[](int frame, const StudioAnimationSpan& span)
+			{
+				return frame < span.FirstFrame;
+			}) - 1;
+
+		panimvalue += span->ValueIndex;
+		frame -= span->FirstFrame;
+	}
+
+	//Only runs for frames outside the span index, which keeps the result identical to a linear scan
+	while (panimvalue->num.total <= frame)
+	{
+		frame -= panimvalue->num.total;
+		panimvalue += panimvalue->num.valid + 1;
+	}
+
+	return panimvalue;
+}
+
+void CookMesh(StudioMesh& mesh)
+{
+	mesh.CookedVertices.clear();
+	mesh.CookedIndices.clear();
+
+	static_assert(sizeof(StudioMeshVertex) == sizeof(std::uint64_t), "Vertices are used as lookup keys");
+
+	//Maps each unique vertex to its index in the cooked vertex list
+	std::unordered_map<std::uint64_t, std::uint32_t> lookup;
+
+	std::vector<std::uint32_t> commandVertices;
+
+	for (auto cmds = mesh.Triangles.data(); int count = *cmds++;)
+	{
+		const bool isFan = count < 0;
+
+		if (isFan)
+		{
+			count = -count;
+		}
+
+		commandVertices.clear();
+
+		for (int i = 0; i < count; ++i, cmds += 4)
+		{
+			const StudioMeshVertex vertex{cmds[0], cmds[1], cmds[2], cmds[3]};
+
+			std::uint64_t key = 0;
+			std::memcpy(&key, &vertex, sizeof(vertex));
+
+			const auto [it, inserted] = lookup.try_emplace(key, static_cast<std::uint32_t>(mesh.CookedVertices.size()));
+
+			if (inserted)
+			{
+				mesh.CookedVertices.push_back(vertex);
+			}
+
+			commandVertices.push_back(it->second);
+		}
+
+		for (int triangle = 0; triangle + 2 < count; ++triangle)
+		{
+			if (isFan)
+			{
+				mesh.CookedIndices.insert(mesh.CookedIndices.end(),
+					{commandVertices[0], commandVertices[triangle + 1], commandVertices[triangle + 2]});
+			}
+			else if (triangle % 2 == 0)
+			{
+				mesh.CookedIndices.insert(mesh.CookedIndices.end(),
+					{commandVertices[triangle], commandVertices[triangle + 1], commandVertices[triangle + 2]});
+			}
+			else
+			{
+				//Odd triangles in a strip have their first two vertices swapped to keep a consistent winding
+				mesh.CookedIndices.insert(mesh.CookedIndices.end(),
+					{commandVertices[triangle + 1], commandVertices[triangle], commandVertices[triangle + 2]});
+			}
+		}
+	}
+}
+
 EditableStudioModel::~EditableStudioModel() = default;
 
+std::uint64_t EditableStudioModel::NextEditGeneration()
+{
+	static std::atomic<std::uint64_t> NextGeneration{1};
+	return NextGeneration++;
+}
+
 const StudioSubModel* EditableStudioModel::GetModelByBodyPart(const int iBody, const int iBodyPart) const
 {
 	auto& bodypart = *Bodyparts[iBodyPart];
@@ -96,14 +240,42 @@ std::vector<const StudioMesh*> EditableStudioModel::ComputeMeshList(const int te
 	return meshes;
 }
 
-void EditableStudioModel::CreateTextures(graphics::TextureLoader& textureLoader)
+void EditableStudioModel::PrepareTextures()
 {
 	for (auto& texture : Textures)
 	{
-		texture->TextureId = textureLoader.CreateTexture();
+		texture->PreparedPixels = graphics::TextureLoader::ConvertIndexed8ToRGBA8888(
+			texture->Data.Width, texture->Data.Height,
+			texture->Data.Pixels.data(),
+			GetTexturePalette(*texture),
+			(texture->Flags & STUDIO_NF_MASKED) != 0);
 	}
+}
 
-	UpdateTextures(textureLoader);
+void EditableStudioModel::CreateTextures(graphics::TextureLoader& textureLoader)
+{
+	for (std::size_t index = 0; auto& texture : Textures)
+	{
+		texture->TextureId = textureLoader.CreateTexture();
+
+		if (texture->PreparedPixels.empty())
+		{
+			UpdateTexture(textureLoader, index);
+		}
+		else
+		{
+			textureLoader.UploadRGBA8888(
+				texture->TextureId,
+				texture->Data.Width, texture->Data.Height,
+				texture->PreparedPixels.data(),
+				(texture->Flags & STUDIO_NF_MIPMAPS) != 0,
+				(texture->Flags & STUDIO_NF_MASKED) != 0);
+
+			texture->PreparedPixels = {};
+		}
+
+		++index;
+	}
 }
 
 void EditableStudioModel::UpdateTexture(graphics::TextureLoader& textureLoader, std::size_t index)
@@ -116,25 +288,11 @@ void EditableStudioModel::UpdateTexture(graphics::TextureLoader& textureLoader,
 
 	auto& texture = *Textures[index];
 
-	graphics::RGBPalette palette{texture.Data.Palette};
-
-	int low, mid, high;
-
-	if (graphics::TryGetRemapColors(texture.Name, low, mid, high))
-	{
-		graphics::PaletteHueReplace(palette, TopColor, low, mid);
-
-		if (high)
-		{
-			graphics::PaletteHueReplace(palette, BottomColor, mid + 1, high);
-		}
-	}
-
 	textureLoader.UploadIndexed8(
 		texture.TextureId,
 		texture.Data.Width, texture.Data.Height,
 		texture.Data.Pixels.data(),
-		palette,
+		GetTexturePalette(texture),
 		(texture.Flags & STUDIO_NF_MIPMAPS) != 0,
 		(texture.Flags & STUDIO_NF_MASKED) != 0);
 }
@@ -147,6 +305,25 @@ void EditableStudioModel::UpdateTextures(graphics::TextureLoader& textureLoader)
 	}
 }
 
+graphics::RGBPalette EditableStudioModel::GetTexturePalette(const StudioTexture& texture) const
+{
+	graphics::RGBPalette palette{texture.Data.Palette};
+
+	int low, mid, high;
+
+	if (graphics::TryGetRemapColors(texture.Name, low, mid, high))
+	{
+		graphics::PaletteHueReplace(palette, TopColor, low, mid);
+
+		if (high)
+		{
+			graphics::PaletteHueReplace(palette, BottomColor, mid + 1, high);
+		}
+	}
+
+	return palette;
+}
+
 void EditableStudioModel::DeleteTextures(graphics::TextureLoader& textureLoader)
 {
 	for (auto& texture : Textures)
@@ -457,6 +634,112 @@ void ApplyScaleSequenceBBoxesData(EditableStudioModel& studioModel,
 	
 }
 
+std::vector<std::pair<glm::vec3, glm::vec3>> ComputeSequenceBBoxes(const EditableStudioModel& studioModel)
+{
+	auto data = GetScaleSequenceBBoxesData(studioModel);
+
+	const std::size_t numBones = studioModel.Bones.size();
+
+	// Group vertices by bone so each bone's vertices can be transformed in one go.
+	std::vector<std::vector<glm::vec3>> verticesByBone(numBones);
+
+	bool hasVertices = false;
+
+	for (const auto& bodypart : studioModel.Bodyparts)
+	{
+		for (const auto& model : bodypart->Models)
+		{
+			for (const auto& vertex : model.Vertices)
+			{
+				verticesByBone[vertex.Bone->ArrayIndex].push_back(vertex.Vertex);
+				hasVertices = true;
+			}
+		}
+	}
+
+	if (!hasVertices)
+	{
+		return data;
+	}
+
+	std::vector<BoneTransformInfo> poses;
+	std::vector<glm::mat4x4> boneTransforms;
+
+	for (std::size_t i = 0; i < studioModel.Sequences.size(); ++i)
+	{
+		const auto& sequence = *studioModel.Sequences[i];
+
+		const auto blendCount = sequence.AnimationBlends.size();
+
+		const std::vector<std::uint8_t> noBlend{0};
+		const std::vector<std::uint8_t> blendValues = blendCount == 9
+			? std::vector<std::uint8_t>{0, 127, 255}
+			: std::vector<std::uint8_t>{0, 255};
+
+		const auto& xBlends = blendCount > 1 ? blendValues : noBlend;
+		const auto& yBlends = blendCount >= 4 ? blendValues : noBlend;
+
+		poses.clear();
+
+		for (int frame = 0; frame < std::max(1, sequence.NumFrames); ++frame)
+		{
+			for (const auto x : xBlends)
+			{
+				for (const auto y : yBlends)
+				{
+					poses.push_back(BoneTransformInfo{static_cast<int>(i), static_cast<float>(frame), glm::vec3{1}, {x, y}, {}, 0});
+				}
+			}
+		}
+
+		boneTransforms.resize(poses.size() * numBones);
+
+		SetUpBonesBatch(studioModel, poses, boneTransforms);
+
+		const auto computeBounds = [&](std::size_t first, std::size_t last)
+		{
+			glm::vec3 mins{std::numeric_limits<float>::max()};
+			glm::vec3 maxs{std::numeric_limits<float>::lowest()};
+
+			for (std::size_t pose = first; pose < last; ++pose)
+			{
+				for (std::size_t bone = 0; bone < numBones; ++bone)
+				{
+					GrowBoundsByTransformedPoints(boneTransforms[(pose * numBones) + bone], verticesByBone[bone], mins, maxs);
+				}
+			}
+
+			return std::make_pair(mins, maxs);
+		};
+
+		const std::size_t taskCount = std::min<std::size_t>(
+			std::max(1u, std::thread::hardware_concurrency()), poses.size());
+		const std::size_t posesPerTask = (poses.size() + taskCount - 1) / taskCount;
+
+		std::vector<std::future<std::pair<glm::vec3, glm::vec3>>> tasks;
+
+		for (std::size_t first = posesPerTask; first < poses.size(); first += posesPerTask)
+		{
+			tasks.push_back(std::async(std::launch::async, computeBounds,
+				first, std::min(first + posesPerTask, poses.size())));
+		}
+
+		auto bounds = computeBounds(0, std::min(posesPerTask, poses.size()));
+
+		for (auto& task : tasks)
+		{
+			const auto taskBounds = task.get();
+
+			bounds.first = glm::min(bounds.first, taskBounds.first);
+			bounds.second = glm::max(bounds.second, taskBounds.second);
+		}
+
+		data[i] = bounds;
+	}
+
+	return data;
+}
+
 std::vector<ScaleBonesBoneData> GetScaleBonesData(const EditableStudioModel& studioModel)
 {
 	std::vector<ScaleBonesBoneData> data;
@@ -792,6 +1075,8 @@ void ApplyScaledSTCoordinatesData(const EditableStudioModel& studioModel, const
 							++coordinates;
 						}
 					}
+
+					CookMesh(mesh);
 				}
 			}
 		}
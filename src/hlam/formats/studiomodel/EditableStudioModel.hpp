@@ -3,7 +3,9 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <utility>
@@ -72,10 +74,101 @@ struct StudioSequenceEvent
 	std::string Options;
 };
 
+/**
+*	@brief Start of a span of run-length encoded values in an animation axis.
+*/
+struct StudioAnimationSpan
+{
+	int FirstFrame = 0;
+
+	//Index of the span's count entry in the axis data
+	int ValueIndex = 0;
+};
+
 struct StudioAnimation
 {
 	//std::array<std::vector<short>, STUDIO_MAX_PER_BONE_CONTROLLERS> Data;
 	std::array<std::vector<mstudioanimvalue_t>, STUDIO_NUM_COORDINATE_AXES> Data;
+
+	//Spans in each axis, used to look up frames without scanning the data from the start
+	std::array<std::vector<StudioAnimationSpan>, STUDIO_NUM_COORDINATE_AXES> Spans;
+
+	/**
+	*	@brief (Re)builds the span index. Must be called whenever Data changes.
+	*/
+	void BuildSpanIndex();
+
+	/**
+	*	@brief Finds the span that contains the given frame.
+	*	@param axis Axis whose data to search. Must not be empty.
+	*	@param[in,out] frame Frame to find. On return, the frame relative to the start of the span.
+	*	@return Pointer to the span's count entry.
+	*/
+	const mstudioanimvalue_t* FindSpan(int axis, int& frame) const;
+};
+
+/**
+*	@brief Animation data for each blend of a sequence.
+*	The data is either provided up front or converted from the source file the first time it is accessed.
+*	Lazily converted data is safe to access from multiple threads.
+*/
+class StudioAnimationBlends final
+{
+public:
+	using Blends = std::vector<std::vector<StudioAnimation>>;
+	using Loader = std::function<Blends()>;
+
+	StudioAnimationBlends() = default;
+
+	StudioAnimationBlends(Blends&& blends)
+		: _count(blends.size())
+		, _state(std::make_shared<State>())
+	{
+		_state->Data = std::move(blends);
+		std::call_once(_state->Once, [] {});
+	}
+
+	/**
+	*	@param count Number of blends the loader produces.
+	*	@param loader Function that converts the data. Called at most once, on first access.
+	*/
+	StudioAnimationBlends(std::size_t count, Loader&& loader)
+		: _count(count)
+		, _state(std::make_shared<State>())
+	{
+		_state->Load = std::move(loader);
+	}
+
+	StudioAnimationBlends(StudioAnimationBlends&&) = default;
+	StudioAnimationBlends& operator=(StudioAnimationBlends&&) = default;
+
+	std::size_t size() const { return _count; }
+
+	bool empty() const { return _count == 0; }
+
+	const std::vector<StudioAnimation>& operator[](std::size_t index) const
+	{
+		return GetBlends()[index];
+	}
+
+	const Blends& GetBlends() const;
+
+	/**
+	*	@brief Gets a handle that expires when the animation data is destroyed.
+	*	Used to tell whether data derived from it is still valid.
+	*/
+	std::weak_ptr<const void> GetDataHandle() const { return _state; }
+
+private:
+	struct State
+	{
+		std::once_flag Once;
+		Loader Load;
+		Blends Data;
+	};
+
+	std::size_t _count{};
+	std::shared_ptr<State> _state;
 };
 
 struct StudioSequenceBlendData
@@ -120,7 +213,7 @@ struct StudioSequence
 	glm::vec3 BBMin{0};
 	glm::vec3 BBMax{0};
 
-	std::vector<std::vector<StudioAnimation>> AnimationBlends;
+	StudioAnimationBlends AnimationBlends;
 
 	std::array<StudioSequenceBlendData, SequenceBlendCount> BlendData;
 
@@ -144,6 +237,19 @@ struct StudioAttachment
 	std::array<glm::vec3, STUDIO_ATTACH_NUM_VECTORS> Vectors{{glm::vec3{0}, glm::vec3{0}, glm::vec3{0}}};
 };
 
+/**
+*	@brief Unique combination of vertex, normal and texture coordinates used by a mesh
+*/
+struct StudioMeshVertex
+{
+	short VertexIndex = 0;
+	short NormalIndex = 0;
+	short S = 0;
+	short T = 0;
+
+	bool operator==(const StudioMeshVertex&) const = default;
+};
+
 struct StudioMesh
 {
 	std::vector<short> Triangles;
@@ -151,8 +257,19 @@ struct StudioMesh
 	int NumTriangles = 0;
 	int NumNorms = 0;
 	int SkinRef = 0;
+
+	//Cooked from Triangles by CookMesh: deduplicated vertices and a triangle list indexing them
+	std::vector<StudioMeshVertex> CookedVertices;
+	std::vector<std::uint32_t> CookedIndices;
 };
 
+/**
+*	@brief Converts the mesh's triangle commands into an indexed triangle list.
+*	Triangle winding is preserved, so culling produces the same results as drawing the strips and fans directly.
+*	Must be called again whenever the mesh's triangle commands are changed.
+*/
+void CookMesh(StudioMesh& mesh);
+
 struct StudioModelVertexInfo
 {
 	glm::vec3 Vertex{0};
@@ -195,6 +312,9 @@ struct StudioTexture
 	int ArrayIndex = -1;
 
 	GLuint TextureId = 0;
+
+	// RGBA pixels converted ahead of time by EditableStudioModel::PrepareTextures, freed once uploaded.
+	std::vector<std::byte> PreparedPixels;
 };
 
 constexpr std::array<StudioSequenceBlendData, SequenceBlendCount> CounterStrikeBlendRanges{{{0, -180, 180}, {0, -45, 45}}};
@@ -245,6 +365,20 @@ public:
 
 	bool IsXashModel = false;
 
+	/**
+	*	@brief Gets a value that changes every time the model is edited.
+	*	Values are unique across all models so they can be used to tell whether data derived from a model is stale.
+	*/
+	std::uint64_t GetEditGeneration() const { return _editGeneration; }
+
+	/**
+	*	@brief Must be called after the model has been edited.
+	*/
+	void MarkEdited()
+	{
+		_editGeneration = NextEditGeneration();
+	}
+
 	const StudioSubModel* GetModelByBodyPart(const int iBody, const int iBodyPart) const;
 
 	int GetBodyValueForGroup(int compositeValue, int group) const;
@@ -253,6 +387,12 @@ public:
 
 	std::vector<const StudioMesh*> ComputeMeshList(const int texture) const;
 
+	/**
+	*	@brief Converts all textures to RGBA so CreateTextures only has to upload them.
+	*	Does not use OpenGL so this can be called on a worker thread while loading.
+	*/
+	void PrepareTextures();
+
 	void CreateTextures(graphics::TextureLoader& textureLoader);
 
 	/**
@@ -305,6 +445,17 @@ public:
 
 		return {};
 	}
+
+private:
+	static std::uint64_t NextEditGeneration();
+
+	/**
+	*	@brief Gets the palette to upload a texture with, with the top and bottom colors applied
+	*/
+	graphics::RGBPalette GetTexturePalette(const StudioTexture& texture) const;
+
+private:
+	std::uint64_t _editGeneration = NextEditGeneration();
 };
 
 struct RotateBoneData
@@ -333,6 +484,15 @@ std::vector<std::pair<glm::vec3, glm::vec3>> GetScaleSequenceBBoxesData(const Ed
 void ApplyScaleSequenceBBoxesData(EditableStudioModel& studioModel,
 	const std::vector<std::pair<glm::vec3, glm::vec3>>& data, std::optional<float> scale);
 
+/**
+*	@brief Computes the bounding box of each sequence by transforming every vertex by every frame of the sequence.
+*	Multi-blend sequences are evaluated at the start, middle and end of each blend axis.
+*	Controllers are left at their default values.
+*	@return Bounds in the same format as ::GetScaleSequenceBBoxesData.
+*		Sequences are left unchanged if the model has no vertices.
+*/
+std::vector<std::pair<glm::vec3, glm::vec3>> ComputeSequenceBBoxes(const EditableStudioModel& studioModel);
+
 struct ScaleBonesBoneData
 {
 	glm::vec3 Position;
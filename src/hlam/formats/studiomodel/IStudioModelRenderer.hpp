@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cstddef>
+
 #include <glm/vec3.hpp>
 
 #include "formats/DrawConstants.hpp"
 
 #include "formats/studiomodel/ModelRenderInfo.hpp"
 
+#include "graphics/FrameStatistics.hpp"
+
 namespace graphics
 {
 struct Light;
@@ -42,6 +46,11 @@ public:
 	*/
 	virtual unsigned int GetDrawnPolygonsCount() const = 0;
 
+	/**
+	*	@return Totals of the work done by the renderer since it was created.
+	*/
+	virtual const graphics::RendererStatistics& GetStatistics() const = 0;
+
 	/**
 	*	@return The current lambert value. Modifier for pseudo-hemispherical lighting.
 	*/
@@ -73,6 +82,27 @@ public:
 
 	virtual void SetSkyLight(const graphics::Light& light) = 0;
 
+	/**
+	*	@return The memory budget for decoded animations, in bytes.
+	*/
+	virtual std::size_t GetDecodedAnimationCacheBudget() const = 0;
+
+	/**
+	*	Sets the memory budget for decoded animations, in bytes. 0 disables the cache.
+	*/
+	virtual void SetDecodedAnimationCacheBudget(std::size_t budgetInBytes) = 0;
+
+	/**
+	*	@return Whether models should be transformed and lit in a vertex shader when supported.
+	*/
+	virtual bool IsGpuSkinningEnabled() const = 0;
+
+	/**
+	*	Sets whether models should be transformed and lit in a vertex shader.
+	*	The renderer falls back to transforming models on the CPU if shaders are not supported.
+	*/
+	virtual void SetGpuSkinningEnabled(bool enabled) = 0;
+
 	/**
 	*	Draws the given model.
 	*	@param renderInfo Render info that describes the model.
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstddef>
+
+#include <glm/geometric.hpp>
+#include <glm/vec4.hpp>
+
+#include "formats/studiomodel/SkinningKernels.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HLAM_SKINNING_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+//Double to float conversion
+#pragma warning( disable: 4244 )
+
+namespace studiomdl
+{
+namespace
+{
+template<bool Translate>
+void TransformRuns(std::span<const StudioModelVertexInfo> vertices, const glm::mat4x4* boneTransforms, glm::vec3* results)
+{
+	std::size_t i = 0;
+
+	while (i < vertices.size())
+	{
+		const auto bone = vertices[i].Bone;
+		const auto& transform = boneTransforms[bone->ArrayIndex];
+
+#ifdef HLAM_SKINNING_KERNELS_SSE2
+		const __m128 column0 = _mm_loadu_ps(&transform[0].x);
+		const __m128 column1 = _mm_loadu_ps(&transform[1].x);
+		const __m128 column2 = _mm_loadu_ps(&transform[2].x);
+		const __m128 column3 = Translate ? _mm_loadu_ps(&transform[3].x) : _mm_setr_ps(0, 0, 0, 1);
+
+		alignas(16) float result[4];
+
+		// Same order of operations as glm's matrix * vector.
+		for (; i < vertices.size() && vertices[i].Bone == bone; ++i)
+		{
+			const auto& vertex = vertices[i].Vertex;
+
+			_mm_store_ps(result, _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(column0, _mm_set1_ps(vertex.x)), _mm_mul_ps(column1, _mm_set1_ps(vertex.y))),
+				_mm_add_ps(_mm_mul_ps(column2, _mm_set1_ps(vertex.z)), column3)));
+
+			results[i] = glm::vec3{result[0], result[1], result[2]};
+		}
+#else
+		auto matrix = transform;
+
+		if constexpr (!Translate)
+		{
+			matrix[3] = glm::vec4{0, 0, 0, 1};
+		}
+
+		for (; i < vertices.size() && vertices[i].Bone == bone; ++i)
+		{
+			results[i] = matrix * glm::vec4{vertices[i].Vertex, 1};
+		}
+#endif
+	}
+}
+
+float FinishLighting(float illum)
+{
+	if (illum > 1.0f)
+	{
+		return illum * (1.0f / illum);
+	}
+
+	return illum;
+}
+}
+
+void TransformVertices(std::span<const StudioModelVertexInfo> vertices, const glm::mat4x4* boneTransforms, glm::vec3* results)
+{
+	TransformRuns<true>(vertices, boneTransforms, results);
+}
+
+void RotateNormals(std::span<const StudioModelVertexInfo> normals, const glm::mat4x4* boneTransforms, glm::vec3* results)
+{
+	TransformRuns<false>(normals, boneTransforms, results);
+}
+
+void CalculateLighting(std::span<const StudioModelVertexInfo> normals, const glm::vec3* boneLightVectors,
+	const SkinningLightingParameters& parameters, int flags, glm::vec3* results)
+{
+	// These don't depend on the normal, so the whole mesh has the same value.
+	if (flags & STUDIO_NF_FULLBRIGHT)
+	{
+		std::fill_n(results, normals.size(), glm::vec3{1, 1, 1});
+		return;
+	}
+
+	if (flags & STUDIO_NF_FLATSHADE)
+	{
+		float illum = parameters.Ambient;
+		illum += 0.8f * parameters.Shade;
+
+		std::fill_n(results, normals.size(), glm::vec3{FinishLighting(illum)} * parameters.Color);
+		return;
+	}
+
+	const float shade = parameters.Shade;
+	const float r = parameters.Lambert;
+	const float unlit = parameters.Ambient + shade;
+	const glm::vec3& color = parameters.Color;
+
+	std::size_t i = 0;
+
+#ifdef HLAM_SKINNING_KERNELS_SSE2
+	const __m128 shade4 = _mm_set1_ps(shade);
+	const __m128 r4 = _mm_set1_ps(r);
+	const __m128 rMinusOne4 = _mm_set1_ps(r - 1.0f);
+	const __m128 unlit4 = _mm_set1_ps(unlit);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	alignas(16) float result[4];
+
+	for (; i + 4 <= normals.size(); i += 4)
+	{
+		const auto& n0 = normals[i].Vertex;
+		const auto& n1 = normals[i + 1].Vertex;
+		const auto& n2 = normals[i + 2].Vertex;
+		const auto& n3 = normals[i + 3].Vertex;
+
+		const auto& l0 = boneLightVectors[normals[i].Bone->ArrayIndex];
+		const auto& l1 = boneLightVectors[normals[i + 1].Bone->ArrayIndex];
+		const auto& l2 = boneLightVectors[normals[i + 2].Bone->ArrayIndex];
+		const auto& l3 = boneLightVectors[normals[i + 3].Bone->ArrayIndex];
+
+		// Same order of operations as glm::dot.
+		const __m128 x = _mm_mul_ps(_mm_setr_ps(n0.x, n1.x, n2.x, n3.x), _mm_setr_ps(l0.x, l1.x, l2.x, l3.x));
+		const __m128 y = _mm_mul_ps(_mm_setr_ps(n0.y, n1.y, n2.y, n3.y), _mm_setr_ps(l0.y, l1.y, l2.y, l3.y));
+		const __m128 z = _mm_mul_ps(_mm_setr_ps(n0.z, n1.z, n2.z, n3.z), _mm_setr_ps(l0.z, l1.z, l2.z, l3.z));
+
+		__m128 lightcos = _mm_min_ps(_mm_add_ps(_mm_add_ps(x, y), z), one);
+
+		lightcos = _mm_div_ps(_mm_add_ps(lightcos, rMinusOne4), r4);
+
+		// Only darken normals facing away from the light.
+		const __m128 facingAway = _mm_cmpgt_ps(lightcos, zero);
+		__m128 illum = _mm_sub_ps(unlit4, _mm_and_ps(facingAway, _mm_mul_ps(lightcos, shade4)));
+
+		illum = _mm_max_ps(illum, zero);
+
+		const __m128 overbright = _mm_cmpgt_ps(illum, one);
+		illum = _mm_or_ps(
+			_mm_and_ps(overbright, _mm_mul_ps(illum, _mm_div_ps(one, illum))),
+			_mm_andnot_ps(overbright, illum));
+
+		_mm_store_ps(result, illum);
+
+		results[i] = glm::vec3{result[0]} * color;
+		results[i + 1] = glm::vec3{result[1]} * color;
+		results[i + 2] = glm::vec3{result[2]} * color;
+		results[i + 3] = glm::vec3{result[3]} * color;
+	}
+#endif
+
+	for (; i < normals.size(); ++i)
+	{
+		auto lightcos = glm::dot(normals[i].Vertex, boneLightVectors[normals[i].Bone->ArrayIndex]); // -1 colinear, 1 opposite
+
+		if (lightcos > 1.0f) lightcos = 1;
+
+		float illum = unlit;
+
+		lightcos = (lightcos + (r - 1.0f)) / r; // do modified hemispherical lighting
+
+		if (lightcos > 0.0f)
+		{
+			illum -= lightcos * shade;
+		}
+
+		if (illum <= 0) illum = 0;
+
+		results[i] = glm::vec3{FinishLighting(illum)} * color;
+	}
+}
+
+void CalculateChrome(std::span<const StudioModelVertexInfo> normals,
+	const glm::vec3* boneChromeRight, const glm::vec3* boneChromeUp, glm::vec2* results)
+{
+	for (std::size_t i = 0; i < normals.size(); ++i)
+	{
+		const auto& normal = normals[i].Vertex;
+		const int bone = normals[i].Bone->ArrayIndex;
+
+		auto& chrome = results[i];
+
+		// calc s coord
+		auto n = glm::dot(normal, boneChromeRight[bone]);
+		chrome[0] = (n + 1.0) * 0.5;
+
+		// calc t coord
+		n = glm::dot(normal, boneChromeUp[bone]);
+		chrome[1] = (n + 1.0) * 0.5;
+	}
+}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <span>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include "formats/studiomodel/EditableStudioModel.hpp"
+
+namespace studiomdl
+{
+/**
+*	@brief Lighting values shared by every normal in a model, computed once per draw
+*/
+struct SkinningLightingParameters
+{
+	float Ambient{};
+	float Shade{};
+
+	//Lambert value, clamped to at least 1
+	float Lambert{};
+
+	//Light color, applied to everything except fullbright meshes
+	glm::vec3 Color{1};
+};
+
+/**
+*	@brief Transforms @p vertices by their bone's transform.
+*	Vertices are stored grouped by bone, so each run of vertices that share a bone is transformed with a single matrix load.
+*	Uses SSE2 when available. Results are identical to multiplying each vertex by its bone's matrix with glm.
+*/
+void TransformVertices(std::span<const StudioModelVertexInfo> vertices, const glm::mat4x4* boneTransforms, glm::vec3* results);
+
+/**
+*	@brief Rotates @p normals by their bone's transform, ignoring its translation.
+*/
+void RotateNormals(std::span<const StudioModelVertexInfo> normals, const glm::mat4x4* boneTransforms, glm::vec3* results);
+
+/**
+*	@brief Calculates the light value of each normal in a mesh, using the mesh's texture flags.
+*	@param boneLightVectors Light direction in each bone's reference frame.
+*/
+void CalculateLighting(std::span<const StudioModelVertexInfo> normals, const glm::vec3* boneLightVectors,
+	const SkinningLightingParameters& parameters, int flags, glm::vec3* results);
+
+/**
+*	@brief Calculates chrome texture coordinates for each normal in a mesh.
+*	@param boneChromeRight Chrome s vector in each bone's reference frame.
+*	@param boneChromeUp Chrome t vector in each bone's reference frame.
+*/
+void CalculateChrome(std::span<const StudioModelVertexInfo> normals,
+	const glm::vec3* boneChromeRight, const glm::vec3* boneChromeUp, glm::vec2* results);
+}
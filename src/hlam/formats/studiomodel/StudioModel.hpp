@@ -6,18 +6,39 @@
 
 #include "formats/studiomodel/StudioModelFileFormat.hpp"
 
+#include "utility/IOUtils.hpp"
+
 namespace studiomdl
 {
 struct StudioDataDeleter
 {
+	/**
+	*	@brief If non-zero the data is a read-only file mapping of this size, otherwise it was allocated using new[].
+	*/
+	std::size_t MappedSizeInBytes{};
+
 	void operator()(studiohdr_t* pointer) const
 	{
-		delete[] pointer;
+		Release(pointer);
 	}
 
 	void operator()(studioseqhdr_t* pointer) const
 	{
-		delete[] pointer;
+		Release(pointer);
+	}
+
+private:
+	template<typename T>
+	void Release(T* pointer) const
+	{
+		if (MappedSizeInBytes > 0)
+		{
+			UnmapFileFromMemory(reinterpret_cast<const std::byte*>(pointer), MappedSizeInBytes);
+		}
+		else
+		{
+			delete[] pointer;
+		}
 	}
 };
 
@@ -26,8 +47,8 @@ struct StudioPtr
 {
 	constexpr StudioPtr() noexcept = default;
 
-	explicit constexpr StudioPtr(T* data, std::size_t sizeInBytes) noexcept
-		: Header(data)
+	explicit constexpr StudioPtr(T* data, std::size_t sizeInBytes, StudioDataDeleter deleter = {}) noexcept
+		: Header(data, deleter)
 		, SizeInBytes(sizeInBytes)
 	{
 	}
@@ -40,6 +61,14 @@ struct StudioPtr
 		return Header.get();
 	}
 
+	/**
+	*	@brief Whether the data is backed by a read-only file mapping. Mapped data must never be written to.
+	*/
+	bool IsMemoryMapped() const noexcept
+	{
+		return Header.get_deleter().MappedSizeInBytes > 0;
+	}
+
 	constexpr operator bool() const noexcept
 	{
 		return !!Header;
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <deque>
+#include <future>
 #include <iterator>
 
 #include <fmt/format.h>
@@ -12,6 +15,7 @@
 #include "formats/studiomodel/StudioModelIO.hpp"
 
 #include "utility/IOUtils.hpp"
+#include "utility/Profiling.hpp"
 
 namespace studiomdl
 {
@@ -74,17 +78,29 @@ bool IsMainStudioModel(FILE* file)
 	return boneindex > 0;
 }
 
-static std::tuple<std::unique_ptr<std::byte[]>, size_t> ReadStudioFileIntoBuffer(
-	const std::filesystem::path& fileName, FILE* file)
+/**
+*	@brief Loads the contents of a studio model file.
+*	If requested the file is memory mapped to avoid copying its contents, otherwise it is read into a buffer.
+*/
+template<typename T>
+static StudioPtr<T> ReadStudioFile(const std::filesystem::path& fileName, FILE* file, bool memoryMap)
 {
-	auto result = ReadFileIntoBuffer(file);
+	if (memoryMap)
+	{
+		if (auto [data, size] = MapFileIntoMemory(file); data)
+		{
+			return StudioPtr<T>(reinterpret_cast<T*>(const_cast<std::byte*>(data)), size, StudioDataDeleter{size});
+		}
+	}
 
-	if (!std::get<0>(result))
+	auto [buffer, size] = ReadFileIntoBuffer(file);
+
+	if (!buffer)
 	{
 		throw AssetException(fmt::format("Error reading file \"{}\"", fileName));
 	}
 
-	return result;
+	return StudioPtr<T>(reinterpret_cast<T*>(buffer.release()), size);
 }
 
 template<typename T>
@@ -102,17 +118,12 @@ static void CheckHeaderIntegrity(const std::filesystem::path& fileName, const T*
 	}
 }
 
-static studiomdl::StudioPtr<studiohdr_t> LoadMainHeader(const std::filesystem::path& fileName, FILE* mainFile)
+static studiomdl::StudioPtr<studiohdr_t> LoadMainHeader(
+	const std::filesystem::path& fileName, FILE* mainFile, bool memoryMap)
 {
-	auto [buffer, size] = ReadStudioFileIntoBuffer(fileName, mainFile);
-
-	auto header = reinterpret_cast<studiohdr_t*>(buffer.get());
-
-	CheckHeaderIntegrity(fileName, header, STUDIOMDL_HDR_ID);
-
-	buffer.release();
+	auto mainHeader = ReadStudioFile<studiohdr_t>(fileName, mainFile, memoryMap);
 
-	StudioPtr<studiohdr_t> mainHeader(header, size);
+	CheckHeaderIntegrity(fileName, mainHeader.get(), STUDIOMDL_HDR_ID);
 
 	if (mainHeader->name[0] == '\0')
 	{
@@ -132,7 +143,7 @@ static studiomdl::StudioPtr<studiohdr_t> LoadMainHeader(const std::filesystem::p
 }
 
 static studiomdl::StudioPtr<studiohdr_t> LoadTextureHeader(
-	const std::filesystem::path& fileName, studiohdr_t* mainHeader, IFileSystem& fileSystem)
+	const std::filesystem::path& fileName, studiohdr_t* mainHeader, IFileSystem& fileSystem, bool memoryMap)
 {
 	// preload textures
 	// The original model viewer code used numtextures here, whereas the engine uses textureindex.
@@ -154,18 +165,15 @@ static studiomdl::StudioPtr<studiohdr_t> LoadTextureHeader(
 			"External texture file \"{}\" does not exist or is currently opened by another program", texturename));
 	}
 
-	auto [buffer, size] = ReadStudioFileIntoBuffer(fileName, file.get());
+	auto header = ReadStudioFile<studiohdr_t>(fileName, file.get(), memoryMap);
 
-	auto header = reinterpret_cast<studiohdr_t*>(buffer.get());
+	CheckHeaderIntegrity(fileName, header.get(), STUDIOMDL_HDR_ID);
 
-	CheckHeaderIntegrity(fileName, header, STUDIOMDL_HDR_ID);
-
-	buffer.release();
-
-	return StudioPtr<studiohdr_t>(header, size);
+	return header;
 }
 
-static StudioPtr<studioseqhdr_t> LoadSequenceGroup(const std::filesystem::path& fileName, IFileSystem& fileSystem)
+static StudioPtr<studioseqhdr_t> LoadSequenceGroup(
+	const std::filesystem::path& fileName, IFileSystem& fileSystem, bool memoryMap)
 {
 	FilePtr file{ fileSystem.TryOpenAbsolute(reinterpret_cast<const char*>(fileName.u8string().c_str()), true, true) };
 
@@ -175,19 +183,33 @@ static StudioPtr<studioseqhdr_t> LoadSequenceGroup(const std::filesystem::path&
 			"Sequence group file \"{}\" does not exist or is currently opened by another program", fileName));
 	}
 
-	auto [buffer, size] = ReadStudioFileIntoBuffer(fileName, file.get());
+	auto header = ReadStudioFile<studioseqhdr_t>(fileName, file.get(), memoryMap);
 
-	auto header = reinterpret_cast<studioseqhdr_t*>(buffer.get());
+	CheckHeaderIntegrity(fileName, header.get(), STUDIOMDL_SEQ_ID);
 
-	CheckHeaderIntegrity(fileName, header, STUDIOMDL_SEQ_ID);
+	return header;
+}
 
-	buffer.release();
+/**
+*	@brief Number of files a model consists of for progress reporting.
+*	The texture file is always counted so the total is known before it is loaded.
+*/
+static int GetModelFileCount(const studiohdr_t* mainHeader)
+{
+	return 2 + std::max(0, mainHeader->numseqgroups - 1);
+}
 
-	return StudioPtr<studioseqhdr_t>(header, size);
+static void ReportFilesLoaded(AssetLoadProgress* progress, int loadedFileCount, int fileCount)
+{
+	if (progress)
+	{
+		progress->SetStepProgress(static_cast<float>(loadedFileCount) / fileCount);
+		progress->ThrowIfCancelled();
+	}
 }
 
-static std::vector<StudioPtr<studioseqhdr_t>> LoadSequenceGroups(
-	const std::filesystem::path& fileName, studiohdr_t* mainHeader, IFileSystem& fileSystem)
+static std::vector<StudioPtr<studioseqhdr_t>> LoadSequenceGroups(const std::filesystem::path& fileName,
+	studiohdr_t* mainHeader, IFileSystem& fileSystem, bool memoryMap, AssetLoadProgress* progress)
 {
 	// preload animations
 	if (mainHeader->numseqgroups <= 1)
@@ -202,29 +224,69 @@ static std::vector<StudioPtr<studioseqhdr_t>> LoadSequenceGroups(
 	const std::string baseFileName = reinterpret_cast<const char*>(fileName.stem().u8string().c_str());
 	const std::string extension = reinterpret_cast<const char*>(fileName.extension().u8string().c_str());
 
-	std::filesystem::path groupFileName = fileName;
-
 	std::string seqgroupname;
 
+	// Files are loaded concurrently to hide I/O latency, but results are collected in order
+	// so the first group that fails to load is always the one that gets reported.
+	std::deque<std::future<StudioPtr<studioseqhdr_t>>> pendingLoads;
+
+	const int fileCount = GetModelFileCount(mainHeader);
+
+	// The main and texture files have already been loaded.
+	const auto collectLoad = [&]
+	{
+		sequenceHeaders.emplace_back(pendingLoads.front().get());
+		pendingLoads.pop_front();
+
+		ReportFilesLoaded(progress, 2 + static_cast<int>(sequenceHeaders.size()), fileCount);
+	};
+
 	for (int i = 1; i < mainHeader->numseqgroups; ++i)
 	{
+		if (pendingLoads.size() >= MaxConcurrentSequenceGroupTasks)
+		{
+			collectLoad();
+		}
+
 		seqgroupname.clear();
 		fmt::format_to(std::back_inserter(seqgroupname), "{}{:0>2}{}", baseFileName, i, extension);
 
+		std::filesystem::path groupFileName = fileName;
+
 		groupFileName.replace_filename(seqgroupname);
 
-		sequenceHeaders.emplace_back(LoadSequenceGroup(groupFileName, fileSystem));
+		pendingLoads.push_back(std::async(std::launch::async, [groupFileName = std::move(groupFileName), &fileSystem, memoryMap]()
+			{
+				return LoadSequenceGroup(groupFileName, fileSystem, memoryMap);
+			}));
+	}
+
+	while (!pendingLoads.empty())
+	{
+		collectLoad();
 	}
 
 	return sequenceHeaders;
 }
 
 std::unique_ptr<StudioModel> LoadStudioModel(
-	const std::filesystem::path& fileName, FILE* mainFile, IFileSystem& fileSystem)
+	const std::filesystem::path& fileName, FILE* mainFile, IFileSystem& fileSystem, bool memoryMap,
+	AssetLoadProgress* progress)
 {
-	StudioPtr<studiohdr_t> mainHeader = LoadMainHeader(fileName, mainFile);
-	StudioPtr<studiohdr_t> textureHeader = LoadTextureHeader(fileName, mainHeader.get(), fileSystem);
-	std::vector<StudioPtr<studioseqhdr_t>> sequenceHeaders = LoadSequenceGroups(fileName, mainHeader.get(), fileSystem);
+	HLAM_PROFILE_SCOPE("LoadStudioModel");
+
+	StudioPtr<studiohdr_t> mainHeader = LoadMainHeader(fileName, mainFile, memoryMap);
+
+	const int fileCount = GetModelFileCount(mainHeader.get());
+
+	ReportFilesLoaded(progress, 1, fileCount);
+
+	StudioPtr<studiohdr_t> textureHeader = LoadTextureHeader(fileName, mainHeader.get(), fileSystem, memoryMap);
+
+	ReportFilesLoaded(progress, 2, fileCount);
+
+	std::vector<StudioPtr<studioseqhdr_t>> sequenceHeaders = LoadSequenceGroups(
+		fileName, mainHeader.get(), fileSystem, memoryMap, progress);
 	const auto isDol = fileName.extension() == ".dol";
 
 	return std::make_unique<StudioModel>(std::move(mainHeader), std::move(textureHeader),
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdio>
 #include <filesystem>
 #include <memory>
@@ -12,6 +13,11 @@ namespace studiomdl
 {
 class StudioModel;
 
+/**
+*	@brief Maximum number of sequence groups that are loaded or converted at the same time.
+*/
+constexpr std::size_t MaxConcurrentSequenceGroupTasks = 16;
+
 bool IsStudioModel(FILE* file);
 
 bool IsMainStudioModel(FILE* file);
@@ -21,13 +27,20 @@ bool IsMainStudioModel(FILE* file);
 *	@param fileName Name of the model to load. This is the entire path, including the extension
 *	@param mainFile Handle to the main file
 *	@param fileSystem File system used to load files
+*	@param memoryMap Whether to memory map the files instead of reading them into memory.
+*		Mapped files cannot be modified by other programs on some platforms as long as the model exists,
+*		so only use this for models that are discarded after conversion.
+*	@param progress If not null, receives the progress of the current step as each file is loaded
+*		and is checked for cancellation between files
 *	@exception assets::AssetException If a file could not be found,
 *		If a file has an invalid format
 *		If a file has the wrong studio version
 *		If the filename specifies a studio model file that is not the main file
+*	@exception AssetLoadCancelledException If loading was cancelled through @p progress
 */
 std::unique_ptr<StudioModel> LoadStudioModel(
-	const std::filesystem::path& fileName, FILE* mainFile, IFileSystem& fileSystem);
+	const std::filesystem::path& fileName, FILE* mainFile, IFileSystem& fileSystem, bool memoryMap = true,
+	AssetLoadProgress* progress = nullptr);
 
 /**
 *	Saves a studio model.
@@ -8,25 +8,30 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "formats/studiomodel/EditableStudioModel.hpp"
+#include "formats/studiomodel/SkinningKernels.hpp"
 #include "formats/studiomodel/StudioModelRenderer.hpp"
 
 #include "graphics/GraphicsUtils.hpp"
 #include "graphics/OpenGL.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 
 #include "settings/ColorSettings.hpp"
 
 #include "plugins/halflife/studiomodel/StudioModelColors.hpp"
 
 #include "utility/mathlib.hpp"
+#include "utility/Profiling.hpp"
 
 //Double to float conversion
 #pragma warning( disable: 4244 )
 
 namespace studiomdl
 {
-StudioModelRenderer::StudioModelRenderer(const std::shared_ptr<spdlog::logger>& logger, QOpenGLFunctions_1_1* openglFunctions, ColorSettings* colorSettings)
+StudioModelRenderer::StudioModelRenderer(const std::shared_ptr<spdlog::logger>& logger,
+	QOpenGLFunctions_1_1* openglFunctions, graphics::OpenGLStateCache* stateCache, ColorSettings* colorSettings)
 	: _logger(logger)
 	, _openglFunctions(openglFunctions)
+	, _stateCache(stateCache)
 	, _colorSettings(colorSettings)
 {
 	// Initialize them now so the colors don't flicker for the first fraction of a second.
@@ -75,6 +80,16 @@ unsigned int StudioModelRenderer::DrawModel(studiomdl::ModelRenderInfo& renderIn
 
 	SetupLighting();
 
+	_useGpuSkinning = SetUpGpuSkinning();
+
+	// Skinned body parts are shared by every pass in this call, but depend on this call's pose and lighting.
+	_skinnedBodyparts.resize(_studioModel->Bodyparts.size());
+
+	for (auto& skinned : _skinnedBodyparts)
+	{
+		skinned.Invalidate();
+	}
+
 	unsigned int uiDrawnPolys = 0;
 
 	const bool fixShadowZFighting = (flags & renderer::DrawFlag::FIX_SHADOW_Z_FIGHTING) != 0;
@@ -99,10 +114,10 @@ unsigned int StudioModelRenderer::DrawModel(studiomdl::ModelRenderInfo& renderIn
 	if (flags & renderer::DrawFlag::WIREFRAME_OVERLAY)
 	{
 		//TODO: restore render mode after this?
-		_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		_openglFunctions->glDisable(GL_TEXTURE_2D);
-		_openglFunctions->glDisable(GL_CULL_FACE);
-		_openglFunctions->glEnable(GL_DEPTH_TEST);
+		_stateCache->PolygonMode(GL_LINE);
+		_stateCache->Disable(GL_TEXTURE_2D);
+		_stateCache->Disable(GL_CULL_FACE);
+		_stateCache->Enable(GL_DEPTH_TEST);
 
 		for (int i = 0; i < _studioModel->Bodyparts.size(); i++)
 		{
@@ -167,8 +182,8 @@ void StudioModelRenderer::DrawSingleBone(ModelRenderInfo& renderInfo, const int
 
 	SetUpBones();
 
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Disable(GL_DEPTH_TEST);
 
 	const auto& bone = *model->Bones[iBone];
 
@@ -186,6 +201,7 @@ void StudioModelRenderer::DrawSingleBone(ModelRenderInfo& renderInfo, const int
 		_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 		_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 		_openglFunctions->glEnd();
+		_stateCache->CountDrawCall(2);
 
 		_openglFunctions->glColor3f(0, 0, 0.8f);
 		_openglFunctions->glBegin(GL_POINTS);
@@ -193,6 +209,7 @@ void StudioModelRenderer::DrawSingleBone(ModelRenderInfo& renderInfo, const int
 			_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 		_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 		_openglFunctions->glEnd();
+		_stateCache->CountDrawCall(parentBone.Parent ? 2 : 1);
 	}
 	else
 	{
@@ -202,6 +219,7 @@ void StudioModelRenderer::DrawSingleBone(ModelRenderInfo& renderInfo, const int
 		_openglFunctions->glBegin(GL_POINTS);
 		_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 		_openglFunctions->glEnd();
+		_stateCache->CountDrawCall(1);
 	}
 
 	_openglFunctions->glPointSize(1.0f);
@@ -225,9 +243,9 @@ void StudioModelRenderer::DrawSingleAttachment(ModelRenderInfo& renderInfo, cons
 
 	SetUpBones();
 
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Disable(GL_CULL_FACE);
+	_stateCache->Disable(GL_DEPTH_TEST);
 
 	const auto& attachment = *_studioModel->Attachments[iAttachment];
 
@@ -254,12 +272,14 @@ void StudioModelRenderer::DrawSingleAttachment(ModelRenderInfo& renderInfo, cons
 	_openglFunctions->glColor3f(1, 1, 1);
 	_openglFunctions->glVertex3fv(glm::value_ptr(v[3]));
 	_openglFunctions->glEnd();
+	_stateCache->CountDrawCall(6);
 
 	_openglFunctions->glPointSize(10);
 	_openglFunctions->glColor3f(0, 1, 0);
 	_openglFunctions->glBegin(GL_POINTS);
 	_openglFunctions->glVertex3fv(glm::value_ptr(v[0]));
 	_openglFunctions->glEnd();
+	_stateCache->CountDrawCall(1);
 	_openglFunctions->glPointSize(1);
 
 	_studioModel = nullptr;
@@ -281,16 +301,16 @@ void StudioModelRenderer::DrawSingleHitbox(ModelRenderInfo& renderInfo, const in
 
 	SetUpBones();
 
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Disable(GL_CULL_FACE);
 	if (_renderInfo->Transparency < 1.0f)
-		_openglFunctions->glDisable(GL_DEPTH_TEST);
+		_stateCache->Disable(GL_DEPTH_TEST);
 	else
-		_openglFunctions->glEnable(GL_DEPTH_TEST);
+		_stateCache->Enable(GL_DEPTH_TEST);
 
-	_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	_openglFunctions->glEnable(GL_BLEND);
-	_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	_stateCache->PolygonMode(GL_LINE);
+	_stateCache->Enable(GL_BLEND);
+	_stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	const auto& hitbox = *_studioModel->Hitboxes[hitboxIndex];
 
@@ -305,7 +325,7 @@ void StudioModelRenderer::DrawSingleHitbox(ModelRenderInfo& renderInfo, const in
 		v2[i] = hitboxBoneTransform * glm::vec4{v[i], 1};
 	}
 
-	graphics::DrawOutlinedBox(_openglFunctions, v2,
+	graphics::DrawOutlinedBox(_openglFunctions, _stateCache, v2,
 		_colorSettings->GetColor(studiomodel::SingleHitboxFaceColor),
 		_colorSettings->GetColor(studiomodel::SingleHitboxEdgeColor));
 
@@ -329,8 +349,8 @@ void StudioModelRenderer::SetupPosition(const glm::vec3& origin, const glm::vec3
 
 void StudioModelRenderer::DrawBones()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Disable(GL_DEPTH_TEST);
 
 	for (int i = 0; i < _studioModel->Bones.size(); i++)
 	{
@@ -348,6 +368,7 @@ void StudioModelRenderer::DrawBones()
 			_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 			_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 			_openglFunctions->glEnd();
+			_stateCache->CountDrawCall(2);
 
 			_openglFunctions->glColor3f(0, 0, 0.8f);
 			_openglFunctions->glBegin(GL_POINTS);
@@ -355,6 +376,7 @@ void StudioModelRenderer::DrawBones()
 				_openglFunctions->glVertex3fv(glm::value_ptr(parentBoneTransform[3]));
 			_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 			_openglFunctions->glEnd();
+			_stateCache->CountDrawCall(bone.Parent->Parent ? 2 : 1);
 		}
 		else
 		{
@@ -364,6 +386,7 @@ void StudioModelRenderer::DrawBones()
 			_openglFunctions->glBegin(GL_POINTS);
 			_openglFunctions->glVertex3fv(glm::value_ptr(boneTransform[3]));
 			_openglFunctions->glEnd();
+			_stateCache->CountDrawCall(1);
 		}
 	}
 
@@ -372,9 +395,9 @@ void StudioModelRenderer::DrawBones()
 
 void StudioModelRenderer::DrawAttachments()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Disable(GL_CULL_FACE);
+	_stateCache->Disable(GL_DEPTH_TEST);
 
 	for (int i = 0; i < _studioModel->Attachments.size(); i++)
 	{
@@ -403,42 +426,45 @@ void StudioModelRenderer::DrawAttachments()
 		_openglFunctions->glColor3f(1, 1, 1);
 		_openglFunctions->glVertex3fv(glm::value_ptr(v[3]));
 		_openglFunctions->glEnd();
+		_stateCache->CountDrawCall(6);
 
 		_openglFunctions->glPointSize(5);
 		_openglFunctions->glColor3f(0, 1, 0);
 		_openglFunctions->glBegin(GL_POINTS);
 		_openglFunctions->glVertex3fv(glm::value_ptr(v[0]));
 		_openglFunctions->glEnd();
+		_stateCache->CountDrawCall(1);
 		_openglFunctions->glPointSize(1);
 	}
 }
 
 void StudioModelRenderer::DrawEyePosition()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
-	_openglFunctions->glDisable(GL_DEPTH_TEST);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Disable(GL_CULL_FACE);
+	_stateCache->Disable(GL_DEPTH_TEST);
 
 	_openglFunctions->glPointSize(7);
 	_openglFunctions->glColor3f(1, 0, 1);
 	_openglFunctions->glBegin(GL_POINTS);
 	_openglFunctions->glVertex3fv(glm::value_ptr(_studioModel->EyePosition));
 	_openglFunctions->glEnd();
+	_stateCache->CountDrawCall(1);
 	_openglFunctions->glPointSize(1);
 }
 
 void StudioModelRenderer::DrawHitBoxes()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glDisable(GL_CULL_FACE);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Disable(GL_CULL_FACE);
 	if (_renderInfo->Transparency < 1.0f)
-		_openglFunctions->glDisable(GL_DEPTH_TEST);
+		_stateCache->Disable(GL_DEPTH_TEST);
 	else
-		_openglFunctions->glEnable(GL_DEPTH_TEST);
+		_stateCache->Enable(GL_DEPTH_TEST);
 
-	_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-	_openglFunctions->glEnable(GL_BLEND);
-	_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	_stateCache->PolygonMode(GL_LINE);
+	_stateCache->Enable(GL_BLEND);
+	_stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	const glm::vec4 faceColor = _colorSettings->GetColor(studiomodel::HitboxFaceColor);
 	const glm::vec4 edgeColor = _colorSettings->GetColor(studiomodel::HitboxEdgeColor);
@@ -458,66 +484,75 @@ void StudioModelRenderer::DrawHitBoxes()
 			v2[i] = hitboxTransform * glm::vec4{v[i], 1};
 		}
 
-		graphics::DrawOutlinedBox(_openglFunctions, v2, faceColor, edgeColor);
+		graphics::DrawOutlinedBox(_openglFunctions, _stateCache, v2, faceColor, edgeColor);
 	}
 }
 
 void StudioModelRenderer::DrawNormals()
 {
-	_openglFunctions->glDisable(GL_TEXTURE_2D);
-	_openglFunctions->glEnable(GL_DEPTH_TEST);
+	_stateCache->Disable(GL_TEXTURE_2D);
+	_stateCache->Enable(GL_DEPTH_TEST);
 
 	_openglFunctions->glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	_openglFunctions->glBegin(GL_LINES);
+
+	_drawLines.clear();
 
 	for (int iBodyPart = 0; iBodyPart < _studioModel->Bodyparts.size(); ++iBodyPart)
 	{
 		SetupModel(iBodyPart);
 
-		for (int i = 0; i < _model->Vertices.size(); i++)
-		{
-			_xformverts[i] = _bonetransform[_model->Vertices[i].Bone->ArrayIndex] * glm::vec4{_model->Vertices[i].Vertex, 1};
-		}
+		SkinVertices();
+		SkinNormals();
 
-		for (int i = 0; i < _model->Normals.size(); i++)
-		{
-			auto matrix = _bonetransform[_model->Normals[i].Bone->ArrayIndex];
-			matrix[3] = glm::vec4{0, 0, 0, 1};
-			_xformnorms[i] = matrix * glm::vec4{_model->Normals[i].Vertex, 1};
-		}
+		const auto& vertices = _skinned->Vertices;
+		const auto& normals = _skinned->Normals;
 
-		for (int j = 0; j < _model->Meshes.size(); j++)
+		for (const auto& mesh : _model->Meshes)
 		{
-			const auto& mesh = _model->Meshes[j];
-			auto ptricmds = mesh.Triangles.data();
-
-			int i;
-
-			while (i = *(ptricmds++))
+			for (const auto& meshVertex : mesh.CookedVertices)
 			{
-				if (i < 0)
-				{
-					i = -i;
-				}
+				const auto& vertex = vertices[meshVertex.VertexIndex];
 
-				for (; i > 0; --i, ptricmds += 4)
-				{
-					const auto& vertex = _xformverts[ptricmds[0]];
-
-					const auto absoluteNormalEnd = vertex + _xformnorms[ptricmds[1]];
-
-					_openglFunctions->glVertex3fv(glm::value_ptr(vertex));
-					_openglFunctions->glVertex3fv(glm::value_ptr(absoluteNormalEnd));
-				}
+				_drawLines.push_back(vertex);
+				_drawLines.push_back(vertex + normals[meshVertex.NormalIndex]);
 			}
 		}
 	}
 
-	_openglFunctions->glEnd();
+	if (!_drawLines.empty())
+	{
+		_stateCache->EnableClientState(GL_VERTEX_ARRAY);
+		_openglFunctions->glVertexPointer(3, GL_FLOAT, sizeof(glm::vec3), _drawLines.data());
+		_openglFunctions->glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(_drawLines.size()));
+		_stateCache->CountDrawCall(_drawLines.size());
+		_stateCache->DisableClientState(GL_VERTEX_ARRAY);
+	}
 }
 
 void StudioModelRenderer::SetUpBones()
 {
+	const PoseKey pose
+	{
+		_studioModel,
+		_studioModel->GetEditGeneration(),
+		_renderInfo->Sequence,
+		_renderInfo->Frame,
+		_renderInfo->Scale,
+		_renderInfo->Blender,
+		_renderInfo->Controller,
+		_renderInfo->Mouth
+	};
+
+	// Reuse the last pose if nothing that affects it has changed since.
+	if (_bonetransform && _lastPose == pose)
+	{
+		return;
+	}
+
+	_lastPose = pose;
+
+	++_statistics.BoneSetups;
+
 	_bonetransform = _boneTransformer.SetUpBones(*_studioModel,
 		{
 			_renderInfo->Sequence,
@@ -531,6 +566,11 @@ void StudioModelRenderer::SetUpBones()
 
 void StudioModelRenderer::SetupLighting()
 {
+	_lightingParameters.Ambient = std::max(0.1f, (float)_skyLight.Ambient / 255.0f); // to avoid divison by zero
+	_lightingParameters.Shade = _skyLight.Shade / 255.0f;
+	_lightingParameters.Lambert = std::max(_lambert, 1.0f);
+	_lightingParameters.Color = _skyLight.Color;
+
 	for (int i = 0; i < _studioModel->Bones.size(); i++)
 	{
 		auto matrix = _bonetransform[i];
@@ -542,66 +582,132 @@ void StudioModelRenderer::SetupLighting()
 
 void StudioModelRenderer::SetupModel(int bodypart)
 {
-	if (bodypart > _studioModel->Bodyparts.size())
+	if (bodypart >= _studioModel->Bodyparts.size())
 	{
 		// Con_DPrintf ("StudioModelRenderer::SetupModel: no such bodypart %d\n", bodypart);
 		bodypart = 0;
 	}
 
 	_model = _studioModel->GetModelByBodyPart(_renderInfo->Bodygroup, bodypart);
+	_skinned = &_skinnedBodyparts[bodypart];
 }
 
-unsigned int StudioModelRenderer::DrawPoints(const bool bWireframe)
+void StudioModelRenderer::SkinVertices()
 {
-	unsigned int uiDrawnPolys = 0;
+	if (_skinned->HasVertices)
+	{
+		return;
+	}
 
-	//TODO: do this earlier
-	_renderInfo->Skin = std::clamp(_renderInfo->Skin, 0, static_cast<int>(_studioModel->SkinFamilies.size()));
+	_skinned->Vertices.resize(_model->Vertices.size());
+	TransformVertices(_model->Vertices, _bonetransform, _skinned->Vertices.data());
+	_statistics.SkinnedVertices += static_cast<unsigned int>(_model->Vertices.size());
+	_skinned->HasVertices = true;
+}
+
+void StudioModelRenderer::SkinNormals()
+{
+	if (_skinned->HasNormals)
+	{
+		return;
+	}
 
-	for (int i = 0; i < _model->Vertices.size(); i++)
+	_skinned->Normals.resize(_model->Normals.size());
+	RotateNormals(_model->Normals, _bonetransform, _skinned->Normals.data());
+	_skinned->HasNormals = true;
+}
+
+void StudioModelRenderer::LightVertices()
+{
+	if (_skinned->HasLighting)
 	{
-		_xformverts[i] = _bonetransform[_model->Vertices[i].Bone->ArrayIndex] * glm::vec4{_model->Vertices[i].Vertex, 1};
+		return;
 	}
 
-	SortedMesh meshes[MAXSTUDIOMESHES]{};
+	const std::span<const StudioModelVertexInfo> normals{_model->Normals};
 
-	//
-	// clip and draw all triangles
-	//
+	_skinned->LightValues.resize(normals.size());
+	_skinned->Chrome.resize(normals.size());
 
-	auto normals = _model->Normals.data();
+	std::size_t firstNormal = 0;
 
-	glm::vec3* lv = _lightvalues;
-	for (int j = 0; j < _model->Meshes.size(); j++)
+	for (const auto& mesh : _model->Meshes)
 	{
-		const auto& mesh = _model->Meshes[j];
-
 		const int flags = _studioModel->SkinFamilies[_renderInfo->Skin][mesh.SkinRef]->Flags;
 
-		meshes[j].Mesh = &mesh;
-		meshes[j].Flags = flags;
+		const auto meshNormals = normals.subspan(
+			firstNormal, std::min(static_cast<std::size_t>(mesh.NumNorms), normals.size() - firstNormal));
 
-		for (int i = 0; i < mesh.NumNorms; i++, ++lv, ++normals)
-		{
-			Lighting(*lv, normals->Bone->ArrayIndex, flags, normals->Vertex);
+		CalculateLighting(meshNormals, _blightvec, _lightingParameters, flags, _skinned->LightValues.data() + firstNormal);
 
-			// FIX: move this check out of the inner loop
-			if (flags & STUDIO_NF_CHROME)
+		if (flags & STUDIO_NF_CHROME)
+		{
+			for (const auto& normal : meshNormals)
 			{
-				auto& c = _chrome[reinterpret_cast<glm::vec3*>(lv) - _lightvalues];
-
-				Chrome(c, normals->Bone->ArrayIndex, normals->Vertex);
+				UpdateChromeVectors(normal.Bone->ArrayIndex);
 			}
+
+			CalculateChrome(meshNormals, _chromeright, _chromeup, _skinned->Chrome.data() + firstNormal);
 		}
+
+		firstNormal += meshNormals.size();
+	}
+
+	_skinned->HasLighting = true;
+}
+
+void StudioModelRenderer::SortMeshes()
+{
+	if (_skinned->HasSortedMeshes)
+	{
+		return;
+	}
+
+	auto& meshes = _skinned->SortedMeshes;
+
+	meshes.resize(_model->Meshes.size());
+
+	for (int j = 0; j < _model->Meshes.size(); j++)
+	{
+		const auto& mesh = _model->Meshes[j];
+
+		meshes[j].Mesh = &mesh;
+		meshes[j].Flags = _studioModel->SkinFamilies[_renderInfo->Skin][mesh.SkinRef]->Flags;
 	}
 
 	//Sort meshes by render modes so additive meshes are drawn after solid meshes.
 	//Masked meshes are drawn before solid meshes.
-	std::stable_sort(meshes, meshes + _model->Meshes.size(), CompareSortedMeshes);
+	std::stable_sort(meshes.begin(), meshes.end(), CompareSortedMeshes);
+
+	_skinned->HasSortedMeshes = true;
+}
+
+unsigned int StudioModelRenderer::DrawPoints(const bool bWireframe)
+{
+	HLAM_PROFILE_SCOPE("StudioModelRenderer::DrawPoints");
+
+	unsigned int uiDrawnPolys = 0;
+
+	//TODO: do this earlier
+	_renderInfo->Skin = std::clamp(_renderInfo->Skin, 0, static_cast<int>(_studioModel->SkinFamilies.size()));
+
+	// The vertex shader does the transforms and lighting.
+	if (!_useGpuSkinning)
+	{
+		SkinVertices();
+
+		// Wireframe only needs the positions.
+		if (!bWireframe)
+		{
+			LightVertices();
+		}
+	}
 
-	uiDrawnPolys += DrawMeshes(bWireframe, meshes);
+	SortMeshes();
 
-	_openglFunctions->glDepthMask(GL_TRUE);
+	uiDrawnPolys += DrawMeshes(bWireframe, _skinned->SortedMeshes.data());
+
+	_stateCache->DepthMask(GL_TRUE);
 
 	return uiDrawnPolys;
 }
@@ -617,12 +723,19 @@ unsigned int StudioModelRenderer::DrawMeshes(const bool bWireframe, const Sorted
 	unsigned int uiDrawnPolys = 0;
 
 	//Polygons may overlap, so make sure they can blend together.
-	_openglFunctions->glDepthFunc(GL_LEQUAL);
+	_stateCache->DepthFunc(GL_LEQUAL);
+
+	if (_useGpuSkinning)
+	{
+		_skinningProgram->Bind();
+		_skinningProgram->SetMode(bWireframe
+			? StudioModelSkinningProgram::Mode::SolidColor : StudioModelSkinningProgram::Mode::Textured);
+		_skinningProgram->EnableVertexAttributes();
+	}
 
 	for (int j = 0; j < _model->Meshes.size(); j++)
 	{
 		const auto& mesh = *pMeshes[j].Mesh;
-		auto ptricmds = mesh.Triangles.data();
 
 		const auto& texture = *_studioModel->SkinFamilies[_renderInfo->Skin][mesh.SkinRef];
 
@@ -632,123 +745,162 @@ unsigned int StudioModelRenderer::DrawMeshes(const bool bWireframe, const Sorted
 		if (!bWireframe)
 		{
 			if (texture.Flags & STUDIO_NF_ADDITIVE)
-				_openglFunctions->glDepthMask(GL_FALSE);
+				_stateCache->DepthMask(GL_FALSE);
 			else
-				_openglFunctions->glDepthMask(GL_TRUE);
+				_stateCache->DepthMask(GL_TRUE);
 
 			if (texture.Flags & STUDIO_NF_ADDITIVE)
 			{
-				_openglFunctions->glEnable(GL_BLEND);
-				_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+				_stateCache->Enable(GL_BLEND);
+				_stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE);
 			}
 			else if (_renderInfo->Transparency < 1.0f)
 			{
-				_openglFunctions->glEnable(GL_BLEND);
-				_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+				_stateCache->Enable(GL_BLEND);
+				_stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 			}
 			else
 			{
-				_openglFunctions->glDisable(GL_BLEND);
+				_stateCache->Disable(GL_BLEND);
 			}
 
 			if (texture.Flags & STUDIO_NF_MASKED)
 			{
-				_openglFunctions->glEnable(GL_ALPHA_TEST);
-				_openglFunctions->glAlphaFunc(GL_GREATER, 0.5f);
+				_stateCache->Enable(GL_ALPHA_TEST);
+				_stateCache->AlphaFunc(GL_GREATER, 0.5f);
 			}
 
-			_openglFunctions->glBindTexture(GL_TEXTURE_2D, texture.TextureId);
+			_stateCache->BindTexture(texture.TextureId);
 		}
 
-		int i;
-
-		while (i = *(ptricmds++))
+		if (_useGpuSkinning)
 		{
-			if (i < 0)
-			{
-				_openglFunctions->glBegin(GL_TRIANGLE_FAN);
-				i = -i;
-			}
-			else
-			{
-				_openglFunctions->glBegin(GL_TRIANGLE_STRIP);
-			}
-
-			uiDrawnPolys += i - 2;
-
-			for (; i > 0; i--, ptricmds += 4)
-			{
-				if (!bWireframe)
-				{
-					if (texture.Flags & STUDIO_NF_CHROME)
-					{
-						const auto& c = _chrome[ptricmds[1]];
-
-						_openglFunctions->glTexCoord2f(c[0], c[1]);
-					}
-					else
-					{
-						_openglFunctions->glTexCoord2f(ptricmds[2] * s, ptricmds[3] * t);
-					}
-
-					if (texture.Flags & STUDIO_NF_ADDITIVE)
-					{
-						_openglFunctions->glColor4f(1.0f, 1.0f, 1.0f, _renderInfo->Transparency);
-					}
-					else
-					{
-						const glm::vec3& lightVec = _lightvalues[ptricmds[1]];
-						_openglFunctions->glColor4f(lightVec[0], lightVec[1], lightVec[2], _renderInfo->Transparency);
-					}
-				}
-
-				_openglFunctions->glVertex3fv(glm::value_ptr(_xformverts[ptricmds[0]]));
-			}
-			_openglFunctions->glEnd();
+			// Dividing by the size gives the same result as the CPU path, multiplying by a float scale doesn't.
+			uiDrawnPolys += DrawGpuSkinnedMesh(mesh, texture.Flags,
+				glm::vec2{static_cast<float>(texture.Data.Width), static_cast<float>(texture.Data.Height)});
+		}
+		else
+		{
+			uiDrawnPolys += DrawCpuSkinnedMesh(bWireframe, mesh, texture.Flags, s, t);
 		}
 
 		if (!bWireframe)
 		{
 			if (texture.Flags & STUDIO_NF_ADDITIVE)
 			{
-				_openglFunctions->glDisable(GL_BLEND);
+				_stateCache->Disable(GL_BLEND);
 			}
 
 			if (texture.Flags & STUDIO_NF_MASKED)
 			{
-				_openglFunctions->glDisable(GL_ALPHA_TEST);
+				_stateCache->Disable(GL_ALPHA_TEST);
 			}
 		}
 	}
 
+	if (_useGpuSkinning)
+	{
+		_skinningProgram->DisableVertexAttributes();
+		_skinningProgram->Release();
+	}
+
 	return uiDrawnPolys;
 }
 
+unsigned int StudioModelRenderer::DrawCpuSkinnedMesh(
+	const bool bWireframe, const StudioMesh& mesh, const int textureFlags, const double s, const double t)
+{
+	_drawVertices.clear();
+	_drawVertices.reserve(mesh.CookedVertices.size());
+
+	for (const auto& vertex : mesh.CookedVertices)
+	{
+		auto& drawVertex = _drawVertices.emplace_back();
+
+		drawVertex.Position = _skinned->Vertices[vertex.VertexIndex];
+
+		if (bWireframe)
+		{
+			continue;
+		}
+
+		if (textureFlags & STUDIO_NF_CHROME)
+		{
+			drawVertex.TexCoord = _skinned->Chrome[vertex.NormalIndex];
+		}
+		else
+		{
+			drawVertex.TexCoord = glm::vec2{static_cast<float>(vertex.S * s), static_cast<float>(vertex.T * t)};
+		}
+
+		if (textureFlags & STUDIO_NF_ADDITIVE)
+		{
+			drawVertex.Color = glm::vec4{1.0f, 1.0f, 1.0f, _renderInfo->Transparency};
+		}
+		else
+		{
+			drawVertex.Color = glm::vec4{_skinned->LightValues[vertex.NormalIndex], _renderInfo->Transparency};
+		}
+	}
+
+	DrawTriangleList(!bWireframe, mesh.CookedIndices);
+
+	return mesh.CookedIndices.size() / 3;
+}
+
+unsigned int StudioModelRenderer::DrawGpuSkinnedMesh(
+	const StudioMesh& mesh, const int textureFlags, const glm::vec2& textureSize)
+{
+	if (mesh.CookedIndices.empty())
+	{
+		return 0;
+	}
+
+	auto lightingMode = StudioModelSkinningProgram::LightingMode::Shaded;
+
+	if (textureFlags & (STUDIO_NF_ADDITIVE | STUDIO_NF_FULLBRIGHT))
+	{
+		lightingMode = StudioModelSkinningProgram::LightingMode::Unlit;
+	}
+	else if (textureFlags & STUDIO_NF_FLATSHADE)
+	{
+		lightingMode = StudioModelSkinningProgram::LightingMode::FlatShaded;
+	}
+
+	_skinningProgram->SetMesh(lightingMode, (textureFlags & STUDIO_NF_CHROME) != 0, textureSize, _renderInfo->Transparency);
+	_skinningProgram->SetVertices(GetSkinningVertices(mesh).data());
+
+	_openglFunctions->glDrawElements(
+		GL_TRIANGLES, static_cast<GLsizei>(mesh.CookedIndices.size()), GL_UNSIGNED_INT, mesh.CookedIndices.data());
+	_stateCache->CountDrawCall(mesh.CookedIndices.size());
+
+	return mesh.CookedIndices.size() / 3;
+}
+
 unsigned int StudioModelRenderer::DrawShadows(const bool fixZFighting, const bool wireframe)
 {
 	if (!(_studioModel->Flags & EF_NOSHADELIGHT))
 	{
-		GLint oldDepthMask;
-		_openglFunctions->glGetIntegerv(GL_DEPTH_WRITEMASK, &oldDepthMask);
+		const GLboolean oldDepthMask = _stateCache->GetDepthMask();
 
 		if (fixZFighting)
 		{
-			_openglFunctions->glDepthMask(GL_FALSE);
+			_stateCache->DepthMask(GL_FALSE);
 		}
 		else
 		{
-			_openglFunctions->glDepthMask(GL_TRUE);
+			_stateCache->DepthMask(GL_TRUE);
 		}
 
 		const float r_blend = _renderInfo->Transparency;
 
 		const auto alpha = 0.5 * r_blend;
 
-		const GLboolean texture2DWasEnabled = _openglFunctions->glIsEnabled(GL_TEXTURE_2D);
+		const bool texture2DWasEnabled = _stateCache->IsEnabled(GL_TEXTURE_2D);
 
-		_openglFunctions->glDisable(GL_TEXTURE_2D);
-		_openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		_openglFunctions->glEnable(GL_BLEND);
+		_stateCache->Disable(GL_TEXTURE_2D);
+		_stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		_stateCache->Enable(GL_BLEND);
 
 		if (wireframe)
 		{
@@ -760,21 +912,21 @@ unsigned int StudioModelRenderer::DrawShadows(const bool fixZFighting, const boo
 			_openglFunctions->glColor4f(0.f, 0.f, 0.f, alpha);
 		}
 
-		_openglFunctions->glDepthFunc(GL_LESS);
+		_stateCache->DepthFunc(GL_LESS);
 
 		const auto drawnPolys = InternalDrawShadows();
 
-		_openglFunctions->glDepthFunc(GL_LEQUAL);
+		_stateCache->DepthFunc(GL_LEQUAL);
 
 		if (texture2DWasEnabled)
 		{
-			_openglFunctions->glEnable(GL_TEXTURE_2D);
+			_stateCache->Enable(GL_TEXTURE_2D);
 		}
 
-		_openglFunctions->glDisable(GL_BLEND);
+		_stateCache->Disable(GL_BLEND);
 		_openglFunctions->glColor4f(1.f, 1.f, 1.f, 1.f);
 
-		_openglFunctions->glDepthMask(static_cast<GLboolean>(oldDepthMask));
+		_stateCache->DepthMask(oldDepthMask);
 
 		return drawnPolys;
 	}
@@ -795,95 +947,110 @@ unsigned int StudioModelRenderer::InternalDrawShadows()
 
 	const glm::vec3 shadeVector = -_skyLight.Direction;
 
-	for (int i = 0; i < _model->Meshes.size(); ++i)
+	if (_useGpuSkinning)
 	{
-		const auto& mesh = _model->Meshes[i];
-		drawnPolys += mesh.NumTriangles;
-
-		auto triCmds = mesh.Triangles.data();
+		_skinningProgram->Bind();
+		_skinningProgram->SetMode(StudioModelSkinningProgram::Mode::Shadow);
+		_skinningProgram->SetShadow(shadeVector, lightSampleHeight, shadowHeight);
+		_skinningProgram->EnableVertexAttributes();
 
-		for (int i; (i = *triCmds++) != 0;)
+		for (const auto& mesh : _model->Meshes)
 		{
-			if (i < 0)
-			{
-				i = -i;
-				_openglFunctions->glBegin(GL_TRIANGLE_FAN);
-			}
-			else
+			drawnPolys += mesh.NumTriangles;
+
+			if (mesh.CookedIndices.empty())
 			{
-				_openglFunctions->glBegin(GL_TRIANGLE_STRIP);
+				continue;
 			}
 
-			for (; i > 0; --i, triCmds += 4)
-			{
-				const auto vertex{_xformverts[triCmds[0]]};
+			_skinningProgram->SetVertices(GetSkinningVertices(mesh).data());
+
+			_openglFunctions->glDrawElements(
+				GL_TRIANGLES, static_cast<GLsizei>(mesh.CookedIndices.size()), GL_UNSIGNED_INT, mesh.CookedIndices.data());
+			_stateCache->CountDrawCall(mesh.CookedIndices.size());
+		}
 
-				const auto lightDistance = vertex.z - lightSampleHeight;
+		_skinningProgram->DisableVertexAttributes();
+		_skinningProgram->Release();
 
-				glm::vec3 point;
+		return drawnPolys;
+	}
 
-				point.x = vertex.x - shadeVector.x * lightDistance;
-				point.y = vertex.y - shadeVector.y * lightDistance;
-				point.z = shadowHeight;
+	SkinVertices();
 
-				_openglFunctions->glVertex3fv(glm::value_ptr(point));
-			}
+	// Shadows use the same state for every mesh so they can all be drawn at once.
+	_drawVertices.clear();
+	_drawIndices.clear();
 
-			_openglFunctions->glEnd();
+	for (int i = 0; i < _model->Meshes.size(); ++i)
+	{
+		const auto& mesh = _model->Meshes[i];
+		drawnPolys += mesh.NumTriangles;
+
+		const auto firstVertex = static_cast<std::uint32_t>(_drawVertices.size());
+
+		for (const auto& meshVertex : mesh.CookedVertices)
+		{
+			const auto vertex{_skinned->Vertices[meshVertex.VertexIndex]};
+
+			const auto lightDistance = vertex.z - lightSampleHeight;
+
+			auto& point = _drawVertices.emplace_back().Position;
+
+			point.x = vertex.x - shadeVector.x * lightDistance;
+			point.y = vertex.y - shadeVector.y * lightDistance;
+			point.z = shadowHeight;
+		}
+
+		for (const auto index : mesh.CookedIndices)
+		{
+			_drawIndices.push_back(firstVertex + index);
 		}
 	}
 
+	DrawTriangleList(false, _drawIndices);
+
 	return drawnPolys;
 }
 
-void StudioModelRenderer::Lighting(glm::vec3& lv, int bone, int flags, const glm::vec3& normal)
+void StudioModelRenderer::DrawTriangleList(const bool withAttributes, std::span<const std::uint32_t> indices)
 {
-	const float ambient = std::max(0.1f, (float)_skyLight.Ambient / 255.0f); // to avoid divison by zero
-	const float shade = _skyLight.Shade / 255.0f;
-	glm::vec3 illum{ambient};
-
-	if (flags & STUDIO_NF_FULLBRIGHT)
+	if (indices.empty())
 	{
-		lv = glm::vec3{1, 1, 1};
 		return;
 	}
-	else if (flags & STUDIO_NF_FLATSHADE)
-	{
-		illum += 0.8f * shade;
-	}
-	else
-	{
-		auto lightcos = glm::dot(normal, _blightvec[bone]); // -1 colinear, 1 opposite
 
-		if (lightcos > 1.0f) lightcos = 1;
+	const auto vertices = _drawVertices.data();
 
-		illum += shade;
+	_stateCache->EnableClientState(GL_VERTEX_ARRAY);
+	_openglFunctions->glVertexPointer(3, GL_FLOAT, sizeof(DrawVertex), glm::value_ptr(vertices->Position));
 
-		auto r = _lambert;
-		if (r < 1.0f) r = 1.0f;
-		lightcos = (lightcos + (r - 1.0f)) / r; // do modified hemispherical lighting
-
-		if (lightcos > 0.0f)
-		{
-			illum -= lightcos * shade;
-		}
-
-		if (illum[0] <= 0) illum[0] = 0;
-		if (illum[1] <= 0) illum[1] = 0;
-		if (illum[2] <= 0) illum[2] = 0;
+	if (withAttributes)
+	{
+		_stateCache->EnableClientState(GL_TEXTURE_COORD_ARRAY);
+		_openglFunctions->glTexCoordPointer(2, GL_FLOAT, sizeof(DrawVertex), glm::value_ptr(vertices->TexCoord));
+		_stateCache->EnableClientState(GL_COLOR_ARRAY);
+		_openglFunctions->glColorPointer(4, GL_FLOAT, sizeof(DrawVertex), glm::value_ptr(vertices->Color));
 	}
 
-	float max = std::max({illum.x, illum.y, illum.z});
+	_openglFunctions->glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, indices.data());
+	_stateCache->CountDrawCall(indices.size());
 
-	if (max > 1.0f)
-		lv = illum * (1.0f / max);
-	else lv = illum;
+	if (withAttributes)
+	{
+		_stateCache->DisableClientState(GL_COLOR_ARRAY);
+		_stateCache->DisableClientState(GL_TEXTURE_COORD_ARRAY);
 
-	lv *= _skyLight.Color;
-}
+		// The current color is undefined after drawing with a color array, so restore what immediate mode left behind.
+		// The last index always refers to the last vertex of the last strip or fan.
+		const auto& lastColor = _drawVertices[indices.back()].Color;
+		_openglFunctions->glColor4fv(glm::value_ptr(lastColor));
+	}
 
+	_stateCache->DisableClientState(GL_VERTEX_ARRAY);
+}
 
-void StudioModelRenderer::Chrome(glm::vec2& chrome, int bone, const glm::vec3& normal)
+void StudioModelRenderer::UpdateChromeVectors(int bone)
 {
 	if (_chromeage[bone] != _modelsDrawnCount)
 	{
@@ -910,13 +1077,75 @@ void StudioModelRenderer::Chrome(glm::vec2& chrome, int bone, const glm::vec3& n
 
 		_chromeage[bone] = _modelsDrawnCount;
 	}
+}
+
+bool StudioModelRenderer::SetUpGpuSkinning()
+{
+	if (!_gpuSkinningEnabled || _gpuSkinningUnsupported)
+	{
+		return false;
+	}
+
+	if (!_skinningProgram)
+	{
+		auto program = std::make_unique<StudioModelSkinningProgram>(_logger);
+
+		if (!program->Initialize())
+		{
+			// Don't try again, use the CPU path from now on.
+			_gpuSkinningUnsupported = true;
+			return false;
+		}
+
+		_skinningProgram = std::move(program);
+	}
+
+	if (_skinningVertices.Model != _studioModel || _skinningVertices.EditGeneration != _studioModel->GetEditGeneration())
+	{
+		_skinningVertices.Model = _studioModel;
+		_skinningVertices.EditGeneration = _studioModel->GetEditGeneration();
+		_skinningVertices.Meshes.clear();
+	}
+
+	const auto boneCount = _studioModel->Bones.size();
+
+	for (std::size_t i = 0; i < boneCount; ++i)
+	{
+		UpdateChromeVectors(static_cast<int>(i));
+	}
+
+	// Upload the palette once, it's shared by all body parts and passes.
+	_skinningProgram->Bind();
+	_skinningProgram->SetBones(boneCount, _bonetransform, _blightvec, _chromeright, _chromeup);
+	_skinningProgram->SetLighting(
+		_lightingParameters.Ambient, _lightingParameters.Shade, _lightingParameters.Lambert, _lightingParameters.Color);
+	_skinningProgram->Release();
+
+	return true;
+}
+
+const std::vector<SkinningVertex>& StudioModelRenderer::GetSkinningVertices(const StudioMesh& mesh)
+{
+	auto& vertices = _skinningVertices.Meshes[&mesh];
 
-	// calc s coord
-	auto n = glm::dot(normal, _chromeright[bone]);
-	chrome[0] = (n + 1.0) * 0.5;
+	if (vertices.empty() && !mesh.CookedVertices.empty())
+	{
+		vertices.reserve(mesh.CookedVertices.size());
+
+		for (const auto& cookedVertex : mesh.CookedVertices)
+		{
+			const auto& vertex = _model->Vertices[cookedVertex.VertexIndex];
+			const auto& normal = _model->Normals[cookedVertex.NormalIndex];
+
+			vertices.push_back(
+				{
+					glm::vec4{vertex.Vertex, static_cast<float>(vertex.Bone->ArrayIndex)},
+					glm::vec4{normal.Vertex, static_cast<float>(normal.Bone->ArrayIndex)},
+					glm::vec2{static_cast<float>(cookedVertex.S), static_cast<float>(cookedVertex.T)}
+				});
+		}
+	}
 
-	// calc t coord
-	n = glm::dot(normal, _chromeup[bone]);
-	chrome[1] = (n + 1.0) * 0.5;
+	return vertices;
 }
 }
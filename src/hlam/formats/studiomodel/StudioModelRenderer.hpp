@@ -1,6 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
 #include <spdlog/logger.h>
@@ -13,6 +18,8 @@
 
 #include "formats/studiomodel/BoneTransformer.hpp"
 #include "formats/studiomodel/IStudioModelRenderer.hpp"
+#include "formats/studiomodel/SkinningKernels.hpp"
+#include "formats/studiomodel/StudioModelSkinningProgram.hpp"
 #include "formats/studiomodel/StudioModelFileFormat.hpp"
 #include "formats/studiomodel/StudioSorting.hpp"
 
@@ -22,17 +29,24 @@ class QOpenGLFunctions_1_1;
 
 class ColorSettings;
 
+namespace graphics
+{
+class OpenGLStateCache;
+}
+
 namespace studiomdl
 {
 struct StudioAnimation;
 struct StudioBone;
+struct StudioMesh;
 struct StudioSubModel;
 struct StudioSequence;
 
 class StudioModelRenderer final : public studiomdl::IStudioModelRenderer
 {
 public:
-	StudioModelRenderer(const std::shared_ptr<spdlog::logger>& logger, QOpenGLFunctions_1_1* openglFunctions, ColorSettings* colorSettings);
+	StudioModelRenderer(const std::shared_ptr<spdlog::logger>& logger,
+		QOpenGLFunctions_1_1* openglFunctions, graphics::OpenGLStateCache* stateCache, ColorSettings* colorSettings);
 	~StudioModelRenderer();
 
 	StudioModelRenderer(const StudioModelRenderer&) = delete;
@@ -44,6 +58,8 @@ public:
 
 	unsigned int GetDrawnPolygonsCount() const override final { return _drawnPolygonsCount; }
 
+	const graphics::RendererStatistics& GetStatistics() const override final { return _statistics; }
+
 	float GetLambert() const override final { return _lambert; }
 
 	const glm::vec3& GetViewerOrigin() const override final { return _viewerOrigin; }
@@ -67,6 +83,23 @@ public:
 		_skyLight = light;
 	}
 
+	std::size_t GetDecodedAnimationCacheBudget() const override final
+	{
+		return _boneTransformer.GetDecodedAnimationCache().GetBudget();
+	}
+
+	void SetDecodedAnimationCacheBudget(std::size_t budgetInBytes) override final
+	{
+		_boneTransformer.GetDecodedAnimationCache().SetBudget(budgetInBytes);
+	}
+
+	bool IsGpuSkinningEnabled() const override final { return _gpuSkinningEnabled; }
+
+	void SetGpuSkinningEnabled(bool enabled) override final
+	{
+		_gpuSkinningEnabled = enabled;
+	}
+
 	unsigned int DrawModel(ModelRenderInfo& renderInfo, const renderer::DrawFlags flags) override final;
 
 	void DrawSingleBone(ModelRenderInfo& renderInfo, const int iBone) override final;
@@ -102,24 +135,128 @@ private:
 	*/
 	void SetupModel(int bodypart);
 
+	/**
+	*	@brief Transforms the current body part's vertices if that hasn't been done yet in this call to DrawModel
+	*/
+	void SkinVertices();
+
+	/**
+	*	@brief Transforms the current body part's normals if that hasn't been done yet in this call to DrawModel
+	*/
+	void SkinNormals();
+
+	/**
+	*	@brief Calculates the current body part's lighting and chrome if that hasn't been done yet in this call to DrawModel
+	*/
+	void LightVertices();
+
+	void SortMeshes();
+
 	unsigned int DrawPoints(const bool bWireframe);
 
 	unsigned int DrawMeshes(const bool bWireframe, const SortedMesh* pMeshes);
 
+	unsigned int DrawCpuSkinnedMesh(const bool bWireframe, const StudioMesh& mesh, const int textureFlags, const double s, const double t);
+
+	unsigned int DrawGpuSkinnedMesh(const StudioMesh& mesh, const int textureFlags, const glm::vec2& textureSize);
+
 	unsigned int DrawShadows(const bool fixZFighting, const bool wireframe);
 
 	unsigned int InternalDrawShadows();
 
-	void Lighting(glm::vec3& lv, int bone, int flags, const glm::vec3& normal);
-	void Chrome(glm::vec2& chrome, int bone, const glm::vec3& normal);
+	/**
+	*	@brief Draws the vertices in _drawVertices as a triangle list.
+	*	@param withAttributes Whether to use the texture coordinates and colors of each vertex.
+	*/
+	void DrawTriangleList(const bool withAttributes, std::span<const std::uint32_t> indices);
+
+	/**
+	*	@brief Calculates the chrome vectors for a bone if they haven't been calculated for the current model yet
+	*/
+	void UpdateChromeVectors(int bone);
+
+	/**
+	*	@brief Prepares the GPU skinning program for the current model if it's enabled and supported
+	*	@return Whether the current model should be drawn using GPU skinning
+	*/
+	bool SetUpGpuSkinning();
+
+	/**
+	*	@brief Gets the untransformed vertices of a mesh in the current submodel for GPU skinning
+	*/
+	const std::vector<SkinningVertex>& GetSkinningVertices(const StudioMesh& mesh);
 
 private:
-	//TODO: need to validate model on load to ensure it does not exceed this limit
-	static constexpr int MaxVertices = 0xFFFF;
+	/**
+	*	@brief Inputs that determine a model's pose
+	*/
+	struct PoseKey
+	{
+		const EditableStudioModel* Model{};
+		std::uint64_t EditGeneration{};
+
+		int Sequence{};
+		float Frame{};
+		glm::vec3 Scale{};
+		std::array<std::uint8_t, SequenceBlendCount> Blender{};
+		std::array<std::uint8_t, ControllerCount> Controller{};
+		std::uint8_t Mouth{};
+
+		bool operator==(const PoseKey&) const = default;
+	};
+
+	/**
+	*	@brief Transformed data of a body part, calculated on demand and shared by every pass in a single call to DrawModel
+	*/
+	struct SkinnedBodypart
+	{
+		bool HasVertices{};
+		bool HasNormals{};
+		bool HasLighting{};
+		bool HasSortedMeshes{};
+
+		std::vector<glm::vec3> Vertices;
+		std::vector<glm::vec3> Normals;
+		std::vector<glm::vec3> LightValues;	// light surface normals
+		std::vector<glm::vec2> Chrome;			// texture coords for surface normals
+
+		std::vector<SortedMesh> SortedMeshes;
+
+		// Keeps the buffers around to avoid reallocating them for every draw
+		void Invalidate()
+		{
+			HasVertices = false;
+			HasNormals = false;
+			HasLighting = false;
+			HasSortedMeshes = false;
+		}
+	};
+
+	/**
+	*	@brief Untransformed vertices of the last model drawn with GPU skinning
+	*/
+	struct SkinningVertexCache
+	{
+		const EditableStudioModel* Model{};
+		std::uint64_t EditGeneration{};
+
+		std::unordered_map<const StudioMesh*, std::vector<SkinningVertex>> Meshes;
+	};
+
+	/**
+	*	@brief Vertex submitted to OpenGL through client-side vertex arrays
+	*/
+	struct DrawVertex
+	{
+		glm::vec3 Position;
+		glm::vec2 TexCoord;
+		glm::vec4 Color;
+	};
 
 	std::shared_ptr<spdlog::logger> _logger;
 
 	QOpenGLFunctions_1_1* const _openglFunctions;
+	graphics::OpenGLStateCache* const _stateCache;
 
 	ColorSettings* const _colorSettings;
 
@@ -139,18 +276,24 @@ private:
 	*/
 	unsigned int _drawnPolygonsCount = 0;
 
-	glm::vec3		_xformverts[MaxVertices];		// transformed vertices
-	glm::vec3		_xformnorms[MaxVertices];
-	glm::vec3		_lightvalues[MaxVertices];	// light surface normals
+	graphics::RendererStatistics _statistics;
+
+	std::vector<SkinnedBodypart> _skinnedBodyparts;
+
+	// Body part currently being drawn
+	SkinnedBodypart* _skinned{};
 
 	BoneTransformer _boneTransformer;
 
 	const glm::mat4x4* _bonetransform{};	// bone transformation matrix
 
+	// Inputs used to set up _bonetransform, used to skip setting up the same pose again
+	PoseKey _lastPose;
+
 	graphics::Light _skyLight;
 	glm::vec3		_blightvec[MAXSTUDIOBONES];		// light vectors in bone reference frames
+	SkinningLightingParameters _lightingParameters;
 
-	glm::vec2		_chrome[MaxVertices];			// texture coords for surface normals
 	unsigned int	_chromeage[MAXSTUDIOBONES];		// last time chrome vectors were updated
 	glm::vec3		_chromeup[MAXSTUDIOBONES];		// chrome vector "up" in bone reference frames
 	glm::vec3		_chromeright[MAXSTUDIOBONES];	// chrome vector "right" in bone reference frames
@@ -160,5 +303,22 @@ private:
 	float			_lambert = 1.5f;					// modifier for pseudo-hemispherical lighting
 
 	glm::vec3 _wireframeColor{1, 0, 0};
+
+	bool _gpuSkinningEnabled{false};
+
+	// Set if the driver can't run the skinning program
+	bool _gpuSkinningUnsupported{false};
+
+	// Whether the model currently being drawn uses GPU skinning
+	bool _useGpuSkinning{false};
+
+	std::unique_ptr<StudioModelSkinningProgram> _skinningProgram;
+
+	SkinningVertexCache _skinningVertices;
+
+	// Scratch buffers used to batch vertices into a single draw call, reused to avoid allocating every frame
+	std::vector<DrawVertex> _drawVertices;
+	std::vector<std::uint32_t> _drawIndices;
+	std::vector<glm::vec3> _drawLines;
 };
 }
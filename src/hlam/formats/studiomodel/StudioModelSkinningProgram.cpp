@@ -0,0 +1,294 @@
+#include <cstddef>
+
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+
+#include <spdlog/spdlog.h>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include "formats/studiomodel/StudioModelFileFormat.hpp"
+#include "formats/studiomodel/StudioModelSkinningProgram.hpp"
+
+namespace studiomdl
+{
+namespace
+{
+constexpr GLuint PositionAttribute = 0;
+constexpr GLuint NormalAttribute = 1;
+constexpr GLuint TexCoordAttribute = 2;
+
+//Mirrors TransformVertices, CalculateLighting, CalculateChrome
+//and StudioModelRenderer::InternalDrawShadows. Keep them in sync.
+const char* const VertexShaderSource = R"glsl(
+#version 120
+
+uniform mat4 Bones[MAX_BONES];
+uniform vec3 LightVectors[MAX_BONES];
+uniform vec3 ChromeRight[MAX_BONES];
+uniform vec3 ChromeUp[MAX_BONES];
+
+uniform float Ambient;
+uniform float Shade;
+uniform float Lambert;
+uniform vec3 LightColor;
+
+uniform vec3 ShadeVector;
+uniform float LightSampleHeight;
+uniform float ShadowHeight;
+
+uniform int Mode;
+uniform int LightingMode;
+uniform bool Chrome;
+uniform vec2 TextureSize;
+uniform float Transparency;
+
+//Keeps the compiler from reordering or fusing the math below, which would round differently than the CPU path.
+invariant gl_Position;
+invariant gl_FrontColor;
+invariant gl_TexCoord;
+
+attribute vec4 Position;
+attribute vec4 Normal;
+attribute vec2 TexCoord;
+
+//Same order of operations as glm's matrix * vector. The built-in operator may add the columns in a different order.
+vec4 Transform(mat4 matrix, vec3 position)
+{
+	return (matrix[0] * position.x + matrix[1] * position.y) + (matrix[2] * position.z + matrix[3]);
+}
+
+//Same order of operations as glm::dot. The built-in function may add the components in a different order.
+float Dot(vec3 a, vec3 b)
+{
+	return (a.x * b.x + a.y * b.y) + a.z * b.z;
+}
+
+vec3 Lighting(int bone, vec3 normal)
+{
+	if (LightingMode == 2)
+	{
+		return vec3(1.0);
+	}
+
+	float illum = Ambient;
+
+	if (LightingMode == 1)
+	{
+		illum += 0.8 * Shade;
+	}
+	else
+	{
+		float lightcos = min(Dot(normal, LightVectors[bone]), 1.0);
+
+		illum += Shade;
+
+		float r = Lambert;
+		lightcos = (lightcos + (r - 1.0)) / r;
+
+		if (lightcos > 0.0)
+		{
+			illum -= lightcos * Shade;
+		}
+
+		illum = max(illum, 0.0);
+	}
+
+	if (illum > 1.0)
+	{
+		illum *= 1.0 / illum;
+	}
+
+	return vec3(illum) * LightColor;
+}
+
+void main()
+{
+	vec4 position = Transform(Bones[int(Position.w)], Position.xyz);
+
+	if (Mode == 2)
+	{
+		float lightDistance = position.z - LightSampleHeight;
+		position = vec4(position.xy - ShadeVector.xy * lightDistance, ShadowHeight, 1.0);
+	}
+
+	gl_Position = gl_ModelViewProjectionMatrix * position;
+
+	if (Mode != 0)
+	{
+		gl_FrontColor = gl_Color;
+		return;
+	}
+
+	int normalBone = int(Normal.w);
+
+	if (Chrome)
+	{
+		gl_TexCoord[0] = vec4(
+			(Dot(Normal.xyz, ChromeRight[normalBone]) + 1.0) * 0.5,
+			(Dot(Normal.xyz, ChromeUp[normalBone]) + 1.0) * 0.5,
+			0.0, 1.0);
+	}
+	else
+	{
+		gl_TexCoord[0] = vec4(TexCoord / TextureSize, 0.0, 1.0);
+	}
+
+	gl_FrontColor = vec4(Lighting(normalBone, Normal.xyz), Transparency);
+}
+)glsl";
+}
+
+StudioModelSkinningProgram::StudioModelSkinningProgram(const std::shared_ptr<spdlog::logger>& logger)
+	: _logger(logger)
+{
+}
+
+StudioModelSkinningProgram::~StudioModelSkinningProgram() = default;
+
+bool StudioModelSkinningProgram::Initialize()
+{
+	const auto context = QOpenGLContext::currentContext();
+
+	if (!context || context->isOpenGLES() || !QOpenGLShaderProgram::hasOpenGLShaderPrograms(context))
+	{
+		SPDLOG_LOGGER_CALL(_logger, spdlog::level::info, "GPU skinning unavailable: shaders are not supported");
+		return false;
+	}
+
+	_functions = context->functions();
+
+	//Each bone needs a matrix and 3 vectors, which are padded to 4 components by most drivers
+	constexpr GLint RequiredUniformComponents = (MAXSTUDIOBONES * (16 + (3 * 4))) + 64;
+
+	GLint maxUniformComponents = 0;
+	_functions->glGetIntegerv(GL_MAX_VERTEX_UNIFORM_COMPONENTS, &maxUniformComponents);
+
+	if (maxUniformComponents < RequiredUniformComponents)
+	{
+		SPDLOG_LOGGER_CALL(_logger, spdlog::level::info,
+			"GPU skinning unavailable: {} vertex uniform components needed, {} supported",
+			RequiredUniformComponents, maxUniformComponents);
+		return false;
+	}
+
+	auto program = std::make_unique<QOpenGLShaderProgram>();
+
+	const QByteArray source = QByteArray{VertexShaderSource}.replace(
+		"MAX_BONES", QByteArray::number(MAXSTUDIOBONES));
+
+	if (!program->addShaderFromSourceCode(QOpenGLShader::Vertex, source))
+	{
+		SPDLOG_LOGGER_CALL(_logger, spdlog::level::err, "Error compiling skinning shader:\n{}", program->log().toStdString());
+		return false;
+	}
+
+	program->bindAttributeLocation("Position", PositionAttribute);
+	program->bindAttributeLocation("Normal", NormalAttribute);
+	program->bindAttributeLocation("TexCoord", TexCoordAttribute);
+
+	if (!program->link())
+	{
+		SPDLOG_LOGGER_CALL(_logger, spdlog::level::err, "Error linking skinning shader:\n{}", program->log().toStdString());
+		return false;
+	}
+
+	_bonesLocation = program->uniformLocation("Bones");
+	_lightVectorsLocation = program->uniformLocation("LightVectors");
+	_chromeRightLocation = program->uniformLocation("ChromeRight");
+	_chromeUpLocation = program->uniformLocation("ChromeUp");
+	_ambientLocation = program->uniformLocation("Ambient");
+	_shadeLocation = program->uniformLocation("Shade");
+	_lambertLocation = program->uniformLocation("Lambert");
+	_lightColorLocation = program->uniformLocation("LightColor");
+	_shadeVectorLocation = program->uniformLocation("ShadeVector");
+	_lightSampleHeightLocation = program->uniformLocation("LightSampleHeight");
+	_shadowHeightLocation = program->uniformLocation("ShadowHeight");
+	_modeLocation = program->uniformLocation("Mode");
+	_lightingModeLocation = program->uniformLocation("LightingMode");
+	_chromeLocation = program->uniformLocation("Chrome");
+	_textureSizeLocation = program->uniformLocation("TextureSize");
+	_transparencyLocation = program->uniformLocation("Transparency");
+
+	_program = std::move(program);
+
+	SPDLOG_LOGGER_CALL(_logger, spdlog::level::info, "GPU skinning initialized");
+
+	return true;
+}
+
+void StudioModelSkinningProgram::Bind()
+{
+	_program->bind();
+}
+
+void StudioModelSkinningProgram::Release()
+{
+	_program->release();
+}
+
+void StudioModelSkinningProgram::SetBones(std::size_t count, const glm::mat4x4* transforms,
+	const glm::vec3* lightVectors, const glm::vec3* chromeRight, const glm::vec3* chromeUp)
+{
+	const auto glCount = static_cast<GLsizei>(count);
+
+	_functions->glUniformMatrix4fv(_bonesLocation, glCount, GL_FALSE, glm::value_ptr(transforms[0]));
+	_functions->glUniform3fv(_lightVectorsLocation, glCount, glm::value_ptr(lightVectors[0]));
+	_functions->glUniform3fv(_chromeRightLocation, glCount, glm::value_ptr(chromeRight[0]));
+	_functions->glUniform3fv(_chromeUpLocation, glCount, glm::value_ptr(chromeUp[0]));
+}
+
+void StudioModelSkinningProgram::SetLighting(float ambient, float shade, float lambert, const glm::vec3& color)
+{
+	_functions->glUniform1f(_ambientLocation, ambient);
+	_functions->glUniform1f(_shadeLocation, shade);
+	_functions->glUniform1f(_lambertLocation, lambert);
+	_functions->glUniform3fv(_lightColorLocation, 1, glm::value_ptr(color));
+}
+
+void StudioModelSkinningProgram::SetShadow(const glm::vec3& shadeVector, float lightSampleHeight, float shadowHeight)
+{
+	_functions->glUniform3fv(_shadeVectorLocation, 1, glm::value_ptr(shadeVector));
+	_functions->glUniform1f(_lightSampleHeightLocation, lightSampleHeight);
+	_functions->glUniform1f(_shadowHeightLocation, shadowHeight);
+}
+
+void StudioModelSkinningProgram::SetMode(Mode mode)
+{
+	_functions->glUniform1i(_modeLocation, static_cast<GLint>(mode));
+}
+
+void StudioModelSkinningProgram::SetMesh(
+	LightingMode lightingMode, bool chrome, const glm::vec2& textureSize, float transparency)
+{
+	_functions->glUniform1i(_lightingModeLocation, static_cast<GLint>(lightingMode));
+	_functions->glUniform1i(_chromeLocation, chrome ? 1 : 0);
+	_functions->glUniform2fv(_textureSizeLocation, 1, glm::value_ptr(textureSize));
+	_functions->glUniform1f(_transparencyLocation, transparency);
+}
+
+void StudioModelSkinningProgram::SetVertices(const SkinningVertex* vertices)
+{
+	_functions->glVertexAttribPointer(PositionAttribute, 4, GL_FLOAT, GL_FALSE, sizeof(SkinningVertex),
+		glm::value_ptr(vertices->Position));
+	_functions->glVertexAttribPointer(NormalAttribute, 4, GL_FLOAT, GL_FALSE, sizeof(SkinningVertex),
+		glm::value_ptr(vertices->Normal));
+	_functions->glVertexAttribPointer(TexCoordAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(SkinningVertex),
+		glm::value_ptr(vertices->TexCoord));
+}
+
+void StudioModelSkinningProgram::EnableVertexAttributes()
+{
+	_functions->glEnableVertexAttribArray(PositionAttribute);
+	_functions->glEnableVertexAttribArray(NormalAttribute);
+	_functions->glEnableVertexAttribArray(TexCoordAttribute);
+}
+
+void StudioModelSkinningProgram::DisableVertexAttributes()
+{
+	_functions->glDisableVertexAttribArray(TexCoordAttribute);
+	_functions->glDisableVertexAttribArray(NormalAttribute);
+	_functions->glDisableVertexAttribArray(PositionAttribute);
+}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <spdlog/logger.h>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+class QOpenGLFunctions;
+class QOpenGLShaderProgram;
+
+namespace studiomdl
+{
+/**
+*	@brief Untransformed vertex used by the GPU skinning path
+*/
+struct SkinningVertex
+{
+	//xyz is the position relative to the bone, w is the bone index
+	glm::vec4 Position{0};
+
+	//xyz is the normal relative to the bone, w is the bone index
+	glm::vec4 Normal{0};
+
+	//Texture coordinates in texels
+	glm::vec2 TexCoord{0};
+};
+
+/**
+*	@brief Vertex shader that transforms and lights studio model vertices using a bone matrix palette.
+*	Uses the same formulas as the CPU path in StudioModelRenderer.
+*	Only a vertex shader is provided so the fixed function pipeline still handles texturing, blending and alpha testing.
+*/
+class StudioModelSkinningProgram final
+{
+public:
+	enum class Mode
+	{
+		//Lit and textured
+		Textured = 0,
+
+		//Uses the current color, for wireframe
+		SolidColor,
+
+		//Projected onto the ground using the current color
+		Shadow
+	};
+
+	enum class LightingMode
+	{
+		Shaded = 0,
+		FlatShaded,
+
+		//Fullbright and additive textures
+		Unlit
+	};
+
+	explicit StudioModelSkinningProgram(const std::shared_ptr<spdlog::logger>& logger);
+	~StudioModelSkinningProgram();
+
+	StudioModelSkinningProgram(const StudioModelSkinningProgram&) = delete;
+	StudioModelSkinningProgram& operator=(const StudioModelSkinningProgram&) = delete;
+
+	/**
+	*	@brief Compiles and links the program. Requires a current OpenGL context.
+	*	@return Whether the driver supports the program.
+	*/
+	bool Initialize();
+
+	void Bind();
+
+	void Release();
+
+	/**
+	*	@brief Uploads the bone palette. The program must be bound.
+	*/
+	void SetBones(std::size_t count, const glm::mat4x4* transforms,
+		const glm::vec3* lightVectors, const glm::vec3* chromeRight, const glm::vec3* chromeUp);
+
+	void SetLighting(float ambient, float shade, float lambert, const glm::vec3& color);
+
+	void SetShadow(const glm::vec3& shadeVector, float lightSampleHeight, float shadowHeight);
+
+	void SetMode(Mode mode);
+
+	void SetMesh(LightingMode lightingMode, bool chrome, const glm::vec2& textureSize, float transparency);
+
+	/**
+	*	@brief Points the vertex attributes at the given vertices.
+	*/
+	void SetVertices(const SkinningVertex* vertices);
+
+	void EnableVertexAttributes();
+
+	void DisableVertexAttributes();
+
+private:
+	const std::shared_ptr<spdlog::logger> _logger;
+
+	std::unique_ptr<QOpenGLShaderProgram> _program;
+	QOpenGLFunctions* _functions{};
+
+	int _bonesLocation{-1};
+	int _lightVectorsLocation{-1};
+	int _chromeRightLocation{-1};
+	int _chromeUpLocation{-1};
+	int _ambientLocation{-1};
+	int _shadeLocation{-1};
+	int _lambertLocation{-1};
+	int _lightColorLocation{-1};
+	int _shadeVectorLocation{-1};
+	int _lightSampleHeightLocation{-1};
+	int _shadowHeightLocation{-1};
+	int _modeLocation{-1};
+	int _lightingModeLocation{-1};
+	int _chromeLocation{-1};
+	int _textureSizeLocation{-1};
+	int _transparencyLocation{-1};
+};
+}
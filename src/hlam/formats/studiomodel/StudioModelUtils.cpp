@@ -1,17 +1,26 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <exception>
+#include <future>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "application/AssetIO.hpp"
 
+#include "formats/studiomodel/StudioModelIO.hpp"
 #include "formats/studiomodel/StudioModelUtils.hpp"
 
 #include "utility/Platform.hpp"
+#include "utility/Profiling.hpp"
 #include "utility/StringUtils.hpp"
 
 namespace studiomdl
@@ -227,39 +236,39 @@ std::vector<StudioSequencePivot> ConvertPivotsToEditable(
 	return result;
 }
 
-std::vector<std::vector<StudioAnimation>> ConvertAnimationBlendsToEditable(
-	const StudioModel& studioModel, const mstudioseqdesc_t& sequence)
+/**
+*	@brief Reads the animation data of a sequence.
+*	@param source Animation data of the first bone in the first blend.
+*	@param validateAddress Called with the end of each piece of data before it is read.
+*	@param validateOnly If true the data is only checked for validity and nothing is copied.
+*	@param[out] dataEnd End of the last piece of data that was read.
+*		Values are stored after the bones that use them, so everything that was read lies between @p source and this.
+*/
+template<typename ValidateAddress>
+std::vector<std::vector<StudioAnimation>> ReadAnimationBlends(const mstudioanim_t* source, int numBones, int numBlends,
+	int numFrames, ValidateAddress&& validateAddress, bool validateOnly, const std::byte*& dataEnd)
 {
-	auto header = studioModel.GetStudioHeader();
-
 	std::vector<std::vector<StudioAnimation>> result;
 
-	result.reserve(sequence.numblends);
-
-	auto source = studioModel.GetAnim(&sequence);
-
-	const auto validateSequenceAddress = [&](const void* address)
+	if (!validateOnly)
 	{
-		if (sequence.seqgroup == 0)
-		{
-			ValidateMemoryAddress(studioModel.GetStudioHeaderPtr(), address);
-		}
-		else
-		{
-			ValidateMemoryAddress(studioModel.GetSeqGroupHeaderPtr(sequence.seqgroup - 1), address);
-		}
-	};
-	
-	validateSequenceAddress(source);
+		result.reserve(numBlends);
+	}
 
-	for (int i = 0; i < sequence.numblends; ++i)
+	dataEnd = reinterpret_cast<const std::byte*>(source);
+
+	for (int i = 0; i < numBlends; ++i)
 	{
 		std::vector<StudioAnimation> animations;
 
-		animations.reserve(header->numbones);
+		animations.reserve(numBones);
 
-		for (int b = 0; b < header->numbones; ++b, ++source)
+		for (int b = 0; b < numBones; ++b, ++source)
 		{
+			validateAddress(source + 1);
+
+			dataEnd = std::max(dataEnd, reinterpret_cast<const std::byte*>(source + 1));
+
 			StudioAnimation animation;
 
 			for (int j = 0; j < STUDIO_NUM_COORDINATE_AXES; ++j)
@@ -268,21 +277,23 @@ std::vector<std::vector<StudioAnimation>> ConvertAnimationBlendsToEditable(
 				{
 					std::vector<mstudioanimvalue_t> values;
 
-					auto valuesStart = reinterpret_cast<const mstudioanimvalue_t*>((reinterpret_cast<std::byte*>(source) + source->offset[j]));
+					auto valuesStart = reinterpret_cast<const mstudioanimvalue_t*>((reinterpret_cast<const std::byte*>(source) + source->offset[j]));
 					auto valuesEnd = valuesStart;
 
-					validateSequenceAddress(valuesStart);
+					validateAddress(valuesStart + 1);
 
 					//Determine number of values
-					if (sequence.numframes > 0)
+					if (numFrames > 0)
 					{
-						for (int f = 0; f < sequence.numframes;)
+						for (int f = 0; f < numFrames;)
 						{
+							validateAddress(valuesEnd + 1);
+
 							f += valuesEnd->num.total;
 
 							valuesEnd += 1 + valuesEnd->num.valid;
 
-							validateSequenceAddress(valuesEnd);
+							validateAddress(valuesEnd);
 						}
 					}
 					else
@@ -291,22 +302,186 @@ std::vector<std::vector<StudioAnimation>> ConvertAnimationBlendsToEditable(
 						++valuesEnd;
 					}
 
-					values.insert(values.end(), valuesStart, valuesEnd);
+					dataEnd = std::max(dataEnd, reinterpret_cast<const std::byte*>(valuesEnd));
+
+					if (!validateOnly)
+					{
+						values.insert(values.end(), valuesStart, valuesEnd);
 
-					animation.Data[j] = std::move(values);
+						animation.Data[j] = std::move(values);
+					}
 				}
 			}
 
-			animations.push_back(std::move(animation));
+			if (!validateOnly)
+			{
+				animation.BuildSpanIndex();
+				animations.push_back(std::move(animation));
+			}
+		}
+
+		if (!validateOnly)
+		{
+			result.push_back(std::move(animations));
+		}
+	}
+
+	return result;
+}
+
+/**
+*	@brief Converts the animation data of a sequence.
+*	@param lazy If true the data is only validated now, and a copy of it is converted the first time it is accessed.
+*/
+StudioAnimationBlends ConvertAnimationBlendsToEditable(
+	const StudioModel& studioModel, const mstudioseqdesc_t& sequence, bool lazy)
+{
+	auto header = studioModel.GetStudioHeader();
+
+	const mstudioanim_t* source = studioModel.GetAnim(&sequence);
+
+	const auto validateSequenceAddress = [&](const void* address)
+	{
+		if (sequence.seqgroup == 0)
+		{
+			ValidateMemoryAddress(studioModel.GetStudioHeaderPtr(), address);
+		}
+		else
+		{
+			ValidateMemoryAddress(studioModel.GetSeqGroupHeaderPtr(sequence.seqgroup - 1), address);
+		}
+	};
+
+	validateSequenceAddress(source);
+
+	const std::byte* dataEnd = nullptr;
+
+	auto blends = ReadAnimationBlends(
+		source, header->numbones, sequence.numblends, sequence.numframes, validateSequenceAddress, lazy, dataEnd);
+
+	if (!lazy)
+	{
+		return StudioAnimationBlends{std::move(blends)};
+	}
+
+	// Only this sequence's data is kept so the source model doesn't have to stay in memory.
+	std::vector<std::byte> data{reinterpret_cast<const std::byte*>(source), dataEnd};
+
+	return StudioAnimationBlends(sequence.numblends,
+		[data = std::move(data), numBones = header->numbones, numBlends = sequence.numblends, numFrames = sequence.numframes]()
+		{
+			const std::byte* dataEnd = nullptr;
+
+			// Already validated.
+			return ReadAnimationBlends(reinterpret_cast<const mstudioanim_t*>(data.data()), numBones, numBlends, numFrames,
+				[](const void*) {}, false, dataEnd);
+		});
+}
+
+/**
+*	@brief Part of the conversion progress covered by animation data, which takes up most of the time.
+*/
+constexpr float AnimationProgressFraction = 0.8f;
+
+struct ConvertedAnimationBlends
+{
+	StudioAnimationBlends Blends;
+	std::exception_ptr Error;
+};
+
+/**
+*	@brief Converts the animation data of all sequences.
+*	Sequence groups are converted on up to @ref MaxConcurrentSequenceGroupTasks threads.
+*	Errors are stored with the sequence that caused them so they can be reported in sequence order.
+*	@param lazy If true the data is only validated now and each sequence's data is converted on first access.
+*	@param progress If not null, receives the progress of the current step up to @ref AnimationProgressFraction
+*/
+std::vector<ConvertedAnimationBlends> ConvertAllAnimationBlendsToEditable(
+	const StudioModel& studioModel, bool lazy, AssetLoadProgress* progress)
+{
+	auto header = studioModel.GetStudioHeader();
+
+	std::vector<ConvertedAnimationBlends> result(header->numseq);
+
+	std::atomic<int> convertedCount{0};
+
+	const auto convertGroup = [&](int group)
+	{
+		for (int i = 0; i < header->numseq; ++i)
+		{
+			auto source = header->GetSequence(i);
+
+			if (source->seqgroup != group)
+			{
+				continue;
+			}
+
+			// Cancellation is checked once all groups have stopped.
+			if (progress && progress->IsCancelled())
+			{
+				return;
+			}
+
+			try
+			{
+				result[i].Blends = ConvertAnimationBlendsToEditable(studioModel, *source, lazy);
+			}
+			catch (...)
+			{
+				// Conversion stops at the first error in a sequence so later sequences in this group are never used.
+				result[i].Error = std::current_exception();
+				break;
+			}
+
+			if (progress)
+			{
+				progress->SetStepProgress(AnimationProgressFraction * (convertedCount.fetch_add(1) + 1) / header->numseq);
+			}
+		}
+	};
+
+	// The main file's group plus each sequence group file.
+	const int groupCount = static_cast<int>(studioModel.GetSeqGroupCount()) + 1;
+
+	std::atomic<int> nextGroup{0};
+
+	const auto convertGroups = [&]
+	{
+		for (int group = nextGroup++; group < groupCount; group = nextGroup++)
+		{
+			convertGroup(group);
 		}
+	};
+
+	// This thread converts groups as well.
+	const std::size_t threadCount = std::min(static_cast<std::size_t>(groupCount), MaxConcurrentSequenceGroupTasks);
+
+	std::vector<std::future<void>> tasks;
+
+	tasks.reserve(threadCount - 1);
+
+	for (std::size_t i = 1; i < threadCount; ++i)
+	{
+		tasks.push_back(std::async(std::launch::async, convertGroups));
+	}
+
+	convertGroups();
+
+	for (auto& task : tasks)
+	{
+		task.get();
+	}
 
-		result.push_back(std::move(animations));
+	if (progress)
+	{
+		progress->ThrowIfCancelled();
 	}
 
 	return result;
 }
 
-std::vector<std::unique_ptr<StudioSequence>> ConvertSequencesToEditable(const StudioModel& studioModel, bool convertPivots)
+std::vector<std::unique_ptr<StudioSequence>> ConvertSequencesToEditable(
+	const StudioModel& studioModel, bool convertPivots, bool lazyAnimations, AssetLoadProgress* progress)
 {
 	auto header = studioModel.GetStudioHeader();
 
@@ -314,16 +489,25 @@ std::vector<std::unique_ptr<StudioSequence>> ConvertSequencesToEditable(const St
 
 	result.reserve(header->numseq);
 
+	// Validate all sequence descriptors up front so animation data can be converted concurrently.
 	for (int i = 0; i < header->numseq; ++i)
 	{
 		auto source = header->GetSequence(i);
 
 		ValidateMemoryAddress(studioModel.GetStudioHeaderPtr(), source);
+		ValidateMemoryAddress(studioModel.GetStudioHeaderPtr(), source + 1);
 
 		if (source->seqgroup < 0 || (source->seqgroup != 0 && (source->seqgroup - 1) >= studioModel.GetSeqGroupCount()))
 		{
 			throw AssetException("Invalid seqgroup value");
 		}
+	}
+
+	auto animationBlends = ConvertAllAnimationBlendsToEditable(studioModel, lazyAnimations, progress);
+
+	for (int i = 0; i < header->numseq; ++i)
+	{
+		auto source = header->GetSequence(i);
 
 		auto events = ConvertEventsToEditable(studioModel, *source);
 
@@ -339,6 +523,13 @@ std::vector<std::unique_ptr<StudioSequence>> ConvertSequencesToEditable(const St
 
 		SortEventsList(sortedEvents);
 
+		auto pivots = convertPivots ? ConvertPivotsToEditable(studioModel, *source) : std::vector<studiomdl::StudioSequencePivot>{};
+
+		if (animationBlends[i].Error)
+		{
+			std::rethrow_exception(animationBlends[i].Error);
+		}
+
 		StudioSequence sequence
 		{
 			source->label,
@@ -349,13 +540,13 @@ std::vector<std::unique_ptr<StudioSequence>> ConvertSequencesToEditable(const St
 			std::move(events),
 			std::move(sortedEvents),
 			source->numframes,
-			convertPivots ? ConvertPivotsToEditable(studioModel, *source) : std::vector<studiomdl::StudioSequencePivot>{},
+			std::move(pivots),
 			source->motiontype,
 			source->motionbone,
 			source->linearmovement,
 			source->bbmin,
 			source->bbmax,
-			ConvertAnimationBlendsToEditable(studioModel, *source),
+			std::move(animationBlends[i].Blends),
 			{
 				{
 					{
@@ -449,6 +640,8 @@ std::vector<StudioMesh> ConvertMeshesToEditable(const StudioModel& studioModel,
 			source->skinref,
 		};
 
+		CookMesh(mesh);
+
 		result.push_back(std::move(mesh));
 	}
 
@@ -758,7 +951,8 @@ static void ValidateCount(int count)
 	}
 }
 
-EditableStudioModel ConvertToEditable(const StudioModel& studioModel)
+static EditableStudioModel ConvertToEditableCore(
+	const StudioModel& studioModel, bool lazyAnimations, AssetLoadProgress* progress)
 {
 	auto header = studioModel.GetStudioHeader();
 	auto textureHeader = studioModel.GetTextureHeader();
@@ -780,6 +974,12 @@ EditableStudioModel ConvertToEditable(const StudioModel& studioModel)
 	ValidateCount(header->numattachments < 0);
 	ValidateCount(header->numtransitions < 0);
 
+	// Bone data is stored in fixed size arrays when rendering.
+	if (header->numbones > MAXSTUDIOBONES)
+	{
+		throw AssetException(fmt::format("Model has {} bones, the maximum is {}", header->numbones, MAXSTUDIOBONES));
+	}
+
 	EditableStudioModel result;
 
 	result.EyePosition = header->eyeposition;
@@ -793,7 +993,7 @@ EditableStudioModel ConvertToEditable(const StudioModel& studioModel)
 	result.Bones = ConvertBonesToEditable(studioModel, result.BoneControllers);
 	result.Hitboxes = ConvertHitboxesToEditable(studioModel, result.Bones);
 	result.SequenceGroups = ConvertSequenceGroupsToEditable(studioModel);
-	result.Sequences = ConvertSequencesToEditable(studioModel, !isXashModel);
+	result.Sequences = ConvertSequencesToEditable(studioModel, !isXashModel, lazyAnimations, progress);
 	result.Attachments = ConvertAttachmentsToEditable(studioModel, result.Bones);
 	result.Bodyparts = ConvertBodypartsToEditable(studioModel, result.Bones);
 
@@ -806,9 +1006,26 @@ EditableStudioModel ConvertToEditable(const StudioModel& studioModel)
 
 	result.IsXashModel = isXashModel;
 
+	if (progress)
+	{
+		progress->SetStepProgress(1);
+	}
+
 	return result;
 }
 
+EditableStudioModel ConvertToEditable(const StudioModel& studioModel)
+{
+	HLAM_PROFILE_SCOPE("ConvertToEditable");
+
+	return ConvertToEditableCore(studioModel, false, nullptr);
+}
+
+EditableStudioModel ConvertToEditableWithLazyAnimations(const StudioModel& studioModel, AssetLoadProgress* progress)
+{
+	return ConvertToEditableCore(studioModel, true, progress);
+}
+
 namespace
 {
 template<typename T>
@@ -1372,6 +1589,8 @@ constexpr std::size_t StudioModelBufferSize = 16 * 1024 * 1024;
 
 StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const EditableStudioModel& studioModel)
 {
+	HLAM_PROFILE_SCOPE("ConvertFromEditable");
+
 	//Use a local header until all data is written, then write the header to the start of the buffer
 	//This avoids having to reacquire the header pointer every time the buffer is reallocated
 	studiohdr_t header{};
@@ -1431,6 +1650,37 @@ StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const Edi
 	};
 }
 
+std::vector<std::string> CheckEngineLimits(const EditableStudioModel& studioModel)
+{
+	std::vector<std::string> problems;
+
+	const auto check = [&](std::size_t count, std::size_t limit, std::string_view what)
+	{
+		if (count > limit)
+		{
+			problems.push_back(fmt::format("{} has {}, the engine supports up to {}", what, count, limit));
+		}
+	};
+
+	check(studioModel.Textures.size(), MAXSTUDIOSKINS, "Model textures");
+	check(studioModel.Sequences.size(), MAXSTUDIOSEQUENCES, "Model sequences");
+	check(studioModel.Bodyparts.size(), MAXSTUDIOBODYPARTS, "Model body parts");
+
+	for (const auto& bodypart : studioModel.Bodyparts)
+	{
+		check(bodypart->Models.size(), MAXSTUDIOMODELS, fmt::format("Body part \"{}\" submodels", bodypart->Name));
+
+		for (const auto& model : bodypart->Models)
+		{
+			check(model.Meshes.size(), MAXSTUDIOMESHES, fmt::format("Submodel \"{}\" meshes", model.Name));
+			check(model.Vertices.size(), MAXSTUDIOVERTS, fmt::format("Submodel \"{}\" vertices", model.Name));
+			check(model.Normals.size(), MAXSTUDIOVERTS, fmt::format("Submodel \"{}\" normals", model.Name));
+		}
+	}
+
+	return problems;
+}
+
 bool IsXashModel(const StudioModel& studioModel)
 {
 	const auto header = studioModel.GetStudioHeader();
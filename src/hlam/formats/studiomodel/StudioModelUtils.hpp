@@ -1,6 +1,10 @@
 #pragma once
 
 #include <filesystem>
+#include <string>
+#include <vector>
+
+#include "application/AssetIO.hpp"
 
 #include "formats/studiomodel/EditableStudioModel.hpp"
 #include "formats/studiomodel/StudioModel.hpp"
@@ -10,8 +14,25 @@ namespace studiomdl
 class StudioModel;
 
 EditableStudioModel ConvertToEditable(const StudioModel& studioModel);
+
+/**
+*	@brief Converts a model to its editable form, deferring the conversion of animation data.
+*	Animation data is validated up front, but each sequence's data is only converted the first time it is accessed.
+*	Each sequence keeps a copy of its own animation data until then, so the source model can be discarded afterwards.
+*	@param progress If not null, receives the progress of the current step and is checked for cancellation
+*	@exception AssetLoadCancelledException If loading was cancelled through @p progress
+*/
+EditableStudioModel ConvertToEditableWithLazyAnimations(
+	const StudioModel& studioModel, AssetLoadProgress* progress = nullptr);
 StudioModel ConvertFromEditable(const std::filesystem::path& fileName, const EditableStudioModel& studioModel);
 
+/**
+*	@brief Checks the model against the limits of the GoldSource engine.
+*	Models that exceed them can still be viewed and edited, but will not load or render correctly in the game.
+*	@return A description of each limit that is exceeded.
+*/
+std::vector<std::string> CheckEngineLimits(const EditableStudioModel& studioModel);
+
 /**
 *	@brief Detects whether the given model is a Xash model.
 *	Xash models have bone weights
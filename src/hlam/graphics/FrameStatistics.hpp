@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+namespace graphics
+{
+/**
+*	@brief Running totals of the work done by a renderer since it was created.
+*	Subtract two snapshots to get the work done in between.
+*/
+struct RendererStatistics
+{
+	// Number of times bone transforms were calculated, not counting reused poses
+	unsigned int BoneSetups = 0;
+
+	// Number of vertices transformed on the CPU
+	unsigned int SkinnedVertices = 0;
+};
+
+/**
+*	@brief Work done to draw a single frame of a scene
+*/
+struct FrameStatistics
+{
+	// Draw calls made by everything in the scene, counted by the state cache
+	unsigned int DrawCalls = 0;
+	unsigned int VerticesSubmitted = 0;
+	unsigned int DrawnPolygons = 0;
+
+	// OpenGL state changes passed on to the driver, including texture binds
+	unsigned int StateChanges = 0;
+
+	// Redundant state changes and state queries filtered out by the state cache
+	unsigned int AvoidedStateChanges = 0;
+
+	unsigned int TextureBinds = 0;
+
+	// Texture data uploaded since the previous frame of the same scene
+	std::uint64_t BytesUploaded = 0;
+
+	unsigned int BoneSetups = 0;
+	unsigned int SkinnedVertices = 0;
+};
+}
@@ -15,6 +15,7 @@
 #include "formats/studiomodel/IStudioModelRenderer.hpp"
 
 #include "graphics/GraphicsUtils.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/Palette.hpp"
 
 #include "utility/Platform.hpp"
@@ -59,12 +60,12 @@ void FlipImageVertically(const int iWidth, const int iHeight, std::byte* const p
 	}
 }
 
-void DrawBackground(QOpenGLFunctions_1_1* openglFunctions, GLuint backgroundTexture)
+void DrawBackground(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache, GLuint backgroundTexture)
 {
 	if (backgroundTexture == GL_INVALID_TEXTURE_ID)
 		return;
 
-	openglFunctions->glDisable(GL_BLEND);
+	stateCache->Disable(GL_BLEND);
 
 	openglFunctions->glMatrixMode(GL_PROJECTION);
 	openglFunctions->glLoadIdentity();
@@ -75,13 +76,13 @@ void DrawBackground(QOpenGLFunctions_1_1* openglFunctions, GLuint backgroundText
 	openglFunctions->glPushMatrix();
 	openglFunctions->glLoadIdentity();
 
-	openglFunctions->glDisable(GL_CULL_FACE);
-	openglFunctions->glEnable(GL_TEXTURE_2D);
+	stateCache->Disable(GL_CULL_FACE);
+	stateCache->Enable(GL_TEXTURE_2D);
 
 	openglFunctions->glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-	openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	stateCache->PolygonMode(GL_FILL);
 
-	openglFunctions->glBindTexture(GL_TEXTURE_2D, backgroundTexture);
+	stateCache->BindTexture(backgroundTexture);
 
 	openglFunctions->glBegin(GL_TRIANGLE_STRIP);
 
@@ -98,14 +99,15 @@ void DrawBackground(QOpenGLFunctions_1_1* openglFunctions, GLuint backgroundText
 	openglFunctions->glVertex2f(1, 1);
 
 	openglFunctions->glEnd();
+	stateCache->CountDrawCall(4);
 
 	openglFunctions->glPopMatrix();
 
 	openglFunctions->glClear(GL_DEPTH_BUFFER_BIT);
-	openglFunctions->glBindTexture(GL_TEXTURE_2D, 0);
+	stateCache->BindTexture(0);
 }
 
-void DrawBox(QOpenGLFunctions_1_1* openglFunctions, const std::array<glm::vec3, 8>& points)
+void DrawBox(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache, const std::array<glm::vec3, 8>& points)
 {
 	openglFunctions->glBegin(GL_QUAD_STRIP);
 	for (int i = 0; i < 10; ++i)
@@ -113,6 +115,7 @@ void DrawBox(QOpenGLFunctions_1_1* openglFunctions, const std::array<glm::vec3,
 		openglFunctions->glVertex3fv(glm::value_ptr(points[i & 7]));
 	}
 	openglFunctions->glEnd();
+	stateCache->CountDrawCall(10);
 
 	openglFunctions->glBegin(GL_QUAD_STRIP);
 	openglFunctions->glVertex3fv(glm::value_ptr(points[6]));
@@ -120,6 +123,7 @@ void DrawBox(QOpenGLFunctions_1_1* openglFunctions, const std::array<glm::vec3,
 	openglFunctions->glVertex3fv(glm::value_ptr(points[4]));
 	openglFunctions->glVertex3fv(glm::value_ptr(points[2]));
 	openglFunctions->glEnd();
+	stateCache->CountDrawCall(4);
 
 	openglFunctions->glBegin(GL_QUAD_STRIP);
 	openglFunctions->glVertex3fv(glm::value_ptr(points[1]));
@@ -127,44 +131,43 @@ void DrawBox(QOpenGLFunctions_1_1* openglFunctions, const std::array<glm::vec3,
 	openglFunctions->glVertex3fv(glm::value_ptr(points[3]));
 	openglFunctions->glVertex3fv(glm::value_ptr(points[5]));
 	openglFunctions->glEnd();
+	stateCache->CountDrawCall(4);
 }
 
-void DrawOutlinedBox(QOpenGLFunctions_1_1* openglFunctions, 
+void DrawOutlinedBox(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache,
 	const std::array<glm::vec3, 8>& points, const glm::vec4& faceColor, const glm::vec4& borderColor)
 {
-	openglFunctions->glDisable(GL_TEXTURE_2D);
-	openglFunctions->glEnable(GL_DEPTH_TEST);
+	stateCache->Disable(GL_TEXTURE_2D);
+	stateCache->Enable(GL_DEPTH_TEST);
 
-	openglFunctions->glEnable(GL_BLEND);
-	openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	stateCache->Enable(GL_BLEND);
+	stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	//Cull interior faces to avoid overlap
-	openglFunctions->glEnable(GL_CULL_FACE);
+	stateCache->Enable(GL_CULL_FACE);
 
 	//Disable depth mask so lines can draw over the box itself
-	GLint depthMaskWasEnabled = GL_FALSE;
+	const GLboolean depthMaskWasEnabled = stateCache->GetDepthMask();
 
-	openglFunctions->glGetIntegerv(GL_DEPTH_WRITEMASK, &depthMaskWasEnabled);
+	stateCache->DepthMask(GL_FALSE);
 
-	openglFunctions->glDepthMask(GL_FALSE);
-
-	openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	stateCache->PolygonMode(GL_FILL);
 	openglFunctions->glColor4fv(glm::value_ptr(faceColor));
 
-	DrawBox(openglFunctions, points);
+	DrawBox(openglFunctions, stateCache, points);
 
-	openglFunctions->glDepthMask(GL_TRUE);
+	stateCache->DepthMask(GL_TRUE);
 
 	//Draw edges
-	openglFunctions->glDisable(GL_CULL_FACE);
-	openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	stateCache->Disable(GL_CULL_FACE);
+	stateCache->PolygonMode(GL_LINE);
 	openglFunctions->glColor4fv(glm::value_ptr(borderColor));
 
-	DrawBox(openglFunctions, points);
+	DrawBox(openglFunctions, stateCache, points);
 
-	openglFunctions->glDepthMask(depthMaskWasEnabled ? GL_TRUE : GL_FALSE);
+	stateCache->DepthMask(depthMaskWasEnabled);
 
-	openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	stateCache->PolygonMode(GL_FILL);
 }
 
 const std::string_view DmBaseName{"DM_Base.bmp"};
@@ -292,16 +295,16 @@ void PaletteHueReplace(RGBPalette& palette, int newHue, int start, int end)
 	}
 }
 
-void SetupRenderMode(QOpenGLFunctions_1_1* openglFunctions, RenderMode renderMode, const bool bBackfaceCulling)
+void SetupRenderMode(OpenGLStateCache* stateCache, RenderMode renderMode, const bool bBackfaceCulling)
 {
 	switch (renderMode)
 	{
 	case RenderMode::WIREFRAME:
 	{
-		openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-		openglFunctions->glDisable(GL_TEXTURE_2D);
-		openglFunctions->glDisable(GL_CULL_FACE);
-		openglFunctions->glEnable(GL_DEPTH_TEST);
+		stateCache->PolygonMode(GL_LINE);
+		stateCache->Disable(GL_TEXTURE_2D);
+		stateCache->Disable(GL_CULL_FACE);
+		stateCache->Enable(GL_DEPTH_TEST);
 
 		break;
 	}
@@ -309,51 +312,37 @@ void SetupRenderMode(QOpenGLFunctions_1_1* openglFunctions, RenderMode renderMod
 	case RenderMode::FLAT_SHADED:
 	case RenderMode::SMOOTH_SHADED:
 	{
-		openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-		openglFunctions->glDisable(GL_TEXTURE_2D);
+		stateCache->PolygonMode(GL_FILL);
+		stateCache->Disable(GL_TEXTURE_2D);
 
-		if (bBackfaceCulling)
-		{
-			openglFunctions->glEnable(GL_CULL_FACE);
-		}
-		else
-		{
-			openglFunctions->glDisable(GL_CULL_FACE);
-		}
+		stateCache->SetEnabled(GL_CULL_FACE, bBackfaceCulling);
 
-		openglFunctions->glEnable(GL_DEPTH_TEST);
+		stateCache->Enable(GL_DEPTH_TEST);
 
 		if (renderMode == RenderMode::FLAT_SHADED)
-			openglFunctions->glShadeModel(GL_FLAT);
+			stateCache->ShadeModel(GL_FLAT);
 		else
-			openglFunctions->glShadeModel(GL_SMOOTH);
+			stateCache->ShadeModel(GL_SMOOTH);
 
 		break;
 	}
 
 	case RenderMode::TEXTURE_SHADED:
 	{
-		openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-		openglFunctions->glEnable(GL_TEXTURE_2D);
+		stateCache->PolygonMode(GL_FILL);
+		stateCache->Enable(GL_TEXTURE_2D);
 
-		if (bBackfaceCulling)
-		{
-			openglFunctions->glEnable(GL_CULL_FACE);
-		}
-		else
-		{
-			openglFunctions->glDisable(GL_CULL_FACE);
-		}
+		stateCache->SetEnabled(GL_CULL_FACE, bBackfaceCulling);
 
-		openglFunctions->glEnable(GL_DEPTH_TEST);
-		openglFunctions->glShadeModel(GL_SMOOTH);
+		stateCache->Enable(GL_DEPTH_TEST);
+		stateCache->ShadeModel(GL_SMOOTH);
 
 		break;
 	}
 	}
 }
 
-void DrawGroundQuad(QOpenGLFunctions_1_1* openglFunctions, const glm::vec3& origin, float groundLength, float textureRepeatLength, glm::vec2 textureOffset)
+void DrawGroundQuad(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache, const glm::vec3& origin, float groundLength, float textureRepeatLength, glm::vec2 textureOffset)
 {
 	const float vertexCoord{groundLength / 2};
 
@@ -381,104 +370,94 @@ void DrawGroundQuad(QOpenGLFunctions_1_1* openglFunctions, const glm::vec3& orig
 	openglFunctions->glVertex3f(origin.x + vertexCoord, origin.y - vertexCoord, origin.z);
 
 	openglFunctions->glEnd();
+	stateCache->CountDrawCall(4);
 }
 
-void DrawGround(QOpenGLFunctions_1_1* openglFunctions,
+void DrawGround(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache,
 	const glm::vec3& origin, float groundLength, float textureRepeatLength,
 	const glm::vec2& textureOffset, std::optional<GLuint> groundTexture, const glm::vec4& groundColor,
 	const bool bMirror)
 {
-	const auto cullFaceWasEnabled = openglFunctions->glIsEnabled(GL_CULL_FACE);
-	GLint oldCullFace;
-
-	openglFunctions->glGetIntegerv(GL_CULL_FACE_MODE, &oldCullFace);
+	const bool cullFaceWasEnabled = stateCache->IsEnabled(GL_CULL_FACE);
+	const GLenum oldCullFace = stateCache->GetCullFace();
 
-	openglFunctions->glCullFace(GL_FRONT);
+	stateCache->CullFace(GL_FRONT);
 
-	openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-	openglFunctions->glEnable(GL_DEPTH_TEST);
-	openglFunctions->glEnable(GL_CULL_FACE);
+	stateCache->PolygonMode(GL_FILL);
+	stateCache->Enable(GL_DEPTH_TEST);
+	stateCache->Enable(GL_CULL_FACE);
 
 	if (bMirror)
 	{
-		openglFunctions->glFrontFace(GL_CW);
+		stateCache->FrontFace(GL_CW);
 	}
 	else
 	{
-		openglFunctions->glDisable(GL_CULL_FACE);
+		stateCache->Disable(GL_CULL_FACE);
 	}
 
-	openglFunctions->glEnable(GL_BLEND);
+	stateCache->Enable(GL_BLEND);
 
 	if (groundTexture)
 	{
-		openglFunctions->glEnable(GL_TEXTURE_2D);
+		stateCache->Enable(GL_TEXTURE_2D);
 		openglFunctions->glColor4f(1.0f, 1.0f, 1.0f, 0.6f);
-		openglFunctions->glBindTexture(GL_TEXTURE_2D, *groundTexture);
+		stateCache->BindTexture(*groundTexture);
 	}
 	else
 	{
-		openglFunctions->glDisable(GL_TEXTURE_2D);
+		stateCache->Disable(GL_TEXTURE_2D);
 		openglFunctions->glColor4fv(glm::value_ptr(groundColor));
-		openglFunctions->glBindTexture(GL_TEXTURE_2D, 0);
+		stateCache->BindTexture(0);
 	}
 
-	openglFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	stateCache->BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	DrawGroundQuad(openglFunctions, origin, groundLength, textureRepeatLength, textureOffset);
+	DrawGroundQuad(openglFunctions, stateCache, origin, groundLength, textureRepeatLength, textureOffset);
 
-	openglFunctions->glDisable(GL_BLEND);
+	stateCache->Disable(GL_BLEND);
 
 	if (bMirror)
 	{
-		openglFunctions->glCullFace(GL_BACK);
+		stateCache->CullFace(GL_BACK);
 		openglFunctions->glColor4f(0.1f, 0.1f, 0.1f, 1.0f);
-		openglFunctions->glBindTexture(GL_TEXTURE_2D, 0);
-		DrawGroundQuad(openglFunctions, origin, groundLength, textureRepeatLength, textureOffset);
+		stateCache->BindTexture(0);
+		DrawGroundQuad(openglFunctions, stateCache, origin, groundLength, textureRepeatLength, textureOffset);
 
-		openglFunctions->glFrontFace(GL_CCW);
+		stateCache->FrontFace(GL_CCW);
 	}
 
-	if (cullFaceWasEnabled)
-	{
-		openglFunctions->glEnable(GL_CULL_FACE);
-	}
-	else
-	{
-		openglFunctions->glDisable(GL_CULL_FACE);
-	}
+	stateCache->SetEnabled(GL_CULL_FACE, cullFaceWasEnabled);
 
-	openglFunctions->glCullFace(static_cast<GLenum>(oldCullFace));
+	stateCache->CullFace(oldCullFace);
 }
 
-unsigned int DrawMirroredModel(QOpenGLFunctions_1_1* openglFunctions,
+unsigned int DrawMirroredModel(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache,
 	studiomdl::IStudioModelRenderer& studioModelRenderer, StudioModelEntity* pEntity,
 	const RenderMode renderMode, const bool bWireframeOverlay, const glm::vec3& origin, const float groundLength, const bool bBackfaceCulling)
 {
-	GLint oldCullFace;
-
-	openglFunctions->glGetIntegerv(GL_CULL_FACE_MODE, &oldCullFace);
+	const GLenum oldCullFace = stateCache->GetCullFace();
 
 	/* Don't update color or depth. */
-	openglFunctions->glDisable(GL_DEPTH_TEST);
+	stateCache->Disable(GL_DEPTH_TEST);
 	openglFunctions->glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 
 	/* Draw 1 into the stencil buffer. */
-	openglFunctions->glEnable(GL_STENCIL_TEST);
+	stateCache->Enable(GL_STENCIL_TEST);
 	openglFunctions->glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 	openglFunctions->glStencilFunc(GL_ALWAYS, 1, 0xffffffff);
 
 	//Cull backside of the ground so the model can't draw underneath the ground
-	openglFunctions->glEnable(GL_CULL_FACE);
-	openglFunctions->glCullFace(GL_BACK);
+	stateCache->Enable(GL_CULL_FACE);
+	stateCache->CullFace(GL_BACK);
 
 	/* Now render ground; ground pixels just get their stencil set to 1. */
 	//Texture length is irrelevant here
-	DrawGroundQuad(openglFunctions, origin, groundLength, 1, glm::vec2{0});
+	DrawGroundQuad(openglFunctions, stateCache, origin, groundLength, 1, glm::vec2{0});
 
 	/* Re-enable update of color and depth. */
 	openglFunctions->glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-	openglFunctions->glEnable(GL_DEPTH_TEST);
+	stateCache->Enable(GL_DEPTH_TEST);
 
 	/* Now, only render where stencil is set to 1. */
 	openglFunctions->glStencilFunc(GL_EQUAL, 1, 0xffffffff);  /* draw if ==1 */
@@ -488,10 +467,10 @@ unsigned int DrawMirroredModel(QOpenGLFunctions_1_1* openglFunctions,
 
 	openglFunctions->glPushMatrix();
 	openglFunctions->glScalef(1, 1, -1);
-	openglFunctions->glCullFace(GL_BACK);
-	SetupRenderMode(openglFunctions, renderMode, bBackfaceCulling);
+	stateCache->CullFace(GL_BACK);
+	SetupRenderMode(stateCache, renderMode, bBackfaceCulling);
 
-	openglFunctions->glEnable(GL_CLIP_PLANE0);
+	stateCache->Enable(GL_CLIP_PLANE0);
 
 	/*
 	*	This defines a clipping plane that covers the ground. Any mirrored polygons will not be drawn above the ground.
@@ -511,7 +490,7 @@ unsigned int DrawMirroredModel(QOpenGLFunctions_1_1* openglFunctions,
 	//Determine if an odd number of scale values are negative. The cull face has to be changed if so.
 	const float flScale = vecScale.x * vecScale.y * vecScale.z;
 
-	openglFunctions->glCullFace(flScale > 0 ? GL_BACK : GL_FRONT);
+	stateCache->CullFace(flScale > 0 ? GL_BACK : GL_FRONT);
 
 	const unsigned int uiOldPolys = studioModelRenderer.GetDrawnPolygonsCount();
 
@@ -527,13 +506,13 @@ unsigned int DrawMirroredModel(QOpenGLFunctions_1_1* openglFunctions,
 
 	studioModelRenderer.DrawModel(renderInfo, flags);
 
-	openglFunctions->glDisable(GL_CLIP_PLANE0);
+	stateCache->Disable(GL_CLIP_PLANE0);
 
 	openglFunctions->glPopMatrix();
 
-	openglFunctions->glDisable(GL_STENCIL_TEST);
+	stateCache->Disable(GL_STENCIL_TEST);
 
-	openglFunctions->glCullFace(static_cast<GLenum>(oldCullFace));
+	stateCache->CullFace(oldCullFace);
 
 	return studioModelRenderer.GetDrawnPolygonsCount() - uiOldPolys;
 }
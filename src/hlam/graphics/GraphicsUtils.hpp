@@ -23,6 +23,8 @@ class IStudioModelRenderer;
 
 namespace graphics
 {
+class OpenGLStateCache;
+
 /**
 *	Converts an 8 bit image to a 24 bit RGB image.
 */
@@ -40,7 +42,7 @@ void FlipImageVertically(const int iWidth, const int iHeight, std::byte* const p
 *	Draws a background texture, fitted to the viewport.
 *	@param backgroundTexture OpenGL texture id that represents the background texture
 */
-void DrawBackground(QOpenGLFunctions_1_1* openglFunctions, GLuint backgroundTexture);
+void DrawBackground(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache, GLuint backgroundTexture);
 
 inline std::array<glm::vec3, 8> CreateBoxFromBounds(const glm::vec3& min, const glm::vec3& max)
 {
@@ -62,9 +64,9 @@ inline std::array<glm::vec3, 8> CreateBoxFromBounds(const glm::vec3& min, const
 /**
 *	Draws a box using an array of 8 vectors as corner points.
 */
-void DrawBox(QOpenGLFunctions_1_1* openglFunctions, const std::array<glm::vec3, 8>& points);
+void DrawBox(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache, const std::array<glm::vec3, 8>& points);
 
-void DrawOutlinedBox(QOpenGLFunctions_1_1* openglFunctions,
+void DrawOutlinedBox(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache,
 	const std::array<glm::vec3, 8>& points, const glm::vec4& faceColor, const glm::vec4& borderColor);
 
 /**
@@ -79,7 +81,7 @@ void PaletteHueReplace(RGBPalette& palette, int newHue, int start, int end);
 *	@param renderMode Render mode to set up. Must be valid.
 *	@param bBackfaceCulling Whether backface culling should be enabled or not.
 */
-void SetupRenderMode(QOpenGLFunctions_1_1* openglFunctions, RenderMode renderMode, const bool bBackfaceCulling);
+void SetupRenderMode(OpenGLStateCache* stateCache, RenderMode renderMode, const bool bBackfaceCulling);
 
 /**
 *	Draws a ground quad.
@@ -88,7 +90,7 @@ void SetupRenderMode(QOpenGLFunctions_1_1* openglFunctions, RenderMode renderMod
 *	@param textureRepeatLength Size of a texture repetition
 *	@param textureOffset Offset in units to shift the texture
 */
-void DrawGroundQuad(QOpenGLFunctions_1_1* openglFunctions, const glm::vec3& origin, float groundLength, float textureRepeatLength, glm::vec2 textureOffset);
+void DrawGroundQuad(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache, const glm::vec3& origin, float groundLength, float textureRepeatLength, glm::vec2 textureOffset);
 
 /**
 *	Draws a ground, optionally with a texture.
@@ -100,7 +102,7 @@ void DrawGroundQuad(QOpenGLFunctions_1_1* openglFunctions, const glm::vec3& orig
 *	@param groundColor		Color of the ground if no texture is specified
 *	@param bMirror			If true, draws a solid underside
 */
-void DrawGround(QOpenGLFunctions_1_1* openglFunctions, 
+void DrawGround(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache,
 	const glm::vec3& origin, float groundLength, float textureRepeatLength, const glm::vec2& textureOffset, std::optional<GLuint> groundTexture,
 	const glm::vec4& groundColor, const bool bMirror);
 
@@ -113,7 +115,7 @@ void DrawGround(QOpenGLFunctions_1_1* openglFunctions,
 *	@param groundLength			Length of one side of the ground
 *	@param bBackfaceCulling		Whether to perform backface culling or not
 */
-unsigned int DrawMirroredModel(QOpenGLFunctions_1_1* openglFunctions, 
+unsigned int DrawMirroredModel(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache,
 	studiomdl::IStudioModelRenderer& studioModelRenderer, StudioModelEntity* pEntity,
 	const RenderMode renderMode, const bool bWireframeOverlay, const glm::vec3& origin, const float groundLength, const bool bBackfaceCulling);
 }
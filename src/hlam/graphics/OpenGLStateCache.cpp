@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cstddef>
+
+#include <QOpenGLFunctions_1_1>
+
+#include "graphics/OpenGLStateCache.hpp"
+
+namespace graphics
+{
+namespace
+{
+template<std::size_t Size>
+std::optional<std::size_t> FindTrackedState(const std::array<GLenum, Size>& trackedStates, GLenum state)
+{
+	if (const auto it = std::find(trackedStates.begin(), trackedStates.end(), state); it != trackedStates.end())
+	{
+		return it - trackedStates.begin();
+	}
+
+	return {};
+}
+}
+
+OpenGLStateCache::OpenGLStateCache(QOpenGLFunctions_1_1* openglFunctions)
+	: _openglFunctions(openglFunctions)
+{
+}
+
+void OpenGLStateCache::Invalidate()
+{
+	_capabilities.fill({});
+	_clientStates.fill({});
+
+	_depthMask.reset();
+	_depthFunc.reset();
+	_blendFunc.reset();
+	_alphaFunc.reset();
+	_cullFace.reset();
+	_frontFace.reset();
+	_shadeModel.reset();
+	_polygonMode.reset();
+	_texture2D.reset();
+}
+
+template<typename T>
+bool OpenGLStateCache::ShouldChange(std::optional<T>& cached, const T& value)
+{
+	if (cached == value)
+	{
+		++_avoidedCallCount;
+		return false;
+	}
+
+	cached = value;
+	++_stateChangeCount;
+	return true;
+}
+
+void OpenGLStateCache::SetEnabled(GLenum cap, bool enabled)
+{
+	if (const auto index = FindTrackedState(TrackedCapabilities, cap); index)
+	{
+		if (!ShouldChange(_capabilities[*index], enabled))
+		{
+			return;
+		}
+	}
+	else
+	{
+		++_stateChangeCount;
+	}
+
+	if (enabled)
+	{
+		_openglFunctions->glEnable(cap);
+	}
+	else
+	{
+		_openglFunctions->glDisable(cap);
+	}
+}
+
+bool OpenGLStateCache::IsEnabled(GLenum cap)
+{
+	const auto index = FindTrackedState(TrackedCapabilities, cap);
+
+	if (index && _capabilities[*index])
+	{
+		++_avoidedCallCount;
+		return *_capabilities[*index];
+	}
+
+	const bool enabled = _openglFunctions->glIsEnabled(cap) != GL_FALSE;
+
+	if (index)
+	{
+		_capabilities[*index] = enabled;
+	}
+
+	return enabled;
+}
+
+void OpenGLStateCache::SetClientStateEnabled(GLenum array, bool enabled)
+{
+	if (const auto index = FindTrackedState(TrackedClientStates, array); index)
+	{
+		if (!ShouldChange(_clientStates[*index], enabled))
+		{
+			return;
+		}
+	}
+	else
+	{
+		++_stateChangeCount;
+	}
+
+	if (enabled)
+	{
+		_openglFunctions->glEnableClientState(array);
+	}
+	else
+	{
+		_openglFunctions->glDisableClientState(array);
+	}
+}
+
+void OpenGLStateCache::DepthMask(GLboolean flag)
+{
+	// Any non-zero value enables depth writes.
+	if (ShouldChange(_depthMask, static_cast<GLboolean>(flag != GL_FALSE ? GL_TRUE : GL_FALSE)))
+	{
+		_openglFunctions->glDepthMask(flag);
+	}
+}
+
+GLboolean OpenGLStateCache::GetDepthMask()
+{
+	if (_depthMask)
+	{
+		++_avoidedCallCount;
+		return *_depthMask;
+	}
+
+	GLboolean flag = GL_TRUE;
+	_openglFunctions->glGetBooleanv(GL_DEPTH_WRITEMASK, &flag);
+	_depthMask = flag;
+
+	return flag;
+}
+
+void OpenGLStateCache::DepthFunc(GLenum func)
+{
+	if (ShouldChange(_depthFunc, func))
+	{
+		_openglFunctions->glDepthFunc(func);
+	}
+}
+
+void OpenGLStateCache::BlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	if (ShouldChange(_blendFunc, std::pair{sfactor, dfactor}))
+	{
+		_openglFunctions->glBlendFunc(sfactor, dfactor);
+	}
+}
+
+void OpenGLStateCache::AlphaFunc(GLenum func, GLclampf ref)
+{
+	if (ShouldChange(_alphaFunc, std::pair{func, ref}))
+	{
+		_openglFunctions->glAlphaFunc(func, ref);
+	}
+}
+
+void OpenGLStateCache::CullFace(GLenum mode)
+{
+	if (ShouldChange(_cullFace, mode))
+	{
+		_openglFunctions->glCullFace(mode);
+	}
+}
+
+GLenum OpenGLStateCache::GetCullFace()
+{
+	if (_cullFace)
+	{
+		++_avoidedCallCount;
+		return *_cullFace;
+	}
+
+	GLint mode = GL_BACK;
+	_openglFunctions->glGetIntegerv(GL_CULL_FACE_MODE, &mode);
+	_cullFace = static_cast<GLenum>(mode);
+
+	return *_cullFace;
+}
+
+void OpenGLStateCache::FrontFace(GLenum mode)
+{
+	if (ShouldChange(_frontFace, mode))
+	{
+		_openglFunctions->glFrontFace(mode);
+	}
+}
+
+void OpenGLStateCache::ShadeModel(GLenum mode)
+{
+	if (ShouldChange(_shadeModel, mode))
+	{
+		_openglFunctions->glShadeModel(mode);
+	}
+}
+
+void OpenGLStateCache::PolygonMode(GLenum mode)
+{
+	if (ShouldChange(_polygonMode, mode))
+	{
+		_openglFunctions->glPolygonMode(GL_FRONT_AND_BACK, mode);
+	}
+}
+
+void OpenGLStateCache::BindTexture(GLuint texture)
+{
+	if (ShouldChange(_texture2D, texture))
+	{
+		++_textureBindCount;
+		_openglFunctions->glBindTexture(GL_TEXTURE_2D, texture);
+	}
+}
+}
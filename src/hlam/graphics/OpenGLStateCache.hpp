@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include <qopengl.h>
+
+class QOpenGLFunctions_1_1;
+
+namespace graphics
+{
+/**
+*	@brief Tracks OpenGL state to filter out redundant state changes and to avoid querying state from the driver.
+*	All code that draws a scene should change the tracked state through this object.
+*	State is per context and may be changed by code that doesn't use the cache (e.g. texture uploads),
+*	so the cache must be invalidated before drawing each frame.
+*/
+class OpenGLStateCache final
+{
+public:
+	explicit OpenGLStateCache(QOpenGLFunctions_1_1* openglFunctions);
+
+	OpenGLStateCache(const OpenGLStateCache&) = delete;
+	OpenGLStateCache& operator=(const OpenGLStateCache&) = delete;
+
+	/**
+	*	@brief Forgets all cached state. The next change made to each piece of state is always passed to OpenGL.
+	*/
+	void Invalidate();
+
+	/**
+	*	@brief Number of state changes passed on to OpenGL since the counters were last reset
+	*/
+	unsigned int GetStateChangeCount() const { return _stateChangeCount; }
+
+	/**
+	*	@brief Number of redundant state changes and state queries filtered out since the counters were last reset
+	*/
+	unsigned int GetAvoidedCallCount() const { return _avoidedCallCount; }
+
+	/**
+	*	@brief Number of texture binds passed on to OpenGL since the counters were last reset
+	*/
+	unsigned int GetTextureBindCount() const { return _textureBindCount; }
+
+	/**
+	*	@brief Number of draw calls made since the counters were last reset
+	*/
+	unsigned int GetDrawCallCount() const { return _drawCallCount; }
+
+	/**
+	*	@brief Number of vertices submitted by draw calls since the counters were last reset
+	*/
+	unsigned int GetVerticesSubmittedCount() const { return _verticesSubmittedCount; }
+
+	/**
+	*	@brief Records a draw call for the statistics. Draw calls aren't made through the cache,
+	*	so code that draws must call this after each glDrawArrays, glDrawElements, glBegin/glEnd pair and glRect.
+	*/
+	void CountDrawCall(std::size_t vertexCount)
+	{
+		++_drawCallCount;
+		_verticesSubmittedCount += static_cast<unsigned int>(vertexCount);
+	}
+
+	void ResetCounters()
+	{
+		_stateChangeCount = 0;
+		_avoidedCallCount = 0;
+		_textureBindCount = 0;
+		_drawCallCount = 0;
+		_verticesSubmittedCount = 0;
+	}
+
+	void Enable(GLenum cap) { SetEnabled(cap, true); }
+
+	void Disable(GLenum cap) { SetEnabled(cap, false); }
+
+	void SetEnabled(GLenum cap, bool enabled);
+
+	/**
+	*	@brief Returns whether the given capability is enabled, only querying OpenGL if the state isn't known
+	*/
+	bool IsEnabled(GLenum cap);
+
+	void EnableClientState(GLenum array) { SetClientStateEnabled(array, true); }
+
+	void DisableClientState(GLenum array) { SetClientStateEnabled(array, false); }
+
+	void SetClientStateEnabled(GLenum array, bool enabled);
+
+	void DepthMask(GLboolean flag);
+
+	/**
+	*	@brief Returns the depth write mask, only querying OpenGL if the state isn't known
+	*/
+	GLboolean GetDepthMask();
+
+	void DepthFunc(GLenum func);
+
+	void BlendFunc(GLenum sfactor, GLenum dfactor);
+
+	void AlphaFunc(GLenum func, GLclampf ref);
+
+	void CullFace(GLenum mode);
+
+	/**
+	*	@brief Returns the cull face mode, only querying OpenGL if the state isn't known
+	*/
+	GLenum GetCullFace();
+
+	void FrontFace(GLenum mode);
+
+	void ShadeModel(GLenum mode);
+
+	/**
+	*	@brief Sets the polygon mode for both front and back faces
+	*/
+	void PolygonMode(GLenum mode);
+
+	/**
+	*	@brief Binds a texture to the GL_TEXTURE_2D target
+	*/
+	void BindTexture(GLuint texture);
+
+private:
+	template<typename T>
+	bool ShouldChange(std::optional<T>& cached, const T& value);
+
+	static constexpr std::array TrackedCapabilities{
+		GLenum{GL_ALPHA_TEST},
+		GLenum{GL_BLEND},
+		GLenum{GL_CLIP_PLANE0},
+		GLenum{GL_CULL_FACE},
+		GLenum{GL_DEPTH_TEST},
+		GLenum{GL_LINE_SMOOTH},
+		GLenum{GL_STENCIL_TEST},
+		GLenum{GL_TEXTURE_2D}
+	};
+
+	static constexpr std::array TrackedClientStates{
+		GLenum{GL_COLOR_ARRAY},
+		GLenum{GL_NORMAL_ARRAY},
+		GLenum{GL_TEXTURE_COORD_ARRAY},
+		GLenum{GL_VERTEX_ARRAY}
+	};
+
+	QOpenGLFunctions_1_1* const _openglFunctions;
+
+	unsigned int _stateChangeCount{0};
+	unsigned int _avoidedCallCount{0};
+	unsigned int _textureBindCount{0};
+	unsigned int _drawCallCount{0};
+	unsigned int _verticesSubmittedCount{0};
+
+	std::array<std::optional<bool>, TrackedCapabilities.size()> _capabilities;
+	std::array<std::optional<bool>, TrackedClientStates.size()> _clientStates;
+
+	std::optional<GLboolean> _depthMask;
+	std::optional<GLenum> _depthFunc;
+	std::optional<std::pair<GLenum, GLenum>> _blendFunc;
+	std::optional<std::pair<GLenum, GLclampf>> _alphaFunc;
+	std::optional<GLenum> _cullFace;
+	std::optional<GLenum> _frontFace;
+	std::optional<GLenum> _shadeModel;
+	std::optional<GLenum> _polygonMode;
+	std::optional<GLuint> _texture2D;
+};
+}
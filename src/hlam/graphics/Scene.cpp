@@ -12,8 +12,12 @@
 #include "formats/studiomodel/IStudioModelRenderer.hpp"
 
 #include "graphics/OpenGL.hpp"
+#include "graphics/OpenGLStateCache.hpp"
 #include "graphics/Scene.hpp"
 #include "graphics/SceneContext.hpp"
+#include "graphics/TextureLoader.hpp"
+
+#include "utility/Profiling.hpp"
 
 #include "settings/ApplicationSettings.hpp"
 #include "settings/ColorSettings.hpp"
@@ -54,7 +58,7 @@ Scene::Scene(std::string&& name, EntityContext* entityContext)
 {
 	SetCurrentCamera(nullptr);
 
-	SkyLight.Color = _entityContext->Asset->GetApplication()->GetColorSettings()->GetColor(studiomodel::SkyLightColor);
+	_skyLight.Color = _entityContext->Asset->GetApplication()->GetColorSettings()->GetColor(studiomodel::SkyLightColor);
 }
 
 Scene::~Scene() = default;
@@ -80,8 +84,43 @@ void Scene::Tick()
 	_entityList->RunFrame();
 }
 
+void Scene::Invalidate()
+{
+	_invalidated = true;
+	_entityContext->Asset->GetApplication()->WakeTimer();
+}
+
+bool Scene::NeedsRedraw()
+{
+	if (_invalidated || _entityList->HasChanged())
+	{
+		return true;
+	}
+
+	const auto camera = _currentCamera->GetCamera();
+
+	if (_lastCamera != _currentCamera
+		|| _lastViewMatrix != camera->GetViewMatrix()
+		|| _lastProjectionMatrix != camera->GetProjectionMatrix())
+	{
+		return true;
+	}
+
+	return IsAnimating();
+}
+
+bool Scene::IsAnimating() const
+{
+	return std::any_of(_entityList->begin(), _entityList->end(), [](const auto& entity)
+		{
+			return entity->IsAnimating();
+		});
+}
+
 void Scene::Draw(SceneContext& sc)
 {
+	HLAM_PROFILE_SCOPE("Scene::Draw");
+
 	auto applicationSettings = _entityContext->AppSettings;
 	auto colors = _entityContext->Asset->GetApplication()->GetColorSettings();
 
@@ -95,17 +134,31 @@ void Scene::Draw(SceneContext& sc)
 
 	sc.OpenGLFunctions->glViewport(0, 0, _windowWidth, _windowHeight);
 
-	sc.OpenGLFunctions->glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	// The context may have been used by code that doesn't track state since the last frame.
+	// Counters are reset so they cover a single frame.
+	sc.StateCache->Invalidate();
+	sc.StateCache->ResetCounters();
+
+	sc.StateCache->PolygonMode(GL_FILL);
 
 	_drawnPolygonsCount = 0;
 
 	auto camera = GetCurrentCamera()->GetCamera();
 
+	// Cleared before drawing so changes made while drawing cause another redraw.
+	_invalidated = false;
+	_entityList->ClearChanged();
+
+	_lastCamera = _currentCamera;
+	_lastViewMatrix = camera->GetViewMatrix();
+	_lastProjectionMatrix = camera->GetProjectionMatrix();
+
 	_entityContext->StudioModelRenderer->SetViewerOrigin(camera->GetOrigin());
 	_entityContext->StudioModelRenderer->SetViewerRight(camera->GetRightVector());
-	_entityContext->StudioModelRenderer->SetSkyLight(SkyLight);
+	_entityContext->StudioModelRenderer->SetSkyLight(_skyLight);
 
 	const unsigned int uiOldPolys = _entityContext->StudioModelRenderer->GetDrawnPolygonsCount();
+	const RendererStatistics oldRendererStatistics = _entityContext->StudioModelRenderer->GetStatistics();
 
 	DrawRenderables(sc, RenderPass::Background);
 
@@ -129,6 +182,21 @@ void Scene::Draw(SceneContext& sc)
 	DrawRenderables(sc, RenderPass::Overlay2D);
 
 	_drawnPolygonsCount = _entityContext->StudioModelRenderer->GetDrawnPolygonsCount() - uiOldPolys;
+
+	const auto& rendererStatistics = _entityContext->StudioModelRenderer->GetStatistics();
+	const std::uint64_t uploadedBytesCount = sc.TexLoader->GetUploadedBytesCount();
+
+	_frameStatistics.DrawCalls = sc.StateCache->GetDrawCallCount();
+	_frameStatistics.VerticesSubmitted = sc.StateCache->GetVerticesSubmittedCount();
+	_frameStatistics.DrawnPolygons = _drawnPolygonsCount;
+	_frameStatistics.StateChanges = sc.StateCache->GetStateChangeCount();
+	_frameStatistics.AvoidedStateChanges = sc.StateCache->GetAvoidedCallCount();
+	_frameStatistics.TextureBinds = sc.StateCache->GetTextureBindCount();
+	_frameStatistics.BytesUploaded = uploadedBytesCount - _lastUploadedBytesCount;
+	_frameStatistics.BoneSetups = rendererStatistics.BoneSetups - oldRendererStatistics.BoneSetups;
+	_frameStatistics.SkinnedVertices = rendererStatistics.SkinnedVertices - oldRendererStatistics.SkinnedVertices;
+
+	_lastUploadedBytesCount = uploadedBytesCount;
 }
 
 void Scene::CollectRenderables(RenderPass::RenderPass renderPass, std::vector<BaseEntity*>& renderablesToRender)
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "graphics/Camera.hpp"
+#include "graphics/FrameStatistics.hpp"
 #include "graphics/GraphicsConstants.hpp"
 #include "graphics/Light.hpp"
 
@@ -62,6 +64,35 @@ public:
 
 	unsigned int GetDrawnPolygonsCount() const { return _drawnPolygonsCount; }
 
+	/**
+	*	@brief Statistics about the work done to draw the last frame
+	*/
+	const FrameStatistics& GetFrameStatistics() const { return _frameStatistics; }
+
+	const Light& GetSkyLight() const { return _skyLight; }
+
+	void SetSkyLight(const Light& light)
+	{
+		_skyLight = light;
+		Invalidate();
+	}
+
+	/**
+	*	@brief Marks the scene as needing to be redrawn.
+	*	Changes to entities and cameras are detected automatically.
+	*/
+	void Invalidate();
+
+	/**
+	*	@brief Whether anything has changed since the scene was last drawn, or any entity is animating.
+	*/
+	bool NeedsRedraw();
+
+	/**
+	*	@brief Whether any entity is animating, and thus changes on its own every frame.
+	*/
+	bool IsAnimating() const;
+
 	void CreateDeviceObjects(SceneContext& sc);
 
 	void DestroyDeviceObjects(SceneContext& sc);
@@ -75,9 +106,6 @@ private:
 
 	void DrawRenderables(SceneContext& sc, RenderPass::RenderPass renderPass);
 
-public:
-	Light SkyLight;
-
 private:
 	const std::string _name;
 
@@ -87,12 +115,24 @@ private:
 
 	const std::unique_ptr<ICameraOperator> _defaultCameraOperator;
 
+	Light _skyLight;
+
 	ICameraOperator* _currentCamera{};
 
 	unsigned int _windowWidth = 0, _windowHeight = 0;
 
 	unsigned int _drawnPolygonsCount = 0;
 
+	bool _invalidated = true;
+
+	// State of the camera used to draw the last frame.
+	ICameraOperator* _lastCamera{};
+	glm::mat4x4 _lastViewMatrix{1.f};
+	glm::mat4x4 _lastProjectionMatrix{1.f};
+
+	FrameStatistics _frameStatistics;
+	std::uint64_t _lastUploadedBytesCount = 0;
+
 	std::vector<BaseEntity*> _renderablesToRender;
 };
 }
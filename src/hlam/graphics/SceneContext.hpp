@@ -4,6 +4,7 @@ class QOpenGLFunctions_1_1;
 
 namespace graphics
 {
+class OpenGLStateCache;
 class TextureLoader;
 
 /**
@@ -12,14 +13,16 @@ class TextureLoader;
 class SceneContext final
 {
 public:
-	SceneContext(QOpenGLFunctions_1_1* openglFunctions, TextureLoader* textureLoader)
+	SceneContext(QOpenGLFunctions_1_1* openglFunctions, OpenGLStateCache* stateCache, TextureLoader* textureLoader)
 		: OpenGLFunctions(openglFunctions)
+		, StateCache(stateCache)
 		, TexLoader(textureLoader)
 	{
 
 	}
 
 	QOpenGLFunctions_1_1* const OpenGLFunctions;
+	OpenGLStateCache* const StateCache;
 	TextureLoader* const TexLoader;
 
 	int WindowWidth = 0;
@@ -8,6 +8,8 @@
 #include "graphics/Palette.hpp"
 #include "graphics/TextureLoader.hpp"
 
+#include "utility/Profiling.hpp"
+
 namespace graphics
 {
 TextureLoader::TextureLoader(QOpenGLFunctions_1_1* openglFunctions)
@@ -93,6 +95,8 @@ void TextureLoader::DeleteTexture(GLuint texture)
 
 void TextureLoader::UploadRGBA8888(GLuint texture, int width, int height, const std::byte* rgbaPixels, bool generateMipmaps, bool masked)
 {
+	HLAM_PROFILE_SCOPE("TextureLoader::UploadRGBA8888");
+
 	const auto [newWidth, newHeight] = AdjustImageDimensions(width, height);
 
 	std::vector<std::byte> pixels;
@@ -154,6 +158,7 @@ void TextureLoader::UploadRGBA8888(GLuint texture, int width, int height, const
 
 	_openglFunctions->glBindTexture(GL_TEXTURE_2D, texture);
 	_openglFunctions->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, newWidth, newHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+	_uploadedBytesCount += static_cast<std::uint64_t>(newWidth) * newHeight * 4;
 	SetFilters(texture, generateMipmaps);
 
 	if (generateMipmaps)
@@ -163,6 +168,15 @@ void TextureLoader::UploadRGBA8888(GLuint texture, int width, int height, const
 }
 
 void TextureLoader::UploadIndexed8(GLuint texture, int width, int height, const std::byte* pixels, const RGBPalette& palette, bool generateMipmaps, bool masked)
+{
+	HLAM_PROFILE_SCOPE("TextureLoader::UploadIndexed8");
+
+	const std::vector<std::byte> rgbaPixels = ConvertIndexed8ToRGBA8888(width, height, pixels, palette, masked);
+
+	UploadRGBA8888(texture, width, height, rgbaPixels.data(), generateMipmaps, masked);
+}
+
+std::vector<std::byte> TextureLoader::ConvertIndexed8ToRGBA8888(int width, int height, const std::byte* pixels, const RGBPalette& palette, bool masked)
 {
 	//TODO: total size can be too large
 	RGBPalette localPalette{palette};
@@ -195,7 +209,7 @@ void TextureLoader::UploadIndexed8(GLuint texture, int width, int height, const
 		}
 	}
 
-	UploadRGBA8888(texture, width, height, rgbaPixels.data(), generateMipmaps, masked);
+	return rgbaPixels;
 }
 
 void TextureLoader::SetFilters(GLuint texture, bool hasMipmaps)
@@ -253,6 +267,7 @@ void TextureLoader::GenerateMipmaps(int width, int height, const std::byte* pixe
 
 		_openglFunctions->glTexImage2D(
 			GL_TEXTURE_2D, ++mipLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rescaledPixels.data());
+		_uploadedBytesCount += static_cast<std::uint64_t>(width) * height * 4;
 	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
@@ -57,8 +58,19 @@ public:
 
 	void UploadIndexed8(GLuint texture, int width, int height, const std::byte* pixels, const RGBPalette& palette, bool generateMipmaps, bool masked);
 
+	/**
+	*	@brief Converts indexed pixels to the RGBA data uploaded by UploadIndexed8.
+	*	Does not use OpenGL so textures can be converted ahead of time on another thread.
+	*/
+	static std::vector<std::byte> ConvertIndexed8ToRGBA8888(int width, int height, const std::byte* pixels, const RGBPalette& palette, bool masked);
+
 	void SetFilters(GLuint texture, bool hasMipmaps);
 
+	/**
+	*	@brief Total number of bytes of texture data uploaded since the loader was created
+	*/
+	std::uint64_t GetUploadedBytesCount() const { return _uploadedBytesCount; }
+
 private:
 	std::pair<int, int> AdjustImageDimensions(int width, int height) const;
 
@@ -77,5 +89,7 @@ private:
 	GLint _glMagFilter;
 
 	bool _resizeToPowerOf2{true};
+
+	std::uint64_t _uploadedBytesCount{0};
 };
 }
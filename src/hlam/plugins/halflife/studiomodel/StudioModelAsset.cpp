@@ -125,6 +125,17 @@ StudioModelAsset::StudioModelAsset(QString&& fileName,
 
 	connect(this, &StudioModelAsset::FileNameChanged, this, &StudioModelAsset::UpdateFileSystem);
 
+	// Model edits are made through undo commands, so this lets anything derived from the model detect changes.
+	connect(GetUndoStack(), &QUndoStack::indexChanged, this, [this]
+		{
+			_editableStudioModel->MarkEdited();
+
+			for (auto scene : _scenes)
+			{
+				scene->Invalidate();
+			}
+		});
+
 	connect(_application->GetApplicationSettings(), &ApplicationSettings::ResizeTexturesToPowerOf2Changed,
 		this, &StudioModelAsset::OnResizeTexturesToPowerOf2Changed);
 	connect(_application->GetApplicationSettings(), &ApplicationSettings::TextureFiltersChanged,
@@ -132,7 +143,8 @@ StudioModelAsset::StudioModelAsset(QString&& fileName,
 
 	// Initialize graphics resources.
 	{
-		graphics::SceneContext sc{_application->GetOpenGLFunctions(), _application->GetTextureLoader()};
+		graphics::SceneContext sc{
+			_application->GetOpenGLFunctions(), _application->GetOpenGLStateCache(), _application->GetTextureLoader()};
 
 		auto context = _application->GetGraphicsContext();
 		context->Begin();
@@ -151,7 +163,8 @@ StudioModelAsset::StudioModelAsset(QString&& fileName,
 StudioModelAsset::~StudioModelAsset()
 {
 	{
-		graphics::SceneContext sc{_application->GetOpenGLFunctions(), _application->GetTextureLoader()};
+		graphics::SceneContext sc{
+			_application->GetOpenGLFunctions(), _application->GetOpenGLStateCache(), _application->GetTextureLoader()};
 
 		auto context = _application->GetGraphicsContext();
 
@@ -218,12 +231,16 @@ bool StudioModelAsset::TryRefresh()
 		const auto filePath = std::filesystem::u8path(GetFileName().toStdString());
 		auto studioModel = studiomdl::LoadStudioModel(filePath, nullptr, *_fileSystem);
 
-		auto newModel = std::make_unique<studiomdl::EditableStudioModel>(studiomdl::ConvertToEditable(*studioModel));
+		auto newModel = std::make_unique<studiomdl::EditableStudioModel>(
+			studiomdl::ConvertToEditableWithLazyAnimations(*studioModel));
+
+		studioModel.reset();
 
 		// Clear UI to null state so changes to the models don't trigger changes in UI slots.
 		emit _provider->AssetChanged(_provider->GetDummyAsset());
 
-		graphics::SceneContext sc{_application->GetOpenGLFunctions(), _application->GetTextureLoader()};
+		graphics::SceneContext sc{
+			_application->GetOpenGLFunctions(), _application->GetOpenGLStateCache(), _application->GetTextureLoader()};
 
 		auto context = _application->GetGraphicsContext();
 		context->Begin();
@@ -542,7 +559,7 @@ bool StudioModelAsset::HandleMouseInput(QMouseEvent* event)
 		}
 		else
 		{
-			glm::vec3 direction = GetScene()->SkyLight.Direction;
+			glm::vec3 direction = GetScene()->GetSkyLight().Direction;
 
 			const float DELTA = 0.05f;
 
@@ -588,7 +605,9 @@ bool StudioModelAsset::HandleMouseInput(QMouseEvent* event)
 				direction.y = std::clamp(direction.y, -1.0f, 1.0f);
 			}
 
-			GetScene()->SkyLight.Direction = direction;
+			graphics::Light skyLight = GetScene()->GetSkyLight();
+			skyLight.Direction = direction;
+			GetScene()->SetSkyLight(skyLight);
 
 			emit GetModelData()->SkyLightChanged();
 		}
@@ -599,6 +618,11 @@ bool StudioModelAsset::HandleMouseInput(QMouseEvent* event)
 	return false;
 }
 
+void StudioModelAsset::OnRenderOptionChanged()
+{
+	_scene->Invalidate();
+}
+
 void StudioModelAsset::Tick()
 {
 	//TODO: update asset-local world time
@@ -702,4 +726,23 @@ void StudioModelAsset::OnFlipNormals()
 {
 	AddUndoCommand(new FlipNormalsCommand(this));
 }
+
+void StudioModelAsset::OnRecomputeSequenceBBoxes()
+{
+	std::vector<std::pair<glm::vec3, glm::vec3>> bboxes;
+
+	try
+	{
+		bboxes = studiomdl::ComputeSequenceBBoxes(*_editableStudioModel);
+	}
+	catch (const AssetException& e)
+	{
+		QMessageBox::critical(nullptr, "Error",
+			QString{"An error occurred while recomputing sequence bounds:\n%1"}.arg(e.what()));
+		return;
+	}
+
+	AddUndoCommand(new RecomputeSequenceBBoxesCommand(
+		this, studiomdl::GetScaleSequenceBBoxesData(*_editableStudioModel), std::move(bboxes)));
+}
 }
@@ -135,6 +135,118 @@ public:
 
 	TextureCameraOperator* GetTextureCameraOperator() { return _textureCameraOperator.get(); }
 
+	RenderMode GetCurrentRenderMode() const { return _currentRenderMode; }
+
+	void SetCurrentRenderMode(RenderMode value)
+	{
+		_currentRenderMode = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldShowHitboxes() const { return _showHitboxes; }
+
+	void SetShowHitboxes(bool value)
+	{
+		_showHitboxes = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldShowBones() const { return _showBones; }
+
+	void SetShowBones(bool value)
+	{
+		_showBones = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldShowAttachments() const { return _showAttachments; }
+
+	void SetShowAttachments(bool value)
+	{
+		_showAttachments = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldShowEyePosition() const { return _showEyePosition; }
+
+	void SetShowEyePosition(bool value)
+	{
+		_showEyePosition = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldEnableBackfaceCulling() const { return _enableBackfaceCulling; }
+
+	void SetEnableBackfaceCulling(bool value)
+	{
+		_enableBackfaceCulling = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldShowWireframeOverlay() const { return _showWireframeOverlay; }
+
+	void SetShowWireframeOverlay(bool value)
+	{
+		_showWireframeOverlay = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldDrawShadows() const { return _drawShadows; }
+
+	void SetDrawShadows(bool value)
+	{
+		_drawShadows = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldFixShadowZFighting() const { return _fixShadowZFighting; }
+
+	void SetFixShadowZFighting(bool value)
+	{
+		_fixShadowZFighting = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldShowNormals() const { return _showNormals; }
+
+	void SetShowNormals(bool value)
+	{
+		_showNormals = value;
+		OnRenderOptionChanged();
+	}
+
+	int GetDrawSingleBoneIndex() const { return _drawSingleBoneIndex; }
+
+	void SetDrawSingleBoneIndex(int value)
+	{
+		_drawSingleBoneIndex = value;
+		OnRenderOptionChanged();
+	}
+
+	int GetDrawSingleAttachmentIndex() const { return _drawSingleAttachmentIndex; }
+
+	void SetDrawSingleAttachmentIndex(int value)
+	{
+		_drawSingleAttachmentIndex = value;
+		OnRenderOptionChanged();
+	}
+
+	int GetDrawSingleHitboxIndex() const { return _drawSingleHitboxIndex; }
+
+	void SetDrawSingleHitboxIndex(int value)
+	{
+		_drawSingleHitboxIndex = value;
+		OnRenderOptionChanged();
+	}
+
+	bool ShouldPlaySequence() const { return _playSequence; }
+
+	void SetPlaySequence(bool value)
+	{
+		_playSequence = value;
+		OnRenderOptionChanged();
+	}
+
 	Pose GetPose() const { return _pose; }
 
 	void UpdateSettingsState();
@@ -150,6 +262,8 @@ public:
 
 	void OnFlipNormals();
 
+	void OnRecomputeSequenceBBoxes();
+
 private:
 	void CreateMainScene();
 	void CreateTextureScene();
@@ -159,6 +273,8 @@ private:
 
 	bool HandleMouseInput(QMouseEvent* event);
 
+	void OnRenderOptionChanged();
+
 signals:
 	void SaveSnapshot(StateSnapshot* snapshot);
 
@@ -188,26 +304,6 @@ private slots:
 
 	void OnCameraChanged(SceneCameraOperator* previous, SceneCameraOperator* current);
 
-public:
-	RenderMode CurrentRenderMode = RenderMode::TEXTURE_SHADED;
-
-	bool ShowHitboxes = false;
-	bool ShowBones = false;
-	bool ShowAttachments = false;
-	bool ShowEyePosition = false;
-
-	bool EnableBackfaceCulling = true;
-	bool ShowWireframeOverlay = false;
-	bool DrawShadows = false;
-	bool FixShadowZFighting = false;
-	bool ShowNormals = false;
-
-	int DrawSingleBoneIndex = -1;
-	int DrawSingleAttachmentIndex = -1;
-	int DrawSingleHitboxIndex = -1;
-
-	bool PlaySequence = true;
-
 private:
 	AssetManager* const _application;
 	StudioModelAssetProvider* const _provider;
@@ -255,5 +351,24 @@ private:
 	Pose _pose = Pose::Sequences;
 
 	glm::vec2 _lightVectorCoordinates{0};
+
+	RenderMode _currentRenderMode = RenderMode::TEXTURE_SHADED;
+
+	bool _showHitboxes = false;
+	bool _showBones = false;
+	bool _showAttachments = false;
+	bool _showEyePosition = false;
+
+	bool _enableBackfaceCulling = true;
+	bool _showWireframeOverlay = false;
+	bool _drawShadows = false;
+	bool _fixShadowZFighting = false;
+	bool _showNormals = false;
+
+	int _drawSingleBoneIndex = -1;
+	int _drawSingleAttachmentIndex = -1;
+	int _drawSingleHitboxIndex = -1;
+
+	bool _playSequence = true;
 };
 }
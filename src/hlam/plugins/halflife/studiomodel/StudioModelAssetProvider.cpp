@@ -11,6 +11,8 @@
 #include <QSettings>
 #include <QSignalBlocker>
 
+#include <glm/gtc/type_ptr.hpp>
+
 #include "application/AssetList.hpp"
 #include "application/AssetManager.hpp"
 
@@ -22,8 +24,10 @@
 #include "formats/studiomodel/StudioModelRenderer.hpp"
 #include "formats/studiomodel/StudioModelUtils.hpp"
 
+#include "graphics/Camera.hpp"
 #include "graphics/IGraphicsContext.hpp"
 #include "graphics/Palette.hpp"
+#include "graphics/SceneContext.hpp"
 
 #include "plugins/halflife/studiomodel/StudioModelAsset.hpp"
 #include "plugins/halflife/studiomodel/StudioModelAssetProvider.hpp"
@@ -65,10 +69,11 @@ StudioModelAssetProvider::StudioModelAssetProvider(AssetManager* application,
 
 	, _studioModelRenderer(std::make_unique<studiomdl::StudioModelRenderer>(
 		CreateQtLoggerSt(HLAMStudioModelRenderer()),
-		_application->GetOpenGLFunctions(), _application->GetColorSettings()))
+		_application->GetOpenGLFunctions(), _application->GetOpenGLStateCache(), _application->GetColorSettings()))
 
 	, _spriteRenderer(std::make_unique<sprite::SpriteRenderer>(
-		CreateQtLoggerSt(HLAMSpriteRenderer()), _application->GetWorldTime()))
+		CreateQtLoggerSt(HLAMSpriteRenderer()), _application->GetOpenGLFunctions(), _application->GetOpenGLStateCache(),
+		_application->GetWorldTime()))
 
 	, _dummyAsset(std::make_unique<StudioModelAsset>(
 		"", _application, this, _settingsVersion,
@@ -244,6 +249,15 @@ void StudioModelAssetProvider::PopulateAssetMenu(QMenu* menu)
 	_timelineVisibleAction->setCheckable(true);
 	_timelineVisibleAction->setChecked(GetEditWidget()->IsTimelineVisible());
 
+	_renderStatisticsVisibleAction = menu->addAction("Show Render Statistics", this, [this](bool checked)
+		{
+			GetEditWidget()->SetRenderStatisticsVisible(checked);
+			_studioModelSettings->SetRenderStatisticsVisible(checked);
+		});
+
+	_renderStatisticsVisibleAction->setCheckable(true);
+	_renderStatisticsVisibleAction->setChecked(GetEditWidget()->AreRenderStatisticsVisible());
+
 	{
 		_editControlsVisibleAction = menu->addAction("Show Edit Controls", this,
 			[this](bool checked)
@@ -330,6 +344,8 @@ void StudioModelAssetProvider::PopulateAssetMenu(QMenu* menu)
 
 	menu->addAction("Flip Normals", this, [this]() { GetCurrentAsset()->OnFlipNormals(); });
 
+	menu->addAction("Recompute Sequence Bounds", this, [this]() { GetCurrentAsset()->OnRecomputeSequenceBBoxes(); });
+
 	menu->addSeparator();
 
 	menu->addAction("Show QC Data", this, [this]
@@ -350,60 +366,116 @@ bool StudioModelAssetProvider::CanLoad(const QString& fileName, FILE* file) cons
 
 AssetLoadData StudioModelAssetProvider::Load(const QString& fileName, FILE* file)
 {
-	const auto filePath = std::filesystem::u8path(fileName.toStdString());
-
 	auto fileSystem = std::make_unique<FileSystem>();
 	_application->InitializeFileSystem(*fileSystem, fileName);
 
-	auto studioModel = studiomdl::LoadStudioModel(filePath, file, *fileSystem);
+	AssetLoadProgress progress;
+
+	return LoadInBackground(fileName, file, std::move(fileSystem), progress)();
+}
+
+namespace
+{
+/**
+*	@brief Model data passed from the worker thread to the main thread when loading.
+*/
+struct LoadedStudioModel
+{
+	bool IsXashModel{};
+	int SeqGroupCount{};
+	bool HasSeparateTextureHeader{};
+	std::unique_ptr<studiomdl::EditableStudioModel> EditableModel;
+	std::unique_ptr<IFileSystem> FileSystem;
+	std::vector<std::string> EngineLimitProblems;
+};
+}
+
+AssetFinalizer StudioModelAssetProvider::LoadInBackground(const QString& fileName, FILE* file,
+	std::unique_ptr<IFileSystem>&& fileSystem, AssetLoadProgress& progress)
+{
+	const auto filePath = std::filesystem::u8path(fileName.toStdString());
+
+	// The finalizer has to be copyable, so the data is shared with it.
+	const auto model = std::make_shared<LoadedStudioModel>();
+
+	model->FileSystem = std::move(fileSystem);
 
-	if (studiomdl::IsXashModel(*studioModel))
 	{
-		_logger->debug("Model {} is a Xash model", fileName);
+		// Only the converted model is kept so the mapped files are released before the model is finalized.
+		progress.BeginStep(0, 0.5f);
+
+		const auto studioModel = studiomdl::LoadStudioModel(filePath, file, *model->FileSystem, true, &progress);
 
-		const XashOpenMode mode = _studioModelSettings->GetXashOpenMode();
+		progress.BeginStep(0.5f, 0.75f);
 
-		if (mode != XashOpenMode::Never)
+		model->EditableModel = std::make_unique<studiomdl::EditableStudioModel>(
+			studiomdl::ConvertToEditableWithLazyAnimations(*studioModel, &progress));
+
+		model->IsXashModel = studiomdl::IsXashModel(*studioModel);
+		model->SeqGroupCount = studioModel->GetSeqGroupCount();
+		model->HasSeparateTextureHeader = studioModel->HasSeparateTextureHeader();
+	}
+
+	progress.SetProgress(0.75f);
+	progress.ThrowIfCancelled();
+
+	// Only the upload is left for the main thread.
+	model->EditableModel->PrepareTextures();
+
+	model->EngineLimitProblems = studiomdl::CheckEngineLimits(*model->EditableModel);
+
+	progress.SetProgress(1);
+
+	return [this, fileName, model]() -> AssetLoadData
+	{
+		if (model->IsXashModel)
 		{
-			bool loadInXashModelViewer = true;
+			_logger->debug("Model {} is a Xash model", fileName);
 
-			if (mode == XashOpenMode::Ask)
+			const XashOpenMode mode = _studioModelSettings->GetXashOpenMode();
+
+			if (mode != XashOpenMode::Never)
 			{
-				const auto action = QMessageBox::question(_application->GetMainWindow(),
-					"Attempting to load Xash model", R"(This model was created using Xash's model compiler.
+				bool loadInXashModelViewer = true;
+
+				if (mode == XashOpenMode::Ask)
+				{
+					const auto action = QMessageBox::question(_application->GetMainWindow(),
+						"Attempting to load Xash model", R"(This model was created using Xash's model compiler.
 
 Load in Xash Model Viewer?)", QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
 
-				loadInXashModelViewer = action == QMessageBox::Yes;
-			}
+					loadInXashModelViewer = action == QMessageBox::Yes;
+				}
 
-			if (loadInXashModelViewer)
-			{
-				return AssetLoadInExternalProgram{
-					.ExternalProgramKey = XashModelViewerFileNameKey,
-					.PromptBeforeOpening = false
-				};
+				if (loadInXashModelViewer)
+				{
+					return AssetLoadInExternalProgram{
+						.ExternalProgramKey = XashModelViewerFileNameKey,
+						.PromptBeforeOpening = false
+					};
+				}
 			}
 		}
-	}
 
-	auto editableStudioModel = studiomdl::ConvertToEditable(*studioModel);
+		for (const auto& problem : model->EngineLimitProblems)
+		{
+			_logger->warn("Model \"{}\" exceeds engine limits: {}", fileName, problem);
+		}
 
-	if (studioModel->GetSeqGroupCount() > 0)
-	{
-		_logger->info("Merged {} sequence group files into main file \"{}\"", studioModel->GetSeqGroupCount(), fileName);
-	}
+		if (model->SeqGroupCount > 0)
+		{
+			_logger->info("Merged {} sequence group files into main file \"{}\"", model->SeqGroupCount, fileName);
+		}
 
-	if (studioModel->HasSeparateTextureHeader())
-	{
-		_logger->info("Merged texture file into main file \"{}\"", fileName);
-	}
-	
-	auto asset = std::make_unique<StudioModelAsset>(QString{fileName}, _application, this, _settingsVersion,
-		std::make_unique<studiomdl::EditableStudioModel>(std::move(editableStudioModel)),
-		std::move(fileSystem));
+		if (model->HasSeparateTextureHeader)
+		{
+			_logger->info("Merged texture file into main file \"{}\"", fileName);
+		}
 
-	return asset;
+		return std::make_unique<StudioModelAsset>(QString{fileName}, _application, this, _settingsVersion,
+			std::move(model->EditableModel), std::move(model->FileSystem));
+	};
 }
 
 bool StudioModelAssetProvider::IsCandidateForLoading(const QString& fileName, FILE* file) const
@@ -411,6 +483,80 @@ bool StudioModelAssetProvider::IsCandidateForLoading(const QString& fileName, FI
 	return studiomdl::IsMainStudioModel(file);
 }
 
+bool StudioModelAssetProvider::DrawThumbnail(const QString& fileName, FILE* file, graphics::SceneContext& sc,
+	ColorSettings& colorSettings) const
+{
+	if (!studiomdl::IsMainStudioModel(file))
+	{
+		return false;
+	}
+
+	const auto filePath = std::filesystem::u8path(fileName.toStdString());
+
+	// Texture and sequence group files are opened by absolute path so no search paths are needed.
+	FileSystem fileSystem;
+
+	auto studioModel = studiomdl::LoadStudioModel(filePath, file, fileSystem);
+
+	// Only the first frame of the first sequence is drawn, so only that animation gets converted.
+	auto editableModel = studiomdl::ConvertToEditableWithLazyAnimations(*studioModel);
+
+	studioModel.reset();
+
+	if (editableModel.Sequences.empty())
+	{
+		return false;
+	}
+
+	// Frame the model the same way the viewer does when a model is opened.
+	const auto& sequence = *editableModel.Sequences[0];
+
+	const glm::vec3 size = sequence.BBMax - sequence.BBMin;
+	const glm::vec3 targetOrigin{0, 0, sequence.BBMin.z + (size.z / 2)};
+	const float distance{std::clamp(std::max({size.x, size.y, size.z}), -1000.f, 1000.f)};
+
+	graphics::Camera camera;
+	camera.SetWindowSize(sc.WindowWidth, sc.WindowHeight);
+	camera.SetProperties(targetOrigin + glm::vec3{distance, 0, 0}, 0, 180, distance);
+
+	// The renderer is created on this thread because the provider's renderer belongs to the main context.
+	studiomdl::StudioModelRenderer renderer{CreateQtLoggerSt(HLAMStudioModelRenderer()),
+		sc.OpenGLFunctions, sc.StateCache, &colorSettings};
+
+	renderer.SetViewerOrigin(camera.GetOrigin());
+	renderer.SetViewerRight(camera.GetRightVector());
+
+	// The textures belong to the thumbnail context, so they must be released even if creating or drawing fails.
+	struct TextureReleaser
+	{
+		studiomdl::EditableStudioModel& Model;
+		graphics::TextureLoader& TexLoader;
+
+		~TextureReleaser()
+		{
+			Model.DeleteTextures(TexLoader);
+		}
+	} textureReleaser{editableModel, *sc.TexLoader};
+
+	editableModel.CreateTextures(*sc.TexLoader);
+
+	sc.OpenGLFunctions->glMatrixMode(GL_PROJECTION);
+	sc.OpenGLFunctions->glLoadMatrixf(glm::value_ptr(camera.GetProjectionMatrix()));
+
+	sc.OpenGLFunctions->glMatrixMode(GL_MODELVIEW);
+	sc.OpenGLFunctions->glLoadMatrixf(glm::value_ptr(camera.GetViewMatrix()));
+
+	studiomdl::ModelRenderInfo renderInfo{};
+
+	renderInfo.Scale = glm::vec3{1};
+	renderInfo.Model = &editableModel;
+	renderInfo.Transparency = 1;
+
+	renderer.DrawModel(renderInfo);
+
+	return true;
+}
+
 bool StudioModelAssetProvider::IsControlsBarVisible() const
 {
 	return _controlsBarVisibleAction->isChecked();
@@ -442,6 +588,7 @@ StudioModelEditWidget* StudioModelAssetProvider::GetEditWidget()
 		
 		_editWidget->SetControlsBarVisible(_studioModelSettings->IsControlsBarVisible());
 		_editWidget->SetTimelineVisible(_studioModelSettings->IsTimelineVisible());
+		_editWidget->SetRenderStatisticsVisible(_studioModelSettings->AreRenderStatisticsVisible());
 	}
 
 	return _editWidget;
@@ -461,6 +608,10 @@ void StudioModelAssetProvider::UpdateSettingsState()
 		_launchCrowbarAction->setEnabled(!externalPrograms->GetProgram(CrowbarFileNameKey).isEmpty());
 	}
 
+	_studioModelRenderer->SetDecodedAnimationCacheBudget(
+		static_cast<std::size_t>(_studioModelSettings->GetAnimationCacheSize()) * 1024 * 1024);
+	_studioModelRenderer->SetGpuSkinningEnabled(_studioModelSettings->ShouldUseGpuSkinning());
+
 	++_settingsVersion;
 
 	UpdateActiveAssetSettingsState();
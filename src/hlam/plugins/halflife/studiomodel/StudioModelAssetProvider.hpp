@@ -57,7 +57,7 @@ public:
 
 	ProviderFeatures GetFeatures() const override
 	{
-		return ProviderFeature::AssetLoading | ProviderFeature::AssetSaving;
+		return ProviderFeature::AssetLoading | ProviderFeature::AssetSaving | ProviderFeature::Thumbnails;
 	}
 
 	void Shutdown() override;
@@ -72,8 +72,14 @@ public:
 
 	AssetLoadData Load(const QString& fileName, FILE* file) override;
 
+	AssetFinalizer LoadInBackground(const QString& fileName, FILE* file,
+		std::unique_ptr<IFileSystem>&& fileSystem, AssetLoadProgress& progress) override;
+
 	bool IsCandidateForLoading(const QString& fileName, FILE* file) const override;
 
+	bool DrawThumbnail(const QString& fileName, FILE* file, graphics::SceneContext& sc,
+		ColorSettings& colorSettings) const override;
+
 	StudioModelSettings* GetStudioModelSettings() const { return _studioModelSettings.get(); }
 
 	studiomdl::IStudioModelRenderer* GetStudioModelRenderer() const { return _studioModelRenderer.get(); }
@@ -126,6 +132,7 @@ private:
 	QPointer<QAction> _launchCrowbarAction;
 	QPointer<QAction> _controlsBarVisibleAction;
 	QPointer<QAction> _timelineVisibleAction;
+	QPointer<QAction> _renderStatisticsVisibleAction;
 	QPointer<QAction> _editControlsVisibleAction;
 	QPointer<QAction> _restoreViewAction;
 
@@ -180,6 +187,12 @@ public:
 		return _assetProvider->Load(fileName, file);
 	}
 
+	AssetFinalizer LoadInBackground(const QString& fileName, FILE* file,
+		std::unique_ptr<IFileSystem>&& fileSystem, AssetLoadProgress& progress) override
+	{
+		return _assetProvider->LoadInBackground(fileName, file, std::move(fileSystem), progress);
+	}
+
 	bool IsCandidateForLoading(const QString& fileName, FILE* file) const override
 	{
 		return _assetProvider->IsCandidateForLoading(fileName, file);
@@ -97,6 +97,12 @@ OptionsPageStudioModelWidget::OptionsPageStudioModelWidget(
 	_ui.GroundLengthSlider->setValue(_studioModelSettings->GetGroundLength());
 	_ui.GroundLengthSpinner->setValue(_studioModelSettings->GetGroundLength());
 
+	_ui.AnimationCacheSize->setRange(
+		_studioModelSettings->MinimumAnimationCacheSize, _studioModelSettings->MaximumAnimationCacheSize);
+	_ui.AnimationCacheSize->setValue(_studioModelSettings->GetAnimationCacheSize());
+
+	_ui.UseGpuSkinning->setChecked(_studioModelSettings->ShouldUseGpuSkinning());
+
 	_ui.XashOpenMode->setCurrentIndex(static_cast<int>(_studioModelSettings->GetXashOpenMode()));
 
 	connect(_ui.GroundLengthSlider, &QSlider::valueChanged, _ui.GroundLengthSpinner, &QSpinBox::setValue);
@@ -188,6 +194,8 @@ void OptionsPageStudioModelWidget::ApplyChanges()
 	_studioModelSettings->SetActivateTextureViewWhenTexturesPanelOpened(
 		_ui.ActivateTextureViewWhenTexturesPanelOpened->isChecked());
 	_studioModelSettings->SetGroundLength(_ui.GroundLengthSlider->value());
+	_studioModelSettings->SetAnimationCacheSize(_ui.AnimationCacheSize->value());
+	_studioModelSettings->SetUseGpuSkinning(_ui.UseGpuSkinning->isChecked());
 	_studioModelSettings->SetXashOpenMode(static_cast<XashOpenMode>(_ui.XashOpenMode->currentIndex()));
 
 	QSet<int> soundEventIds;
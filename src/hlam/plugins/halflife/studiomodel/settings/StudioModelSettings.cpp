@@ -12,6 +12,9 @@ void StudioModelSettings::LoadSettings()
 		"ActivateTextureViewWhenTexturesPanelOpened", DefaultActivateTextureViewWhenTexturesPanelOpened).toBool();
 	_groundLength = std::clamp(_settings->value(
 		"GroundLength", DefaultGroundLength).toInt(), MinimumGroundLength, MaximumGroundLength);
+	_animationCacheSize = std::clamp(_settings->value(
+		"AnimationCacheSize", DefaultAnimationCacheSize).toInt(), MinimumAnimationCacheSize, MaximumAnimationCacheSize);
+	_useGpuSkinning = _settings->value("UseGpuSkinning", DefaultUseGpuSkinning).toBool();
 
 	_xashOpenMode = static_cast<XashOpenMode>(_settings->value("XashOpenMode", static_cast<int>(XashOpenMode::Ask)).toInt());
 
@@ -43,6 +46,8 @@ void StudioModelSettings::SaveSettings()
 	_settings->setValue("AutodetectViewmodels", _autodetectViewModels);
 	_settings->setValue("ActivateTextureViewWhenTexturesPanelOpened", _activateTextureViewWhenTexturesPanelOpened);
 	_settings->setValue("GroundLength", _groundLength);
+	_settings->setValue("AnimationCacheSize", _animationCacheSize);
+	_settings->setValue("UseGpuSkinning", _useGpuSkinning);
 	_settings->setValue("XashOpenMode", static_cast<int>(_xashOpenMode));
 
 	_settings->beginWriteArray("SoundEventIds", _soundEventIds.size());
@@ -86,6 +91,16 @@ void StudioModelSettings::SetEditControlsVisible(bool value)
 	_settings->setValue("Assets/StudioModel/UI/AreEditControlsVisible", value);
 }
 
+bool StudioModelSettings::AreRenderStatisticsVisible() const
+{
+	return _settings->value("Assets/StudioModel/UI/AreRenderStatisticsVisible", false).toBool();
+}
+
+void StudioModelSettings::SetRenderStatisticsVisible(bool value)
+{
+	_settings->setValue("Assets/StudioModel/UI/AreRenderStatisticsVisible", value);
+}
+
 float StudioModelSettings::GetCameraFOV(const QString& name, float defaultValue) const
 {
 	_settings->beginGroup("Assets/StudioModel/Cameras/FOV");
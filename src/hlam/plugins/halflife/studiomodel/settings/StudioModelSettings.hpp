@@ -22,6 +22,12 @@ public:
 	static constexpr int MaximumGroundLength = 2048;
 	static constexpr int DefaultGroundLength = 100;
 
+	static constexpr int MinimumAnimationCacheSize = 0;
+	static constexpr int MaximumAnimationCacheSize = 1024;
+	static constexpr int DefaultAnimationCacheSize = 32;
+
+	static constexpr bool DefaultUseGpuSkinning{false};
+
 	using BaseSettings::BaseSettings;
 
 	void LoadSettings() override;
@@ -56,6 +62,9 @@ public:
 	bool AreEditControlsVisible() const;
 	void SetEditControlsVisible(bool value);
 
+	bool AreRenderStatisticsVisible() const;
+	void SetRenderStatisticsVisible(bool value);
+
 	int GetGroundLength() const { return _groundLength; }
 
 	void SetGroundLength(int value)
@@ -63,6 +72,26 @@ public:
 		_groundLength = value;
 	}
 
+	/**
+	*	@brief Memory budget for decoded animations, in megabytes. 0 disables the cache.
+	*/
+	int GetAnimationCacheSize() const { return _animationCacheSize; }
+
+	void SetAnimationCacheSize(int value)
+	{
+		_animationCacheSize = value;
+	}
+
+	/**
+	*	@brief Whether to transform and light models in a vertex shader when the OpenGL driver supports it.
+	*/
+	bool ShouldUseGpuSkinning() const { return _useGpuSkinning; }
+
+	void SetUseGpuSkinning(bool value)
+	{
+		_useGpuSkinning = value;
+	}
+
 	XashOpenMode GetXashOpenMode() const { return _xashOpenMode; }
 
 	void SetXashOpenMode(XashOpenMode mode)
@@ -86,6 +115,10 @@ private:
 
 	int _groundLength = DefaultGroundLength;
 
+	int _animationCacheSize = DefaultAnimationCacheSize;
+
+	bool _useGpuSkinning{DefaultUseGpuSkinning};
+
 	XashOpenMode _xashOpenMode = XashOpenMode::Ask;
 
 	QSet<int> _soundEventIds;
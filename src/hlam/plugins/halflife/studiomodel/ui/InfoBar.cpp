@@ -15,6 +15,8 @@ InfoBar::InfoBar(QWidget* parent)
 	: QWidget(parent)
 {
 	_ui.setupUi(this);
+
+	SetStatisticsVisible(false);
 }
 
 InfoBar::~InfoBar() = default;
@@ -44,6 +46,16 @@ void InfoBar::SetAsset(StudioModelAsset* asset)
 	_oldDrawnPolygonsCount = 0;
 }
 
+bool InfoBar::AreStatisticsVisible() const
+{
+	return !_ui.StatisticsLabel->isHidden();
+}
+
+void InfoBar::SetStatisticsVisible(bool state)
+{
+	_ui.StatisticsLabel->setVisible(state);
+}
+
 void InfoBar::OnDraw()
 {
 	++_currentFPS;
@@ -56,5 +68,27 @@ void InfoBar::OnDraw()
 		_oldDrawnPolygonsCount = drawnPolygonsCount;
 		_ui.DrawnPolygonsCountLabel->setText(QString::number(drawnPolygonsCount));
 	}
+
+	if (AreStatisticsVisible())
+	{
+		const graphics::FrameStatistics statistics = _asset ? _asset->GetCurrentScene()->GetFrameStatistics() : graphics::FrameStatistics{};
+
+		const QString text = QString{"Draw Calls: %1 | Vertices: %2 | State Changes: %3 (%4 avoided) | Texture Binds: %5"
+			" | Uploaded: %6 KiB | Bone Setups: %7 | Skinned Vertices: %8"}
+			.arg(statistics.DrawCalls)
+			.arg(statistics.VerticesSubmitted)
+			.arg(statistics.StateChanges)
+			.arg(statistics.AvoidedStateChanges)
+			.arg(statistics.TextureBinds)
+			.arg((statistics.BytesUploaded + 1023) / 1024)
+			.arg(statistics.BoneSetups)
+			.arg(statistics.SkinnedVertices);
+
+		if (_oldStatisticsText != text)
+		{
+			_oldStatisticsText = text;
+			_ui.StatisticsLabel->setText(text);
+		}
+	}
 }
 }
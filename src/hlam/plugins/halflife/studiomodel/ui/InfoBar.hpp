@@ -18,6 +18,10 @@ public:
 
 	void SetAsset(StudioModelAsset* asset);
 
+	bool AreStatisticsVisible() const;
+
+	void SetStatisticsVisible(bool state);
+
 public slots:
 	void OnDraw();
 
@@ -30,5 +34,7 @@ private:
 	unsigned int _currentFPS{0};
 
 	unsigned int _oldDrawnPolygonsCount{0};
+
+	QString _oldStatisticsText;
 };
 }
@@ -193,6 +193,16 @@ void StudioModelEditWidget::SetTimelineVisible(bool state)
 	_timeline->setVisible(state);
 }
 
+bool StudioModelEditWidget::AreRenderStatisticsVisible() const
+{
+	return _view->GetInfoBar()->AreStatisticsVisible();
+}
+
+void StudioModelEditWidget::SetRenderStatisticsVisible(bool state)
+{
+	_view->GetInfoBar()->SetStatisticsVisible(state);
+}
+
 bool StudioModelEditWidget::AreDockWidgetsVisible() const
 {
 	return _dockWidgetsVisible;
@@ -54,6 +54,10 @@ public:
 	
 	void SetTimelineVisible(bool state);
 
+	bool AreRenderStatisticsVisible() const;
+
+	void SetRenderStatisticsVisible(bool state);
+
 	bool AreDockWidgetsVisible() const;
 
 	void SetDockWidgetsVisible(bool state);
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <memory>
+#include <unordered_set>
 
 #include <QPainter>
 
@@ -173,48 +176,29 @@ QImage CreateUVMapImage(
 		meshes.emplace_back(singleMesh);
 	}
 
+	//Triangles share edges, so only draw each edge once
+	std::unordered_set<std::uint64_t> drawnEdges;
+
 	for (const auto mesh : meshes)
 	{
-		auto ptricmds = mesh->Triangles.data();
-
-		for (int i; i = *(ptricmds++);)
-		{
-			if (i < 0)
-			{
-				i = -i;
-
-				const auto firstVertex{fixCoords(ptricmds[2], ptricmds[3])};
-
-				ptricmds += 4;
-				--i;
+		drawnEdges.clear();
 
-				for (; i > 0; --i, ptricmds += 4)
-				{
-					painter.drawLine(firstVertex, fixCoords(ptricmds[2], ptricmds[3]));
+		const auto& vertices = mesh->CookedVertices;
+		const auto& indices = mesh->CookedIndices;
 
-					if (i > 1)
-					{
-						painter.drawLine(fixCoords(ptricmds[2], ptricmds[3]), fixCoords(ptricmds[6], ptricmds[7]));
-					}
-				}
-			}
-			else
+		for (std::size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			for (std::size_t edge = 0; edge < 3; ++edge)
 			{
-				auto firstVertex{fixCoords(ptricmds[2], ptricmds[3])};
-				auto secondVertex{fixCoords(ptricmds[6], ptricmds[7])};
-
-				painter.drawLine(firstVertex, secondVertex);
+				const auto start = indices[i + edge];
+				const auto end = indices[i + ((edge + 1) % 3)];
 
-				ptricmds += 8;
-				i -= 2;
+				const auto key = (static_cast<std::uint64_t>(std::min(start, end)) << 32) | std::max(start, end);
 
-				for (; i > 0; --i, ptricmds += 4)
+				if (drawnEdges.insert(key).second)
 				{
-					painter.drawLine(secondVertex, fixCoords(ptricmds[2], ptricmds[3]));
-					painter.drawLine(fixCoords(ptricmds[2], ptricmds[3]), firstVertex);
-
-					firstVertex = secondVertex;
-					secondVertex = fixCoords(ptricmds[2], ptricmds[3]);
+					painter.drawLine(
+						fixCoords(vertices[start].S, vertices[start].T), fixCoords(vertices[end].S, vertices[end].T));
 				}
 			}
 		}
@@ -339,4 +339,10 @@ void FlipNormalsCommand::redo()
 		}
 	}
 }
+
+void RecomputeSequenceBBoxesCommand::Apply(const std::vector<std::pair<glm::vec3, glm::vec3>>& oldValue,
+	const std::vector<std::pair<glm::vec3, glm::vec3>>& newValue)
+{
+	ApplyScaleSequenceBBoxesData(*_asset->GetEditableStudioModel(), newValue, std::nullopt);
+}
 }
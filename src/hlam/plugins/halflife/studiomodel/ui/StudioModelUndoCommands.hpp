@@ -55,6 +55,8 @@ enum class ModelChangeId
 	ChangeModelName,
 
 	FlipNormals,
+
+	RecomputeSequenceBBoxes,
 };
 
 enum class AddRemoveType
@@ -721,4 +723,24 @@ public:
 private:
 	std::vector<glm::vec3> _normals;
 };
+
+class RecomputeSequenceBBoxesCommand : public ModelUndoCommand<std::vector<std::pair<glm::vec3, glm::vec3>>>
+{
+public:
+	RecomputeSequenceBBoxesCommand(StudioModelAsset* asset,
+		std::vector<std::pair<glm::vec3, glm::vec3>>&& oldBBoxes, std::vector<std::pair<glm::vec3, glm::vec3>>&& newBBoxes)
+		: ModelUndoCommand(asset, ModelChangeId::RecomputeSequenceBBoxes, std::move(oldBBoxes), std::move(newBBoxes))
+	{
+		setText("Recompute sequence bounds");
+	}
+
+protected:
+	bool CanMerge(const ModelUndoCommand<std::vector<std::pair<glm::vec3, glm::vec3>>>* other) override
+	{
+		return false;
+	}
+
+	void Apply(const std::vector<std::pair<glm::vec3, glm::vec3>>& oldValue,
+		const std::vector<std::pair<glm::vec3, glm::vec3>>& newValue) override;
+};
 }
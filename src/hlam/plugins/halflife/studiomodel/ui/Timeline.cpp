@@ -218,7 +218,7 @@ void Timeline::OnFrameSliderChanged()
 
 	if (_asset && _asset->GetApplication()->GetApplicationSettings()->PauseAnimationsOnTimelineClick)
 	{
-		if (_asset->PlaySequence)
+		if (_asset->ShouldPlaySequence())
 		{
 			OnTogglePlayback();
 		}
@@ -247,11 +247,11 @@ void Timeline::OnRestart()
 
 void Timeline::OnTogglePlayback()
 {
-	_asset->PlaySequence = !_asset->PlaySequence;
+	_asset->SetPlaySequence(!_asset->ShouldPlaySequence());
 
 	auto style = this->style();
 
-	if (_asset->PlaySequence)
+	if (_asset->ShouldPlaySequence())
 	{
 		_ui.TogglePlayback->setIcon(style->standardIcon(QStyle::StandardPixmap::SP_MediaPause));
 	}
@@ -168,7 +168,7 @@ void AttachmentsPanel::OnAttachmentChanged(int index)
 
 void AttachmentsPanel::OnHighlightAttachmentChanged()
 {
-	_asset->DrawSingleAttachmentIndex = _ui.HighlightAttachment->isChecked() ? _ui.Attachments->currentIndex() : -1;
+	_asset->SetDrawSingleAttachmentIndex(_ui.HighlightAttachment->isChecked() ? _ui.Attachments->currentIndex() : -1);
 }
 
 void AttachmentsPanel::OnNameRejected()
@@ -209,7 +209,7 @@ void BonesPanel::OnBoneChanged(int index)
 
 void BonesPanel::OnHightlightBoneChanged()
 {
-	_asset->DrawSingleBoneIndex = _ui.HighlightBone->isChecked() ? _ui.Bones->currentIndex() : -1;
+	_asset->SetDrawSingleBoneIndex(_ui.HighlightBone->isChecked() ? _ui.Bones->currentIndex() : -1);
 }
 
 void BonesPanel::OnBoneNameRejected()
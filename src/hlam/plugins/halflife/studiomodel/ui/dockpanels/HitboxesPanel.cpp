@@ -152,7 +152,7 @@ void HitboxesPanel::OnHitboxChanged(int index)
 
 void HitboxesPanel::OnHighlightHitboxChanged()
 {
-	_asset->DrawSingleHitboxIndex = _ui.HighlightHitbox->isChecked() ? _ui.Hitboxes->currentIndex() : -1;
+	_asset->SetDrawSingleHitboxIndex(_ui.HighlightHitbox->isChecked() ? _ui.Hitboxes->currentIndex() : -1);
 }
 
 void HitboxesPanel::OnHitboxPropsChanged()
@@ -57,15 +57,15 @@ ModelDisplayPanel::ModelDisplayPanel(StudioModelAssetProvider* provider)
 
 	connect(_ui.ShowCrosshair, &QCheckBox::stateChanged, this, [this]
 		{
-			_asset->GetCrosshairEntity()->ShowCrosshair = _ui.ShowCrosshair->isChecked();
+			_asset->GetCrosshairEntity()->SetShowCrosshair(_ui.ShowCrosshair->isChecked());
 		});
 	connect(_ui.ShowGuidelines, &QCheckBox::stateChanged, this, [this]
 		{
-			_asset->GetGuidelinesEntity()->ShowGuidelines = _ui.ShowGuidelines->isChecked();
+			_asset->GetGuidelinesEntity()->SetShowGuidelines(_ui.ShowGuidelines->isChecked());
 		});
 	connect(_ui.ShowOffscreenAreas, &QCheckBox::stateChanged, this, [this]
 		{
-			_asset->GetGuidelinesEntity()->ShowOffscreenAreas = _ui.ShowOffscreenAreas->isChecked();
+			_asset->GetGuidelinesEntity()->SetShowOffscreenAreas(_ui.ShowOffscreenAreas->isChecked());
 		});
 
 	{
@@ -115,29 +115,29 @@ void ModelDisplayPanel::OnAssetChanged(StudioModelAsset* asset)
 	const QSignalBlocker aspectRatioX{_ui.AspectRatioX};
 	const QSignalBlocker aspectRatioY{_ui.AspectRatioY};
 
-	_ui.RenderModeComboBox->setCurrentIndex(static_cast<int>(_asset->CurrentRenderMode));
+	_ui.RenderModeComboBox->setCurrentIndex(static_cast<int>(_asset->GetCurrentRenderMode()));
 	_ui.OpacitySlider->setValue(static_cast<int>(entity->GetTransparency() * 100));
-	_ui.ShowHitboxes->setChecked(_asset->ShowHitboxes);
-	_ui.ShowBones->setChecked(_asset->ShowBones);
-	_ui.ShowAttachments->setChecked(_asset->ShowAttachments);
-	_ui.ShowEyePosition->setChecked(_asset->ShowEyePosition);
-	_ui.ShowBBox->setChecked(_asset->GetBoundingBoxEntity()->ShowBBox);
-	_ui.ShowCBox->setChecked(_asset->GetClippingBoxEntity()->ShowCBox);
-	_ui.BackfaceCulling->setChecked(_asset->EnableBackfaceCulling);
-	_ui.WireframeOverlay->setChecked(_asset->ShowWireframeOverlay);
-	_ui.DrawShadows->setChecked(_asset->DrawShadows);
-	_ui.FixShadowZFighting->setChecked(_asset->FixShadowZFighting);
-	_ui.ShowAxes->setChecked(_asset->GetAxesEntity()->ShowAxes);
-	_ui.ShowNormals->setChecked(_asset->ShowNormals);
-	_ui.ShowPlayerHitbox->setChecked(_asset->GetPlayerHitboxEntity()->ShowPlayerHitbox);
+	_ui.ShowHitboxes->setChecked(_asset->ShouldShowHitboxes());
+	_ui.ShowBones->setChecked(_asset->ShouldShowBones());
+	_ui.ShowAttachments->setChecked(_asset->ShouldShowAttachments());
+	_ui.ShowEyePosition->setChecked(_asset->ShouldShowEyePosition());
+	_ui.ShowBBox->setChecked(_asset->GetBoundingBoxEntity()->ShouldShowBBox());
+	_ui.ShowCBox->setChecked(_asset->GetClippingBoxEntity()->ShouldShowCBox());
+	_ui.BackfaceCulling->setChecked(_asset->ShouldEnableBackfaceCulling());
+	_ui.WireframeOverlay->setChecked(_asset->ShouldShowWireframeOverlay());
+	_ui.DrawShadows->setChecked(_asset->ShouldDrawShadows());
+	_ui.FixShadowZFighting->setChecked(_asset->ShouldFixShadowZFighting());
+	_ui.ShowAxes->setChecked(_asset->GetAxesEntity()->ShouldShowAxes());
+	_ui.ShowNormals->setChecked(_asset->ShouldShowNormals());
+	_ui.ShowPlayerHitbox->setChecked(_asset->GetPlayerHitboxEntity()->ShouldShowPlayerHitbox());
 
 	_ui.MirrorOnXAxis->setChecked(entity->GetScale().x == -1);
 	_ui.MirrorOnYAxis->setChecked(entity->GetScale().y == -1);
 	_ui.MirrorOnZAxis->setChecked(entity->GetScale().z == -1);
 
-	_ui.ShowCrosshair->setChecked(_asset->GetCrosshairEntity()->ShowCrosshair);
-	_ui.ShowGuidelines->setChecked(_asset->GetGuidelinesEntity()->ShowGuidelines);
-	_ui.ShowOffscreenAreas->setChecked(_asset->GetGuidelinesEntity()->ShowOffscreenAreas);
+	_ui.ShowCrosshair->setChecked(_asset->GetCrosshairEntity()->ShouldShowCrosshair());
+	_ui.ShowGuidelines->setChecked(_asset->GetGuidelinesEntity()->ShouldShowGuidelines());
+	_ui.ShowOffscreenAreas->setChecked(_asset->GetGuidelinesEntity()->ShouldShowOffscreenAreas());
 
 	const auto aspectRatio = _asset->GetApplication()->GetApplicationSettings()->GetAspectRatio();
 	_ui.AspectRatioX->setValue(static_cast<int>(aspectRatio.x));
@@ -146,7 +146,7 @@ void ModelDisplayPanel::OnAssetChanged(StudioModelAsset* asset)
 
 void ModelDisplayPanel::OnRenderModeChanged(int index)
 {
-	_asset->CurrentRenderMode = static_cast<RenderMode>(index);
+	_asset->SetCurrentRenderMode(static_cast<RenderMode>(index));
 }
 
 void ModelDisplayPanel::OnOpacityChanged(int value)
@@ -158,81 +158,93 @@ void ModelDisplayPanel::OnOpacityChanged(int value)
 
 void ModelDisplayPanel::OnShowHitboxesChanged()
 {
-	_asset->ShowHitboxes = _ui.ShowHitboxes->isChecked();
+	_asset->SetShowHitboxes(_ui.ShowHitboxes->isChecked());
 }
 
 void ModelDisplayPanel::OnShowBonesChanged()
 {
-	_asset->ShowBones = _ui.ShowBones->isChecked();
+	_asset->SetShowBones(_ui.ShowBones->isChecked());
 }
 
 void ModelDisplayPanel::OnShowAttachmentsChanged()
 {
-	_asset->ShowAttachments = _ui.ShowAttachments->isChecked();
+	_asset->SetShowAttachments(_ui.ShowAttachments->isChecked());
 }
 
 void ModelDisplayPanel::OnShowEyePositionChanged()
 {
-	_asset->ShowEyePosition = _ui.ShowEyePosition->isChecked();
+	_asset->SetShowEyePosition(_ui.ShowEyePosition->isChecked());
 }
 
 void ModelDisplayPanel::OnShowBBoxChanged()
 {
-	_asset->GetBoundingBoxEntity()->ShowBBox = _ui.ShowBBox->isChecked();
+	_asset->GetBoundingBoxEntity()->SetShowBBox(_ui.ShowBBox->isChecked());
 }
 
 void ModelDisplayPanel::OnShowCBoxChanged()
 {
-	_asset->GetClippingBoxEntity()->ShowCBox = _ui.ShowCBox->isChecked();
+	_asset->GetClippingBoxEntity()->SetShowCBox(_ui.ShowCBox->isChecked());
 }
 
 void ModelDisplayPanel::OnEnableBackfaceCullingChanged()
 {
-	_asset->EnableBackfaceCulling = _ui.BackfaceCulling->isChecked();
+	_asset->SetEnableBackfaceCulling(_ui.BackfaceCulling->isChecked());
 }
 
 void ModelDisplayPanel::OnWireframeOverlayChanged()
 {
-	_asset->ShowWireframeOverlay = _ui.WireframeOverlay->isChecked();
+	_asset->SetShowWireframeOverlay(_ui.WireframeOverlay->isChecked());
 }
 
 void ModelDisplayPanel::OnDrawShadowsChanged()
 {
-	_asset->DrawShadows = _ui.DrawShadows->isChecked();
+	_asset->SetDrawShadows(_ui.DrawShadows->isChecked());
 }
 
 void ModelDisplayPanel::OnFixShadowZFightingChanged()
 {
-	_asset->FixShadowZFighting = _ui.FixShadowZFighting->isChecked();
+	_asset->SetFixShadowZFighting(_ui.FixShadowZFighting->isChecked());
 }
 
 void ModelDisplayPanel::OnShowAxesChanged()
 {
-	_asset->GetAxesEntity()->ShowAxes = _ui.ShowAxes->isChecked();
+	_asset->GetAxesEntity()->SetShowAxes(_ui.ShowAxes->isChecked());
 }
 
 void ModelDisplayPanel::OnShowNormalsChanged()
 {
-	_asset->ShowNormals = _ui.ShowNormals->isChecked();
+	_asset->SetShowNormals(_ui.ShowNormals->isChecked());
 }
 
 void ModelDisplayPanel::OnShowPlayerHitboxChanged()
 {
-	_asset->GetPlayerHitboxEntity()->ShowPlayerHitbox = _ui.ShowPlayerHitbox->isChecked();
+	_asset->GetPlayerHitboxEntity()->SetShowPlayerHitbox(_ui.ShowPlayerHitbox->isChecked());
 }
 
 void ModelDisplayPanel::OnMirrorXAxisChanged()
 {
-	_asset->GetEntity()->GetScale().x = _ui.MirrorOnXAxis->isChecked() ? -1 : 1;
+	auto entity = _asset->GetEntity();
+
+	glm::vec3 scale = entity->GetScale();
+	scale.x = _ui.MirrorOnXAxis->isChecked() ? -1 : 1;
+	entity->SetScale(scale);
 }
 
 void ModelDisplayPanel::OnMirrorYAxisChanged()
 {
-	_asset->GetEntity()->GetScale().y = _ui.MirrorOnYAxis->isChecked() ? -1 : 1;
+	auto entity = _asset->GetEntity();
+
+	glm::vec3 scale = entity->GetScale();
+	scale.y = _ui.MirrorOnYAxis->isChecked() ? -1 : 1;
+	entity->SetScale(scale);
 }
 
 void ModelDisplayPanel::OnMirrorZAxisChanged()
 {
-	_asset->GetEntity()->GetScale().z = _ui.MirrorOnZAxis->isChecked() ? -1 : 1;
+	auto entity = _asset->GetEntity();
+
+	glm::vec3 scale = entity->GetScale();
+	scale.z = _ui.MirrorOnZAxis->isChecked() ? -1 : 1;
+	entity->SetScale(scale);
 }
 }
@@ -64,15 +64,15 @@ void SkyLightPanel::OnAssetChanged(StudioModelAsset* asset)
 
 		auto scene = _provider->GetCurrentAsset()->GetScene();
 
-		const glm::vec3 angles{VectorToAngles(scene->SkyLight.Direction)};
+		const glm::vec3 angles{VectorToAngles(scene->GetSkyLight().Direction)};
 
 		_ui.XAngle->setValue(angles.x);
 		_ui.YAngle->setValue(angles.y);
 
-		SetButtonColor(VectorToColor(scene->SkyLight.Color));
+		SetButtonColor(VectorToColor(scene->GetSkyLight().Color));
 
-		_ui.Ambient->setValue(scene->SkyLight.Ambient);
-		_ui.Shade->setValue(scene->SkyLight.Shade);
+		_ui.Ambient->setValue(scene->GetSkyLight().Ambient);
+		_ui.Shade->setValue(scene->GetSkyLight().Shade);
 	};
 
 	lambda();
@@ -83,29 +83,42 @@ void SkyLightPanel::OnAssetChanged(StudioModelAsset* asset)
 void SkyLightPanel::OnAnglesChanged()
 {
 	const auto scene = _provider->GetCurrentAsset()->GetScene();
-	scene->SkyLight.Direction = AnglesToAimVector({_ui.XAngle->value(), _ui.YAngle->value(), 0});
+
+	graphics::Light skyLight = scene->GetSkyLight();
+	skyLight.Direction = AnglesToAimVector({_ui.XAngle->value(), _ui.YAngle->value(), 0});
+	scene->SetSkyLight(skyLight);
 }
 
 void SkyLightPanel::OnSelectColor()
 {
 	const auto asset = _provider->GetCurrentAsset();
 
-	const auto color = QColorDialog::getColor(VectorToColor(asset->GetScene()->SkyLight.Color), this);
+	const auto color = QColorDialog::getColor(VectorToColor(asset->GetScene()->GetSkyLight().Color), this);
 
 	if (color.isValid())
 	{
-		asset->GetScene()->SkyLight.Color = ColorToVector(color);
+		graphics::Light skyLight = asset->GetScene()->GetSkyLight();
+		skyLight.Color = ColorToVector(color);
+		asset->GetScene()->SetSkyLight(skyLight);
 		SetButtonColor(color);
 	}
 }
 
 void SkyLightPanel::OnAmbientChanged(int value)
 {
-	_provider->GetCurrentAsset()->GetScene()->SkyLight.Ambient = value;
+	const auto scene = _provider->GetCurrentAsset()->GetScene();
+
+	graphics::Light skyLight = scene->GetSkyLight();
+	skyLight.Ambient = value;
+	scene->SetSkyLight(skyLight);
 }
 
 void SkyLightPanel::OnShadeChanged(int value)
 {
-	_provider->GetCurrentAsset()->GetScene()->SkyLight.Shade = value;
+	const auto scene = _provider->GetCurrentAsset()->GetScene();
+
+	graphics::Light skyLight = scene->GetSkyLight();
+	skyLight.Shade = value;
+	scene->SetSkyLight(skyLight);
 }
 }
@@ -275,7 +275,7 @@ void TexturesPanel::OnTextureChanged(int index)
 	auto textureEntity = _asset->GetTextureEntity();
 
 	//Reset texture position to be centered
-	textureEntity->XOffset = textureEntity->YOffset = 0;
+	textureEntity->SetOffset(0, 0);
 	textureEntity->SetTextureIndex(index, _ui.Meshes->currentIndex());
 
 	UpdateUVMapProperties();
@@ -290,7 +290,7 @@ void TexturesPanel::OnTextureViewScaleSliderChanged(int value)
 		_ui.ScaleTextureViewSpinner->setValue(newValue);
 	}
 
-	_asset->GetTextureEntity()->TextureScale = newValue;
+	_asset->GetTextureEntity()->SetTextureScale(newValue);
 }
 
 void TexturesPanel::OnTextureViewScaleSpinnerChanged(double value)
@@ -300,7 +300,7 @@ void TexturesPanel::OnTextureViewScaleSpinnerChanged(double value)
 		_ui.ScaleTextureViewSlider->setValue(static_cast<int>((value - _ui.ScaleTextureViewSpinner->minimum()) * UVLineWidthSliderRatio));
 	}
 
-	_asset->GetTextureEntity()->TextureScale = value;
+	_asset->GetTextureEntity()->SetTextureScale(value);
 }
 
 void TexturesPanel::SetTextureName(bool updateTextures)
@@ -427,7 +427,7 @@ void TexturesPanel::OnMipmapsChanged()
 
 void TexturesPanel::OnOverlayUVMapChanged()
 {
-	_asset->GetTextureEntity()->OverlayUVMap = _ui.OverlayUVMap->isChecked();
+	_asset->GetTextureEntity()->SetOverlayUVMap(_ui.OverlayUVMap->isChecked());
 }
 
 void TexturesPanel::ImportTextureFrom(const QString& fileName, studiomdl::EditableStudioModel& model, int textureIndex)
@@ -501,15 +501,17 @@ void TexturesPanel::UpdateColormapValue()
 	graphicsContext->Begin();
 	model->UpdateTextures(*_asset->GetTextureLoader());
 	graphicsContext->End();
+
+	_asset->GetApplication()->RequestRedraw();
 }
 
 void TexturesPanel::UpdateUVMapProperties()
 {
 	auto textureEntity = _asset->GetTextureEntity();
 
-	textureEntity->ShowUVMap = _ui.ShowUVMap->isChecked();
-	textureEntity->OverlayUVMap = _ui.OverlayUVMap->isChecked();
-	textureEntity->AntiAliasLines = _ui.AntiAliasLines->isChecked();
+	textureEntity->SetShowUVMap(_ui.ShowUVMap->isChecked());
+	textureEntity->SetOverlayUVMap(_ui.OverlayUVMap->isChecked());
+	textureEntity->SetAntiAliasLines(_ui.AntiAliasLines->isChecked());
 }
 
 void TexturesPanel::OnImportTexture()
@@ -31,12 +31,12 @@ void BackgroundPanel::OnAssetChanged(StudioModelAsset* asset)
 	auto entity = asset->GetBackgroundEntity();
 
 	_ui.BackgroundTexture->setText(QString::fromStdString(entity->GetImageName()));
-	_ui.ShowBackground->setChecked(entity->ShowBackground);
+	_ui.ShowBackground->setChecked(entity->ShouldShowBackground());
 }
 
 void BackgroundPanel::OnShowBackgroundChanged()
 {
-	_provider->GetCurrentAsset()->GetBackgroundEntity()->ShowBackground = _ui.ShowBackground->isChecked();
+	_provider->GetCurrentAsset()->GetBackgroundEntity()->SetShowBackground(_ui.ShowBackground->isChecked());
 }
 
 void BackgroundPanel::OnTextureChanged()
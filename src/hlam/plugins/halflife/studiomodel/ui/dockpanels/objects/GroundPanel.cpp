@@ -43,20 +43,20 @@ void GroundPanel::OnAssetChanged(StudioModelAsset* asset)
 
 	auto entity = asset->GetGroundEntity();
 
-	_ui.ShowGround->setChecked(entity->ShowGround);
-	_ui.MirrorModelOnGround->setChecked(entity->MirrorOnGround);
-	_ui.EnableTexture->setChecked(entity->EnableTexture);
-	_ui.EnableGroundTextureTiling->setChecked(entity->EnableGroundTextureTiling);
-	_ui.GroundTextureSize->setValue(entity->GroundTextureLength);
+	_ui.ShowGround->setChecked(entity->ShouldShowGround());
+	_ui.MirrorModelOnGround->setChecked(entity->ShouldMirrorOnGround());
+	_ui.EnableTexture->setChecked(entity->ShouldEnableTexture());
+	_ui.EnableGroundTextureTiling->setChecked(entity->ShouldEnableGroundTextureTiling());
+	_ui.GroundTextureSize->setValue(entity->GetGroundTextureLength());
 	_ui.GroundTexture->setText(QString::fromStdString(entity->GetImageName()));
 	_ui.GroundOrigin->SetValue(entity->GetOrigin());
 }
 
 void GroundPanel::OnShowGroundChanged()
 {
-	_provider->GetCurrentAsset()->GetGroundEntity()->ShowGround = _ui.ShowGround->isChecked();
+	_provider->GetCurrentAsset()->GetGroundEntity()->SetShowGround(_ui.ShowGround->isChecked());
 
-	if (!_provider->GetCurrentAsset()->GetGroundEntity()->ShowGround)
+	if (!_provider->GetCurrentAsset()->GetGroundEntity()->ShouldShowGround())
 	{
 		_ui.MirrorModelOnGround->setChecked(false);
 	}
@@ -64,9 +64,9 @@ void GroundPanel::OnShowGroundChanged()
 
 void GroundPanel::OnMirrorOnGroundChanged()
 {
-	_provider->GetCurrentAsset()->GetGroundEntity()->MirrorOnGround = _ui.MirrorModelOnGround->isChecked();
+	_provider->GetCurrentAsset()->GetGroundEntity()->SetMirrorOnGround(_ui.MirrorModelOnGround->isChecked());
 
-	if (_provider->GetCurrentAsset()->GetGroundEntity()->MirrorOnGround)
+	if (_provider->GetCurrentAsset()->GetGroundEntity()->ShouldMirrorOnGround())
 	{
 		_ui.ShowGround->setChecked(true);
 	}
@@ -74,9 +74,9 @@ void GroundPanel::OnMirrorOnGroundChanged()
 
 void GroundPanel::OnEnableTextureChanged()
 {
-	_provider->GetCurrentAsset()->GetGroundEntity()->EnableTexture = _ui.EnableTexture->isChecked();
+	_provider->GetCurrentAsset()->GetGroundEntity()->SetEnableTexture(_ui.EnableTexture->isChecked());
 
-	if (_provider->GetCurrentAsset()->GetGroundEntity()->EnableTexture)
+	if (_provider->GetCurrentAsset()->GetGroundEntity()->ShouldEnableTexture())
 	{
 		_ui.ShowGround->setChecked(true);
 	}
@@ -84,12 +84,12 @@ void GroundPanel::OnEnableTextureChanged()
 
 void GroundPanel::OnEnableGroundTextureTilingChanged()
 {
-	_provider->GetCurrentAsset()->GetGroundEntity()->EnableGroundTextureTiling = _ui.EnableGroundTextureTiling->isChecked();
+	_provider->GetCurrentAsset()->GetGroundEntity()->SetEnableGroundTextureTiling(_ui.EnableGroundTextureTiling->isChecked());
 }
 
 void GroundPanel::OnGroundTextureSizeChanged()
 {
-	_provider->GetCurrentAsset()->GetGroundEntity()->GroundTextureLength = _ui.GroundTextureSize->value();
+	_provider->GetCurrentAsset()->GetGroundEntity()->SetGroundTextureLength(_ui.GroundTextureSize->value());
 }
 
 void GroundPanel::OnTextureChanged()
@@ -241,3 +241,18 @@ void ApplicationSettings::SetFileListRootDirectory(const QString& directory)
 {
 	_settings->setValue("FileList/RootDirectory", directory);
 }
+
+bool ApplicationSettings::GetFileListShowThumbnails() const
+{
+	return _settings->value("FileList/ShowThumbnails", false).toBool();
+}
+
+void ApplicationSettings::SetFileListShowThumbnails(bool value)
+{
+	_settings->setValue("FileList/ShowThumbnails", value);
+}
+
+QString ApplicationSettings::GetCacheDirectory() const
+{
+	return QFileInfo{_settings->fileName()}.absolutePath();
+}
@@ -204,6 +204,14 @@ public:
 	QString GetFileListRootDirectory() const;
 	void SetFileListRootDirectory(const QString& directory);
 
+	bool GetFileListShowThumbnails() const;
+	void SetFileListShowThumbnails(bool value);
+
+	/**
+	*	@brief Directory to store cached data in. This is the directory that contains the settings file.
+	*/
+	QString GetCacheDirectory() const;
+
 signals:
 	void SettingsLoaded();
 	void SettingsSaved();
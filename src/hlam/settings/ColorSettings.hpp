@@ -46,7 +46,7 @@ class ColorSettings final : public BaseSettings
 {
 	Q_OBJECT
 
-private:
+public:
 	struct ColorData
 	{
 		glm::vec4 DefaultColor;
@@ -54,6 +54,9 @@ private:
 		bool HasAlphaChannel;
 	};
 
+	using ColorMap = QMap<QString, ColorData>;
+
+private:
 	static constexpr glm::vec4 DefaultColor{0, 0, 0, 1};
 
 public:
@@ -151,9 +154,25 @@ public:
 		}
 	}
 
+	/**
+	*	@brief Returns a copy of all colors, for use by code that can't access this object directly.
+	*/
+	ColorMap GetColors() const
+	{
+		return _colors;
+	}
+
+	/**
+	*	@brief Replaces all colors. @ref ColorsChanged is not emitted.
+	*/
+	void SetColors(const ColorMap& colors)
+	{
+		_colors = colors;
+	}
+
 signals:
 	void ColorsChanged();
 
 private:
-	QMap<QString, ColorData> _colors;
+	ColorMap _colors;
 };
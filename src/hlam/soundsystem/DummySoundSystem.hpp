@@ -17,5 +17,7 @@ public:
 
 	void PlaySound(std::string_view, float, int) override {}
 
+	void PlaySound(std::string_view, std::span<const std::byte>, float, int) override {}
+
 	void StopAllSounds() override {}
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <span>
 #include <string_view>
 
 #undef PlaySound
@@ -40,6 +42,15 @@ public:
 	*/
 	virtual void PlaySound(std::string_view fileName, float volume, int pitch) = 0;
 
+	/**
+	*	@brief Plays a sound from the contents of a sound file.
+	*	@param fileName Sound filename. Only used for diagnostics.
+	*	@param data Contents of the sound file.
+	*	@param volume Volume. Expressed as a range between [0, 1].
+	*	@param pitch Pitch amount. Expressed as a range between [0, 255].
+	*/
+	virtual void PlaySound(std::string_view fileName, std::span<const std::byte> data, float volume, int pitch) = 0;
+
 	virtual void StopAllSounds() = 0;
 };
 
@@ -17,6 +17,9 @@
 
 #include "soundsystem/SoundSystem.hpp"
 
+#include "utility/IOUtils.hpp"
+#include "utility/Profiling.hpp"
+
 bool SoundSystem::CheckALErrorsCore(const char* file, int line)
 {
 	auto error = alGetError();
@@ -129,12 +132,32 @@ void SoundSystem::PlaySound(std::string_view fileName, float volume, int pitch)
 		return;
 	}
 
-	if (fileName.empty())
+	const FilePtr file{utf8_fopen(std::string{fileName}.c_str(), "rb")};
+
+	if (!file)
 	{
 		SPDLOG_LOGGER_CALL(_logger, spdlog::level::warn, "Unable to find sound file '{}'", fileName);
 		return;
 	}
 
+	const auto [buffer, size] = ReadFileIntoBuffer(file.get());
+
+	if (!buffer)
+	{
+		SPDLOG_LOGGER_CALL(_logger, spdlog::level::err, "Error while reading file \"{}\"", fileName);
+		return;
+	}
+
+	PlaySound(fileName, {buffer.get(), size}, volume, pitch);
+}
+
+void SoundSystem::PlaySound(std::string_view fileName, std::span<const std::byte> data, float volume, int pitch)
+{
+	if (!_context)
+	{
+		return;
+	}
+
 	if (CheckALErrors())
 	{
 		return;
@@ -145,7 +168,7 @@ void SoundSystem::PlaySound(std::string_view fileName, float volume, int pitch)
 	volume = std::clamp(volume, 0.0f, 1.0f);
 	pitch = std::clamp(pitch, 0, 255);
 
-	std::unique_ptr<Sound> sound = TryLoadFile(std::string{fileName});
+	std::unique_ptr<Sound> sound = TryLoadSound(data);
 
 	if (!sound)
 	{
@@ -243,35 +266,19 @@ size_t SoundSystem::GetSoundForPlayback()
 	return uiIndex;
 }
 
-std::unique_ptr<SoundSystem::Sound> SoundSystem::TryLoadFile(const std::string& fileName)
+std::unique_ptr<SoundSystem::Sound> SoundSystem::TryLoadSound(std::span<const std::byte> data)
 {
-	std::unique_ptr<FILE, decltype(std::fclose)*> file{std::fopen(fileName.c_str(), "rb"), &std::fclose};
+	// The decoder requires its own copy of the data.
+	const auto bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+	const std::vector<std::uint8_t> buffer(bytes, bytes + data.size());
 
-	if (!file)
-	{
-		return {};
-	}
-
-	std::fseek(file.get(), 0, SEEK_END);
-
-	const auto size = std::ftell(file.get());
-
-	std::fseek(file.get(), 0, SEEK_SET);
-
-	std::vector<std::uint8_t> buffer;
-
-	buffer.resize(size);
+	nqr::AudioData audioData;
 
-	if (std::fread(buffer.data(), 1, size, file.get()) != size)
 	{
-		SPDLOG_LOGGER_CALL(_logger, spdlog::level::err, "Error while reading file \"{}\" ({})", fileName, size);
-		return {};
+		HLAM_PROFILE_SCOPE("SoundSystem::DecodeSound");
+		m_Loader->Load(&audioData, buffer);
 	}
 
-	nqr::AudioData audioData;
-
-	m_Loader->Load(&audioData, buffer);
-
 	if (audioData.channelCount != 1 && audioData.channelCount != 2)
 	{
 		return {};
@@ -308,7 +315,9 @@ void SoundSystemWrapper::PlaySound(std::string_view fileName, float volume, int
 
 	const auto actualFileName = fmt::format("sound/{}", fileName);
 
-	const auto fullFileName{_fileSystem->GetAbsolutePath(actualFileName)};
-
-	_soundSystem->PlaySound(fullFileName, volume, pitch);
+	// Sounds are often stored in archives so they have to be accessed through the filesystem.
+	if (const auto file = _fileSystem->TryMap(actualFileName); file)
+	{
+		_soundSystem->PlaySound(actualFileName, file->Data, volume, pitch);
+	}
 }
@@ -69,13 +69,15 @@ public:
 public:
 	void PlaySound(std::string_view fileName, float volume, int pitch) override final;
 
+	void PlaySound(std::string_view fileName, std::span<const std::byte> data, float volume, int pitch) override final;
+
 	void StopAllSounds() override final;
 
 private:
 	size_t GetSoundForPlayback();
 
 	bool CheckALErrorsCore(const char* file, int line);
-	std::unique_ptr<SoundSystem::Sound> TryLoadFile(const std::string& fileName);
+	std::unique_ptr<SoundSystem::Sound> TryLoadSound(std::span<const std::byte> data);
 
 private:
 	std::shared_ptr<spdlog::logger> _logger;
@@ -91,7 +93,7 @@ private:
 };
 
 /**
-*	@brief Wraps around a sound system and converts relative paths to absolute paths.
+*	@brief Wraps around a sound system and loads sounds from the filesystem.
 */
 class SoundSystemWrapper final : public ISoundSystem
 {
@@ -114,6 +116,11 @@ public:
 
 	void PlaySound(std::string_view fileName, float volume, int pitch) override;
 
+	void PlaySound(std::string_view fileName, std::span<const std::byte> data, float volume, int pitch) override
+	{
+		_soundSystem->PlaySound(fileName, data, volume, pitch);
+	}
+
 	void StopAllSounds() override { _soundSystem->StopAllSounds(); }
 
 private:
@@ -12,11 +12,16 @@
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QGridLayout>
+#include <QLabel>
 #include <QMenu>
 #include <QMessageBox>
 #include <QOpenGLFunctions>
+#include <QProgressBar>
+#include <QPushButton>
 #include <QScreen>
+#include <QStatusBar>
 #include <QTabBar>
+#include <QTimer>
 #include <QToolButton>
 #include <QUndoGroup>
 #include <QWidget>
@@ -52,10 +57,14 @@
 
 #include "ui/options/OptionsDialog.hpp"
 
+#include "utility/Profiling.hpp"
 #include "utility/Utility.hpp"
 
 const QString AssetPathName{QStringLiteral("AssetPath")};
 
+// Time in milliseconds between updates of the asset loading progress bar.
+constexpr int LoadProgressUpdateInterval = 100;
+
 MainWindow::MainWindow(AssetManager* application)
 	: QMainWindow()
 	, _application(application)
@@ -199,6 +208,30 @@ MainWindow::MainWindow(AssetManager* application)
 
 	_assetsLayout->addWidget(_assetListButton, 0, 1);
 
+	{
+		_loadStatusLabel = new QLabel(this);
+
+		_loadProgressBar = new QProgressBar(this);
+		_loadProgressBar->setRange(0, 100);
+		_loadProgressBar->setMaximumWidth(200);
+
+		auto cancelLoadButton = new QPushButton("Cancel", this);
+
+		connect(cancelLoadButton, &QPushButton::clicked, _assets, &AssetList::CancelPendingLoads);
+
+		statusBar()->addWidget(_loadStatusLabel);
+		statusBar()->addPermanentWidget(_loadProgressBar);
+		statusBar()->addPermanentWidget(cancelLoadButton);
+
+		// Only shown while assets are loading.
+		statusBar()->hide();
+
+		_loadProgressTimer = new QTimer(this);
+		_loadProgressTimer->setInterval(LoadProgressUpdateInterval);
+
+		connect(_loadProgressTimer, &QTimer::timeout, this, &MainWindow::UpdateLoadProgress);
+	}
+
 	setAcceptDrops(true);
 
 	{
@@ -286,6 +319,11 @@ MainWindow::MainWindow(AssetManager* application)
 
 	connect(_ui.ActionRefresh, &QAction::triggered, this, [this] { _assets->RefreshCurrent(); });
 
+	_ui.ActionRecordProfilingTrace->setVisible(profiling::IsAvailable());
+	_ui.ActionRecordProfilingTrace->setChecked(profiling::IsRecording());
+
+	connect(_ui.ActionRecordProfilingTrace, &QAction::triggered, this, &MainWindow::OnRecordProfilingTrace);
+
 	connect(_ui.ActionOptions, &QAction::triggered, this, &MainWindow::OnOpenOptionsDialog);
 
 	connect(_ui.ActionOpenManual, &QAction::triggered, this, [this]
@@ -304,6 +342,8 @@ MainWindow::MainWindow(AssetManager* application)
 	connect(_assetTabs, &QTabBar::currentChanged, this, &MainWindow::OnAssetTabChanged);
 	connect(_assetTabs, &QTabBar::tabCloseRequested, this, [this](int index) { _assets->TryClose(index, true); });
 
+	connect(_assets, &AssetList::LoadFinished, this, &MainWindow::OnAssetLoadFinished);
+	connect(_assets, &AssetList::PendingLoadsChanged, this, &MainWindow::OnPendingLoadsChanged);
 	connect(_assets, &AssetList::AssetAdded, this, &MainWindow::OnAssetAdded);
 	connect(_assets, &AssetList::AboutToCloseAsset, this, &MainWindow::OnAboutToCloseAsset);
 	connect(_assets, &AssetList::AboutToRemoveAsset, this, &MainWindow::OnAboutToRemoveAsset);
@@ -491,6 +531,10 @@ void MainWindow::closeEvent(QCloseEvent* event)
 		}
 	}
 
+	// Assets that are still loading are discarded.
+	_assets->CancelPendingLoads();
+	_filesToLoadInExternalPrograms.clear();
+
 	// Close each asset
 	// Don't ask the user to save again
 	CloseAllButCount(0, false);
@@ -538,68 +582,12 @@ void MainWindow::MaybeOpenAll(const QStringList& fileNames)
 	// Set directory to first file. All files are in the same directory.
 	_application->SetPath(AssetPathName, fileNames[0]);
 
-	std::vector<ExternalProgramCommand> filesToLoadInExternalPrograms;
+	_pendingOpenCount += fileNames.size();
 
+	// Files are loaded in the background. Results are handled in OnAssetLoadFinished.
+	for (const auto& fileName : fileNames)
 	{
-		const auto externalPrograms = _application->GetApplicationSettings()->GetExternalPrograms();
-		const std::shared_ptr<spdlog::logger> logger = _application->GetLogger();
-
-		const TimerSuspender timerSuspender{_application};
-
-		// Make the tab widget invisible to reduce overhead from updating it.
-		_assetsWidget->setVisible(false);
-		_modifyingTabs = true;
-
-		for (int i = 0; const auto & fileName : fileNames)
-		{
-			auto loadResult = _assets->TryLoad(fileName);
-
-			std::visit([&](auto&& result)
-				{
-					using T = std::decay_t<decltype(result)>;
-
-					if constexpr (std::is_same_v<T, AssetLoadAction>)
-					{
-						if (result == AssetLoadAction::Success)
-						{
-							_activateNewTabs = false;
-						}
-					}
-					else if constexpr (std::is_same_v<T, AssetLoadInExternalProgram>)
-					{
-						filesToLoadInExternalPrograms.emplace_back(
-							fileName, std::move(result.ExternalProgramKey), result.PromptBeforeOpening);
-					}
-					else
-					{
-						static_assert(always_false_v<T>, "Unhandled Asset load return type");
-					}
-				}, loadResult);
-		}
-
-		_activateNewTabs = true;
-
-		_modifyingTabs = false;
-		_assetsWidget->setVisible(_assetTabs->count() > 0);
-	}
-
-	// Use the simplified dialog when there's only one.
-	switch (filesToLoadInExternalPrograms.size())
-	{
-	case 0U: break;
-	case 1U:
-	{
-		const auto& file = filesToLoadInExternalPrograms.front();
-		TryLoadInExternalProgram(file.FileName, file.ExternalProgramKey, file.PromptBeforeOpening);
-		break;
-	}
-
-	default:
-	{
-		OpenInExternalProgramDialog dialog{_application, this, filesToLoadInExternalPrograms};
-		dialog.exec();
-		break;
-	}
+		_assets->Load(fileName);
 	}
 }
 
@@ -627,6 +615,31 @@ Set the {1} executable setting to open the file through that program instead.)",
 	}
 }
 
+void MainWindow::OpenFilesInExternalPrograms()
+{
+	// Opening a dialog processes events, so files that finish loading in the meantime aren't lost.
+	const auto filesToLoadInExternalPrograms = std::exchange(_filesToLoadInExternalPrograms, {});
+
+	// Use the simplified dialog when there's only one.
+	switch (filesToLoadInExternalPrograms.size())
+	{
+	case 0U: break;
+	case 1U:
+	{
+		const auto& file = filesToLoadInExternalPrograms.front();
+		TryLoadInExternalProgram(file.FileName, file.ExternalProgramKey, file.PromptBeforeOpening);
+		break;
+	}
+
+	default:
+	{
+		OpenInExternalProgramDialog dialog{_application, this, filesToLoadInExternalPrograms};
+		dialog.exec();
+		break;
+	}
+	}
+}
+
 void MainWindow::CloseAllButCount(int leaveOpenCount, bool verifyUnsavedChanges)
 {
 	assert(leaveOpenCount >= 0);
@@ -789,6 +802,68 @@ void MainWindow::UpdateAssetWidget()
 	}
 }
 
+void MainWindow::OnAssetLoadFinished(const QString& fileName, const AssetLoadResult& loadResult)
+{
+	std::visit([&](auto&& result)
+		{
+			using T = std::decay_t<decltype(result)>;
+
+			if constexpr (std::is_same_v<T, AssetLoadAction>)
+			{
+				// Only the first asset that finishes loading is activated.
+				if (result == AssetLoadAction::Success)
+				{
+					_activateNewTabs = false;
+				}
+			}
+			else if constexpr (std::is_same_v<T, AssetLoadInExternalProgram>)
+			{
+				_filesToLoadInExternalPrograms.emplace_back(
+					fileName, result.ExternalProgramKey, result.PromptBeforeOpening);
+			}
+			else
+			{
+				static_assert(always_false_v<T>, "Unhandled Asset load return type");
+			}
+		}, loadResult);
+
+	assert(_pendingOpenCount > 0);
+
+	if (--_pendingOpenCount == 0)
+	{
+		_activateNewTabs = true;
+		OpenFilesInExternalPrograms();
+	}
+}
+
+void MainWindow::OnPendingLoadsChanged()
+{
+	const std::size_t count = _assets->GetPendingLoadCount();
+
+	statusBar()->setVisible(count > 0);
+
+	if (count > 0)
+	{
+		_loadStatusLabel->setText(QString{"Loading %1 asset(s)..."}.arg(count));
+
+		if (!_loadProgressTimer->isActive())
+		{
+			_loadProgressTimer->start();
+		}
+
+		UpdateLoadProgress();
+	}
+	else
+	{
+		_loadProgressTimer->stop();
+	}
+}
+
+void MainWindow::UpdateLoadProgress()
+{
+	_loadProgressBar->setValue(static_cast<int>(_assets->GetPendingLoadProgress() * 100));
+}
+
 void MainWindow::OnAssetAdded(int index)
 {
 	auto asset = _assets->Get(index);
@@ -1030,6 +1105,31 @@ void MainWindow::OnTextureFiltersChanged()
 		static_cast<graphics::MipmapFilter>(currentIndex(_ui.MipmapFilterGroup)));
 }
 
+void MainWindow::OnRecordProfilingTrace(bool checked)
+{
+	if (checked)
+	{
+		profiling::StartRecording();
+		return;
+	}
+
+	const QString fileName = QFileDialog::getSaveFileName(
+		this, "Save Profiling Trace", "trace.json", "Chrome Trace Files (*.json);;All Files (*.*)");
+
+	if (fileName.isEmpty())
+	{
+		// Keep recording so the session isn't lost.
+		_ui.ActionRecordProfilingTrace->setChecked(true);
+		return;
+	}
+
+	if (!profiling::StopRecording(fileName.toStdString().c_str()))
+	{
+		QMessageBox::critical(this, "Error",
+			QString{"An error occurred while saving the profiling trace to \"%1\""}.arg(fileName));
+	}
+}
+
 void MainWindow::OnOpenOptionsDialog()
 {
 	OptionsDialog dialog{_application, this};
@@ -11,18 +11,23 @@
 
 #include "ui_MainWindow.h"
 
+#include "application/AssetList.hpp"
+
 class Asset;
-class AssetList;
 class AssetProvider;
 class AssetManager;
 class QActionGroup;
 class QGridLayout;
+class QLabel;
 class QMenu;
+class QProgressBar;
 class QStringList;
 class QTabBar;
+class QTimer;
 class QToolButton;
 class QUndoGroup;
 class QWidget;
+struct ExternalProgramCommand;
 
 class MainWindow final : public QMainWindow
 {
@@ -48,6 +53,8 @@ private:
 
 	void TryLoadInExternalProgram(const QString& fileName, const QString& externalProgramKey, bool promptBeforeOpening);
 
+	void OpenFilesInExternalPrograms();
+
 	void CloseAllButCount(int leaveOpenCount, bool verifyUnsavedChanges);
 
 	QString GetCanonicalFileName(Asset* asset) const;
@@ -63,6 +70,12 @@ private slots:
 
 	void UpdateAssetWidget();
 
+	void OnAssetLoadFinished(const QString& fileName, const AssetLoadResult& loadResult);
+
+	void OnPendingLoadsChanged();
+
+	void UpdateLoadProgress();
+
 	void OnAssetAdded(int index);
 
 	void OnAssetActivated();
@@ -89,6 +102,8 @@ private slots:
 
 	void OnTextureFiltersChanged();
 
+	void OnRecordProfilingTrace(bool checked);
+
 	void OnOpenOptionsDialog();
 
 private:
@@ -112,9 +127,19 @@ private:
 	QMenu* _assetListMenu;
 	QPointer<QWidget> _currentEditWidget;
 
+	QLabel* _loadStatusLabel;
+	QProgressBar* _loadProgressBar;
+	QTimer* _loadProgressTimer;
+
 	bool _activateNewTabs = true;
 	bool _modifyingTabs = false;
 
+	// Number of files passed to MaybeOpenAll that haven't finished loading yet.
+	int _pendingOpenCount = 0;
+
+	// Opened once all pending files have finished loading so they can be shown in a single dialog.
+	std::vector<ExternalProgramCommand> _filesToLoadInExternalPrograms;
+
 	QString _loadFileFilter;
 	QString _saveFileFilter;
 
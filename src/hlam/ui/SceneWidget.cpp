@@ -11,10 +11,11 @@
 #include "ui/SceneWidget.hpp"
 
 SceneWidget::SceneWidget(AssetManager* application,
-	QOpenGLFunctions_1_1* openglFunctions, graphics::TextureLoader* textureLoader)
+	QOpenGLFunctions_1_1* openglFunctions, graphics::OpenGLStateCache* stateCache,
+	graphics::TextureLoader* textureLoader)
 	: QOpenGLWindow()
 	, _container(QWidget::createWindowContainer(this))
-	, _sceneContext(std::make_unique<graphics::SceneContext>(openglFunctions, textureLoader))
+	, _sceneContext(std::make_unique<graphics::SceneContext>(openglFunctions, stateCache, textureLoader))
 {
 	auto settings = application->GetApplicationSettings();
 
@@ -30,8 +31,6 @@ SceneWidget::SceneWidget(AssetManager* application,
 
 	_container->setFocusPolicy(Qt::FocusPolicy::WheelFocus);
 
-	connect(this, &SceneWidget::frameSwapped, this, qOverload<>(&SceneWidget::update));
-
 	connect(qGuiApp, &QGuiApplication::focusObjectChanged, this, &SceneWidget::OnFocusObjectChanged);
 
 	_previousFocusObject = qGuiApp->focusObject();
@@ -47,7 +46,10 @@ void SceneWidget::SetScene(graphics::Scene* scene)
 	{
 		const QSize size{this->size()};
 		_scene->UpdateWindowSize(static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()));
+		_scene->Invalidate();
 	}
+
+	update();
 }
 
 bool SceneWidget::event(QEvent* event)
@@ -141,6 +143,8 @@ void SceneWidget::paintGL()
 	{
 		if (_scene)
 		{
+			emit AboutToDraw();
+
 			//TODO: this is temporary until window sized resources can be decoupled from the scene class
 			_scene->UpdateWindowSize(static_cast<unsigned int>(size.width()), static_cast<unsigned int>(size.height()));
 			_scene->Draw(*_sceneContext);
@@ -10,6 +10,7 @@ class QOpenGLFunctions_1_1;
 
 namespace graphics
 {
+class OpenGLStateCache;
 class Scene;
 class SceneContext;
 class TextureLoader;
@@ -17,6 +18,7 @@ class TextureLoader;
 
 /**
 *	@brief Renders a scene to an OpenGL window
+*	Frames are only drawn when requested using @c update, see AssetManager::OnTimerTick.
 *	TODO: rework this so it isn't tied directly to OpenGL (allow D3D or Vulkan backends)
 */
 class SceneWidget final : public QOpenGLWindow
@@ -26,7 +28,8 @@ class SceneWidget final : public QOpenGLWindow
 public:
 	SceneWidget(
 		AssetManager* application,
-		QOpenGLFunctions_1_1* openglFunctions, graphics::TextureLoader* textureLoader);
+		QOpenGLFunctions_1_1* openglFunctions, graphics::OpenGLStateCache* stateCache,
+		graphics::TextureLoader* textureLoader);
 	~SceneWidget();
 
 	QWidget* GetContainer() { return _container; }
@@ -36,6 +39,11 @@ public:
 	void SetScene(graphics::Scene* scene);
 
 signals:
+	/**
+	*	@brief Emitted right before the scene is drawn.
+	*/
+	void AboutToDraw();
+
 	void MouseEvent(QMouseEvent* event);
 
 	void WheelEvent(QWheelEvent* event);
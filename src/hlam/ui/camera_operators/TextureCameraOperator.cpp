@@ -35,8 +35,7 @@ void TextureCameraOperator::MouseEvent(QMouseEvent& event)
 
 		if (_trackedMouseButtons & Qt::MouseButton::LeftButton && event.buttons() & Qt::MouseButton::LeftButton)
 		{
-			_textureEntity->XOffset += delta.x;
-			_textureEntity->YOffset += delta.y;
+			_textureEntity->SetOffset(_textureEntity->GetXOffset() + delta.x, _textureEntity->GetYOffset() + delta.y);
 		}
 		else if (_trackedMouseButtons & Qt::MouseButton::RightButton && event.buttons() & Qt::MouseButton::RightButton)
 		{
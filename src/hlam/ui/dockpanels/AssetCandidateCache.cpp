@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "application/Assets.hpp"
+
+#include "ui/dockpanels/AssetCandidateCache.hpp"
+
+#include "utility/IOUtils.hpp"
+#include "utility/Profiling.hpp"
+
+namespace
+{
+constexpr quint32 CacheFileId = 0x43414C48; // "HLAC"
+constexpr quint32 CacheFileVersion = 2;
+
+// Probing is mostly I/O bound. Limit the number of files opened at the same time so network drives aren't flooded.
+constexpr int MaxConcurrentProbes = 4;
+
+// Upper limit on the number of entries saved for each provider so the cache file can't grow without bound.
+constexpr int MaxEntriesPerProvider = 100000;
+}
+
+QDataStream& operator<<(QDataStream& stream, const AssetCandidateCache::Entry& entry)
+{
+	return stream << entry.Size << entry.LastModified << entry.IsCandidate << entry.LastUsed;
+}
+
+QDataStream& operator>>(QDataStream& stream, AssetCandidateCache::Entry& entry)
+{
+	return stream >> entry.Size >> entry.LastModified >> entry.IsCandidate >> entry.LastUsed;
+}
+
+AssetCandidateCache::AssetCandidateCache(const QString& cacheFileName, QObject* parent)
+	: QObject(parent)
+	, _cacheFileName(cacheFileName)
+{
+	_threadPool.setMaxThreadCount(MaxConcurrentProbes);
+
+	Load();
+}
+
+AssetCandidateCache::~AssetCandidateCache()
+{
+	// Results that arrive after this are discarded along with the object's pending events.
+	_threadPool.clear();
+	_threadPool.waitForDone();
+
+	Prune();
+	Save();
+}
+
+std::optional<bool> AssetCandidateCache::IsCandidateForLoading(AssetProvider* provider, const QFileInfo& fileInfo)
+{
+	const QString providerName = provider->GetProviderName();
+	const QString fileName = fileInfo.absoluteFilePath();
+	const qint64 size = fileInfo.size();
+	const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+	if (const auto entries = _entries.find(providerName); entries != _entries.end())
+	{
+		if (const auto entry = entries->find(fileName);
+			entry != entries->end() && entry->Size == size && entry->LastModified == lastModified)
+		{
+			entry->LastUsed = now;
+			_modified = true;
+			return entry->IsCandidate;
+		}
+	}
+
+	auto& pendingProbes = _pendingProbes[providerName];
+
+	if (pendingProbes.contains(fileName))
+	{
+		return {};
+	}
+
+	pendingProbes.insert(fileName);
+
+	_threadPool.start([this, provider, providerName, fileName, size, lastModified, now]
+		{
+			HLAM_PROFILE_SCOPE("AssetCandidateCache::Probe");
+
+			Entry entry{size, lastModified, false, now};
+
+			if (const FilePtr file{utf8_fopen(fileName.toStdString().c_str(), "rb")}; file)
+			{
+				entry.IsCandidate = provider->IsCandidateForLoading(fileName, file.get());
+			}
+
+			QMetaObject::invokeMethod(this, [this, providerName, fileName, entry]
+				{
+					OnProbeFinished(providerName, fileName, entry);
+				}, Qt::QueuedConnection);
+		});
+
+	return {};
+}
+
+void AssetCandidateCache::OnProbeFinished(const QString& providerName, const QString& fileName, const Entry& entry)
+{
+	_pendingProbes[providerName].remove(fileName);
+	_entries[providerName].insert(fileName, entry);
+	_modified = true;
+
+	emit ProbeFinished(fileName);
+}
+
+void AssetCandidateCache::Load()
+{
+	QFile file{_cacheFileName};
+
+	if (!file.open(QFile::ReadOnly))
+	{
+		return;
+	}
+
+	QDataStream stream{&file};
+	stream.setVersion(QDataStream::Qt_5_15);
+
+	quint32 id = 0;
+	quint32 version = 0;
+
+	stream >> id >> version;
+
+	// Outdated caches are discarded.
+	if (id != CacheFileId || version != CacheFileVersion)
+	{
+		return;
+	}
+
+	stream >> _entries;
+
+	if (stream.status() != QDataStream::Ok)
+	{
+		_entries.clear();
+	}
+}
+
+void AssetCandidateCache::Prune()
+{
+	for (auto& entries : _entries)
+	{
+		if (entries.size() <= MaxEntriesPerProvider)
+		{
+			continue;
+		}
+
+		std::vector<std::pair<qint64, QString>> entriesByLastUse;
+
+		entriesByLastUse.reserve(entries.size());
+
+		for (auto entry = entries.cbegin(); entry != entries.cend(); ++entry)
+		{
+			entriesByLastUse.emplace_back(entry->LastUsed, entry.key());
+		}
+
+		const auto evictCount = entriesByLastUse.size() - MaxEntriesPerProvider;
+
+		std::nth_element(entriesByLastUse.begin(), entriesByLastUse.begin() + evictCount, entriesByLastUse.end(),
+			[](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+		for (std::size_t i = 0; i < evictCount; ++i)
+		{
+			entries.remove(entriesByLastUse[i].second);
+		}
+
+		_modified = true;
+	}
+}
+
+void AssetCandidateCache::Save() const
+{
+	if (!_modified)
+	{
+		return;
+	}
+
+	QSaveFile file{_cacheFileName};
+
+	if (!file.open(QFile::WriteOnly))
+	{
+		return;
+	}
+
+	QDataStream stream{&file};
+	stream.setVersion(QDataStream::Qt_5_15);
+
+	stream << CacheFileId << CacheFileVersion << _entries;
+
+	file.commit();
+}
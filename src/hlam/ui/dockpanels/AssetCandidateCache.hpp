@@ -0,0 +1,72 @@
+#pragma once
+
+#include <optional>
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+class AssetProvider;
+class QDataStream;
+class QFileInfo;
+
+/**
+*	@brief Caches whether files are candidates for loading by an asset provider.
+*	Files are probed on worker threads so checking large directories doesn't block the UI.
+*	Results are invalidated when a file's size or modification time changes, and are saved to disk.
+*	The least recently used entries are evicted when the cache grows too large.
+*/
+class AssetCandidateCache final : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit AssetCandidateCache(const QString& cacheFileName, QObject* parent = nullptr);
+	~AssetCandidateCache();
+
+	/**
+	*	@brief Returns whether the given file is a candidate for loading by the given provider.
+	*	If the result isn't known yet the file is probed in the background and an empty optional is returned.
+	*	@ref ProbeFinished is emitted once the result is available.
+	*/
+	std::optional<bool> IsCandidateForLoading(AssetProvider* provider, const QFileInfo& fileInfo);
+
+signals:
+	void ProbeFinished(const QString& fileName);
+
+private:
+	struct Entry
+	{
+		qint64 Size{};
+		qint64 LastModified{};
+		bool IsCandidate{};
+		qint64 LastUsed{};
+	};
+
+	friend QDataStream& operator<<(QDataStream& stream, const Entry& entry);
+	friend QDataStream& operator>>(QDataStream& stream, Entry& entry);
+
+	void OnProbeFinished(const QString& providerName, const QString& fileName, const Entry& entry);
+
+	void Load();
+	void Save() const;
+
+	/**
+	*	@brief Evicts the least recently used entries of providers that have too many.
+	*	Files that were deleted or moved are never looked up again, so their entries are evicted eventually.
+	*/
+	void Prune();
+
+private:
+	const QString _cacheFileName;
+
+	QThreadPool _threadPool;
+
+	// Keyed by provider name, then by absolute file name.
+	QHash<QString, QHash<QString, Entry>> _entries;
+	QHash<QString, QSet<QString>> _pendingProbes;
+
+	bool _modified{false};
+};
@@ -1,16 +1,22 @@
 #include <algorithm>
-#include <cstdio>
 #include <utility>
 #include <vector>
 
+#include <QBrush>
+#include <QBuffer>
+#include <QByteArray>
 #include <QDir>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFileSystemModel>
+#include <QHash>
+#include <QImage>
 #include <QMessageBox>
+#include <QPalette>
 #include <QSortFilterProxyModel>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
 
 #include "application/AssetManager.hpp"
 #include "application/Assets.hpp"
@@ -20,14 +26,98 @@
 
 #include "ui/MainWindow.hpp"
 #include "ui/dialogs/SelectGameConfigurationDialog.hpp"
+#include "ui/dockpanels/AssetCandidateCache.hpp"
 #include "ui/dockpanels/FileBrowser.hpp"
+#include "ui/dockpanels/ThumbnailCache.hpp"
+
+// Time in milliseconds to wait for more probes to finish before filtering again.
+constexpr int ProbeRefreshDelay = 100;
 
 class AssetFilterModel final : public QSortFilterProxyModel
 {
 public:
-	explicit AssetFilterModel(QObject* parent = nullptr)
+	AssetFilterModel(AssetCandidateCache* candidateCache, ThumbnailCache* thumbnailCache, QObject* parent = nullptr)
 		: QSortFilterProxyModel(parent)
+		, _candidateCache(candidateCache)
+		, _thumbnailCache(thumbnailCache)
+	{
+		// Filter once for a batch of probes instead of once for every file.
+		_refreshTimer.setSingleShot(true);
+		_refreshTimer.setInterval(ProbeRefreshDelay);
+
+		connect(&_refreshTimer, &QTimer::timeout, this, [this] { invalidateFilter(); });
+
+		connect(_candidateCache, &AssetCandidateCache::ProbeFinished, this, [this]
+			{
+				if (!_refreshTimer.isActive())
+				{
+					_refreshTimer.start();
+				}
+			});
+
+		connect(_thumbnailCache, &ThumbnailCache::ThumbnailReady, this, [this](const QString& fileName)
+			{
+				auto fileSystemModel = static_cast<QFileSystemModel*>(sourceModel());
+
+				if (const auto index = mapFromSource(fileSystemModel->index(fileName)); index.isValid())
+				{
+					emit dataChanged(index, index, {Qt::DecorationRole, Qt::ToolTipRole});
+				}
+			});
+	}
+
+	QVariant data(const QModelIndex& index, int role) const override
+	{
+		// Files that are still being probed are shown as pending.
+		if ((role == Qt::ForegroundRole || role == Qt::ToolTipRole) && IsPending(mapToSource(index)))
+		{
+			if (role == Qt::ForegroundRole)
+			{
+				return QBrush{QPalette{}.color(QPalette::Disabled, QPalette::Text)};
+			}
+
+			return QStringLiteral("Checking file...");
+		}
+
+		if (role == Qt::DecorationRole && _showThumbnails)
+		{
+			if (const auto thumbnail = GetThumbnail(mapToSource(index)); !thumbnail.isNull())
+			{
+				return thumbnail;
+			}
+		}
+		else if (role == Qt::ToolTipRole)
+		{
+			if (const auto thumbnail = GetThumbnail(mapToSource(index)); !thumbnail.isNull())
+			{
+				QByteArray data;
+				QBuffer buffer{&data};
+				buffer.open(QBuffer::WriteOnly);
+				thumbnail.save(&buffer, "PNG");
+
+				return QString{R"(<img src="data:image/png;base64,%1"/><br/>%2)"}
+					.arg(QString::fromLatin1(data.toBase64()))
+					.arg(QSortFilterProxyModel::data(index.siblingAtColumn(0), Qt::DisplayRole).toString().toHtmlEscaped());
+			}
+		}
+
+		return QSortFilterProxyModel::data(index, role);
+	}
+
+	/**
+	*	@brief Thumbnails of files with the given provider's file types are drawn by that provider.
+	*/
+	void AddThumbnailProvider(AssetProvider* provider)
+	{
+		for (const auto& fileType : provider->GetFileTypes())
+		{
+			_thumbnailProviders.insert(fileType.toLower(), provider);
+		}
+	}
+
+	void SetShowThumbnails(bool value)
 	{
+		_showThumbnails = value;
 	}
 
 	void SetProvider(AssetProvider* provider)
@@ -79,32 +169,70 @@ protected:
 			return false;
 		}
 
-		const auto fileName = fileInfo.absoluteFilePath();
+		// Files are shown until probing has finished.
+		return _candidateCache->IsCandidateForLoading(_provider, fileInfo).value_or(true);
+	}
+
+private:
+	QImage GetThumbnail(const QModelIndex& sourceIndex) const
+	{
+		auto fileSystemModel = static_cast<QFileSystemModel*>(sourceModel());
+
+		const auto fileInfo = fileSystemModel->fileInfo(sourceIndex.siblingAtColumn(0));
+
+		if (!fileInfo.isFile())
+		{
+			return {};
+		}
 
-		FILE* file = fopen(fileName.toStdString().c_str(), "rb");
+		const auto provider = _thumbnailProviders.value(fileInfo.suffix().toLower());
 
-		if (!file)
+		if (!provider)
+		{
+			return {};
+		}
+
+		return _thumbnailCache->GetThumbnail(provider, fileInfo);
+	}
+
+	bool IsPending(const QModelIndex& sourceIndex) const
+	{
+		if (!_provider)
 		{
 			return false;
 		}
 
-		const bool acceptFile = _provider->IsCandidateForLoading(fileName, file);
+		auto fileSystemModel = static_cast<QFileSystemModel*>(sourceModel());
 
-		fclose(file);
+		const auto fileInfo = fileSystemModel->fileInfo(sourceIndex.siblingAtColumn(0));
 
-		return acceptFile;
+		return fileInfo.isFile()
+			&& _extensions.contains(fileInfo.suffix())
+			&& !_candidateCache->IsCandidateForLoading(_provider, fileInfo).has_value();
 	}
 
 private:
+	AssetCandidateCache* const _candidateCache;
+	ThumbnailCache* const _thumbnailCache;
+	QTimer _refreshTimer;
+
 	AssetProvider* _provider{};
 	QStringList _extensions;
+
+	// Keyed by lowercase file extension.
+	QHash<QString, AssetProvider*> _thumbnailProviders;
+	bool _showThumbnails{false};
 };
 
 FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 	: QWidget(parent)
 	, _application(application)
 	, _model(new QFileSystemModel(this))
-	, _filterModel(new AssetFilterModel(this))
+	, _candidateCache(new AssetCandidateCache(
+		_application->GetApplicationSettings()->GetCacheDirectory() + "/FileBrowserCache.dat", this))
+	, _thumbnailCache(new ThumbnailCache(_application->GetColorSettings(),
+		_application->GetApplicationSettings()->GetCacheDirectory() + "/Thumbnails", this))
+	, _filterModel(new AssetFilterModel(_candidateCache, _thumbnailCache, this))
 {
 	_ui.setupUi(this);
 
@@ -115,6 +243,13 @@ FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 	_ui.FileView->setModel(_filterModel);
 	_ui.FileView->setColumnWidth(0, 250);
 
+	// Both views show the same files, so they share the selection as well.
+	_ui.ThumbnailView->setModel(_filterModel);
+	delete _ui.ThumbnailView->selectionModel();
+	_ui.ThumbnailView->setSelectionModel(_ui.FileView->selectionModel());
+	_ui.ThumbnailView->setIconSize({ThumbnailCache::ThumbnailSize, ThumbnailCache::ThumbnailSize});
+	_ui.ThumbnailView->setGridSize({ThumbnailCache::ThumbnailSize + 32, ThumbnailCache::ThumbnailSize + 40});
+
 	connect(_ui.Filters, qOverload<int>(&QComboBox::currentIndexChanged), this,
 		[this]
 		{
@@ -123,6 +258,10 @@ FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 
 	connect(_ui.FileView, &QTreeView::activated, this, &FileBrowser::OnFileSelected);
 	connect(_ui.FileView, &QTreeView::doubleClicked, this, &FileBrowser::OnFileDoubleClicked);
+	connect(_ui.ThumbnailView, &QListView::activated, this, &FileBrowser::OnFileSelected);
+	connect(_ui.ThumbnailView, &QListView::doubleClicked, this, &FileBrowser::OnFileDoubleClicked);
+
+	connect(_ui.ShowThumbnails, &QCheckBox::toggled, this, &FileBrowser::SetShowThumbnails);
 
 	connect(_ui.BrowseRoot, &QPushButton::clicked, this,
 		[this]
@@ -212,6 +351,11 @@ FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 		filters.emplace_back(
 			QString{"%1 .%2 Files"}.arg(provider->GetProviderName()).arg(provider->GetPreferredFileType()),
 			provider);
+
+		if (provider->GetFeatures() & ProviderFeature::Thumbnails)
+		{
+			_filterModel->AddThumbnailProvider(provider);
+		}
 	}
 
 	std::sort(filters.begin(), filters.end(), [](const auto& lhs, const auto& rhs)
@@ -240,6 +384,8 @@ FileBrowser::FileBrowser(AssetManager* application, QWidget* parent)
 	}
 
 	_ui.Filters->setCurrentIndex(filterIndex);
+
+	_ui.ShowThumbnails->setChecked(_application->GetApplicationSettings()->GetFileListShowThumbnails());
 }
 
 FileBrowser::~FileBrowser()
@@ -249,6 +395,7 @@ FileBrowser::~FileBrowser()
 	auto provider = _ui.Filters->currentData().value<AssetProvider*>();
 	auto providerName = provider ? provider->GetProviderName() : QString{};
 	_application->GetApplicationSettings()->SetFileListFilter(providerName);
+	_application->GetApplicationSettings()->SetFileListShowThumbnails(_ui.ShowThumbnails->isChecked());
 }
 
 void FileBrowser::Initialize()
@@ -271,8 +418,30 @@ void FileBrowser::Initialize()
 void FileBrowser::SetRootDirectory(const QString& directory)
 {
 	_model->setRootPath(directory);
-	_ui.FileView->setRootIndex(_filterModel->mapFromSource(_model->index(directory)));
+
+	const auto rootIndex = _filterModel->mapFromSource(_model->index(directory));
+	_ui.FileView->setRootIndex(rootIndex);
+	_ui.ThumbnailView->setRootIndex(rootIndex);
+
 	_ui.Root->setText(directory);
+
+	// Thumbnails of the previous directory are no longer visible.
+	_thumbnailCache->CancelPendingRequests();
+}
+
+void FileBrowser::SetShowThumbnails(bool value)
+{
+	_filterModel->SetShowThumbnails(value);
+
+	if (value)
+	{
+		_ui.Views->setCurrentWidget(_ui.ThumbnailView);
+	}
+	else
+	{
+		_ui.Views->setCurrentWidget(_ui.FileView);
+		_thumbnailCache->CancelPendingRequests();
+	}
 }
 
 void FileBrowser::MaybeOpenFiles(const QModelIndexList& indices)
@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <exception>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions_1_1>
+#include <QSaveFile>
+
+#include "application/Assets.hpp"
+
+#include "graphics/OpenGLStateCache.hpp"
+#include "graphics/SceneContext.hpp"
+#include "graphics/TextureLoader.hpp"
+
+#include "settings/ColorSettings.hpp"
+
+#include "ui/dockpanels/ThumbnailCache.hpp"
+
+#include "utility/IOUtils.hpp"
+#include "utility/Profiling.hpp"
+
+namespace
+{
+// Thumbnails are rendered at a higher resolution and scaled down to smooth out edges.
+constexpr int RenderScale = 2;
+
+// Enough to hold a few thousand thumbnails.
+constexpr int MaxCacheCost = 64 * 1024;
+}
+
+/**
+*	@brief Lives on the thumbnail thread and owns the OpenGL resources used to render thumbnails.
+*	OpenGL is initialized on first use so creating the cache doesn't stall the UI.
+*/
+class ThumbnailRenderer final : public QObject
+{
+public:
+	ThumbnailRenderer(QOffscreenSurface* surface, const QString& cacheDirectory)
+		: _surface(surface)
+		, _cacheDirectory(cacheDirectory)
+	{
+	}
+
+	QImage GetThumbnail(AssetProvider* provider, const QString& fileName, const ColorSettings::ColorMap& colors)
+	{
+		if (!Initialize())
+		{
+			return {};
+		}
+
+		QFile file{fileName};
+
+		if (!file.open(QFile::ReadOnly))
+		{
+			return {};
+		}
+
+		// The size is part of the hash so thumbnails are rendered again if it changes.
+		QCryptographicHash hash{QCryptographicHash::Sha1};
+		hash.addData(provider->GetProviderName().toUtf8());
+		hash.addData(QByteArray::number(ThumbnailCache::ThumbnailSize));
+		hash.addData(&file);
+
+		const QString cacheFileName = QString{"%1/%2.png"}.arg(_cacheDirectory).arg(QString::fromLatin1(hash.result().toHex()));
+
+		if (QImage image; image.load(cacheFileName))
+		{
+			return image;
+		}
+
+		_colorSettings->SetColors(colors);
+
+		const QImage image = Render(provider, fileName);
+
+		if (!image.isNull() && QDir{}.mkpath(_cacheDirectory))
+		{
+			if (QSaveFile cacheFile{cacheFileName}; cacheFile.open(QFile::WriteOnly) && image.save(&cacheFile, "PNG"))
+			{
+				cacheFile.commit();
+			}
+		}
+
+		return image;
+	}
+
+	void Shutdown()
+	{
+		if (_context && _context->makeCurrent(_surface))
+		{
+			_framebuffer.reset();
+			_context->doneCurrent();
+		}
+
+		_colorSettings.reset();
+		_textureLoader.reset();
+		_stateCache.reset();
+		_openglFunctions.reset();
+		_context.reset();
+	}
+
+private:
+	bool Initialize()
+	{
+		if (_context)
+		{
+			return static_cast<bool>(_framebuffer);
+		}
+
+		// Thumbnails are disabled if the platform can't render on a separate thread.
+		if (!QOpenGLContext::supportsThreadedOpenGL())
+		{
+			return false;
+		}
+
+		_context = std::make_unique<QOpenGLContext>();
+
+		_context->setFormat(_surface->format());
+		_context->setScreen(_surface->screen());
+
+		if (!_context->create() || !_context->makeCurrent(_surface))
+		{
+			return false;
+		}
+
+		_openglFunctions = std::make_unique<QOpenGLFunctions_1_1>();
+
+		if (_openglFunctions->initializeOpenGLFunctions() && QOpenGLFramebufferObject::hasOpenGLFramebufferObjects())
+		{
+			_stateCache = std::make_unique<graphics::OpenGLStateCache>(_openglFunctions.get());
+			_textureLoader = std::make_unique<graphics::TextureLoader>(_openglFunctions.get());
+			_colorSettings = std::make_unique<ColorSettings>(nullptr);
+
+			const int renderSize = ThumbnailCache::ThumbnailSize * RenderScale;
+
+			_framebuffer = std::make_unique<QOpenGLFramebufferObject>(
+				renderSize, renderSize, QOpenGLFramebufferObject::CombinedDepthStencil);
+
+			if (!_framebuffer->isValid())
+			{
+				_framebuffer.reset();
+			}
+		}
+
+		_context->doneCurrent();
+
+		return static_cast<bool>(_framebuffer);
+	}
+
+	QImage Render(AssetProvider* provider, const QString& fileName)
+	{
+		HLAM_PROFILE_SCOPE("ThumbnailRenderer::Render");
+
+		const FilePtr file{utf8_fopen(fileName.toStdString().c_str(), "rb")};
+
+		if (!file || !_context->makeCurrent(_surface))
+		{
+			return {};
+		}
+
+		_framebuffer->bind();
+
+		graphics::SceneContext sc{_openglFunctions.get(), _stateCache.get(), _textureLoader.get()};
+
+		sc.WindowWidth = _framebuffer->width();
+		sc.WindowHeight = _framebuffer->height();
+
+		_openglFunctions->glViewport(0, 0, sc.WindowWidth, sc.WindowHeight);
+		_openglFunctions->glClearColor(0, 0, 0, 0);
+		_openglFunctions->glClearStencil(0);
+		_openglFunctions->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+		// The previous thumbnail may have failed halfway through drawing.
+		_stateCache->Invalidate();
+		_stateCache->PolygonMode(GL_FILL);
+
+		bool drawn = false;
+
+		try
+		{
+			drawn = provider->DrawThumbnail(fileName, file.get(), sc, *_colorSettings);
+		}
+		catch (const std::exception&)
+		{
+			// Files that fail to load don't get a thumbnail.
+		}
+
+		QImage image;
+
+		if (drawn)
+		{
+			image = _framebuffer->toImage().scaled(ThumbnailCache::ThumbnailSize, ThumbnailCache::ThumbnailSize,
+				Qt::KeepAspectRatio, Qt::SmoothTransformation);
+		}
+
+		_framebuffer->release();
+		_context->doneCurrent();
+
+		return image;
+	}
+
+private:
+	QOffscreenSurface* const _surface;
+	const QString _cacheDirectory;
+
+	std::unique_ptr<QOpenGLContext> _context;
+	std::unique_ptr<QOpenGLFunctions_1_1> _openglFunctions;
+	std::unique_ptr<graphics::OpenGLStateCache> _stateCache;
+	std::unique_ptr<graphics::TextureLoader> _textureLoader;
+	std::unique_ptr<QOpenGLFramebufferObject> _framebuffer;
+
+	// Colors can't be read from the application's settings on this thread, so each request carries a copy.
+	std::unique_ptr<ColorSettings> _colorSettings;
+};
+
+ThumbnailCache::ThumbnailCache(ColorSettings* colorSettings, const QString& cacheDirectory, QObject* parent)
+	: QObject(parent)
+	, _colorSettings(colorSettings)
+	, _surface(std::make_unique<QOffscreenSurface>())
+	, _thumbnails(MaxCacheCost)
+{
+	// Surfaces have to be created on the GUI thread.
+	_surface->setFormat(QSurfaceFormat::defaultFormat());
+	_surface->create();
+
+	_renderer = std::make_unique<ThumbnailRenderer>(_surface.get(), cacheDirectory);
+	_renderer->moveToThread(&_thread);
+
+	_thread.setObjectName("ThumbnailCache");
+	_thread.start(QThread::LowPriority);
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+	CancelPendingRequests();
+
+	// OpenGL resources have to be destroyed on the thread that owns the context.
+	QMetaObject::invokeMethod(_renderer.get(), [this] { _renderer->Shutdown(); }, Qt::BlockingQueuedConnection);
+
+	_thread.quit();
+	_thread.wait();
+}
+
+QImage ThumbnailCache::GetThumbnail(AssetProvider* provider, const QFileInfo& fileInfo)
+{
+	const QString fileName = fileInfo.absoluteFilePath();
+	const qint64 size = fileInfo.size();
+	const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+	if (const auto entry = _thumbnails.object(fileName);
+		entry && entry->Size == size && entry->LastModified == lastModified)
+	{
+		return entry->Image;
+	}
+
+	if (_pendingRequests.contains(fileName))
+	{
+		return {};
+	}
+
+	_pendingRequests.insert(fileName);
+
+	const quint64 generation = _generation.load();
+
+	// Requests are handled one at a time in the order they were made, which is the order the views asked for them.
+	QMetaObject::invokeMethod(_renderer.get(),
+		[this, provider, fileName, size, lastModified, generation, colors = _colorSettings->GetColors()]
+		{
+			if (generation != _generation.load())
+			{
+				return;
+			}
+
+			const QImage image = _renderer->GetThumbnail(provider, fileName, colors);
+
+			QMetaObject::invokeMethod(this, [this, fileName, size, lastModified, image]
+				{
+					OnThumbnailRendered(fileName, size, lastModified, image);
+				}, Qt::QueuedConnection);
+		}, Qt::QueuedConnection);
+
+	return {};
+}
+
+void ThumbnailCache::CancelPendingRequests()
+{
+	++_generation;
+	_pendingRequests.clear();
+}
+
+void ThumbnailCache::OnThumbnailRendered(const QString& fileName, qint64 size, qint64 lastModified, const QImage& image)
+{
+	_pendingRequests.remove(fileName);
+
+	// Failed files are remembered too so they aren't rendered again.
+	const int cost = std::max(1, static_cast<int>(image.sizeInBytes() / 1024));
+
+	_thumbnails.insert(fileName, new Entry{size, lastModified, image}, cost);
+
+	emit ThumbnailReady(fileName);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThread>
+
+class AssetProvider;
+class ColorSettings;
+class QFileInfo;
+class QOffscreenSurface;
+class ThumbnailRenderer;
+
+/**
+*	@brief Renders thumbnails of assets for the file browser.
+*	Thumbnails are rendered one at a time on a dedicated thread with its own OpenGL context so the UI is never blocked.
+*	Rendered thumbnails are saved to disk as PNG files named after a hash of the file's contents,
+*	and recently used thumbnails are kept in memory.
+*/
+class ThumbnailCache final : public QObject
+{
+	Q_OBJECT
+
+public:
+	static constexpr int ThumbnailSize = 128;
+
+	ThumbnailCache(ColorSettings* colorSettings, const QString& cacheDirectory, QObject* parent = nullptr);
+	~ThumbnailCache();
+
+	/**
+	*	@brief Returns the thumbnail for the given file.
+	*	If the thumbnail isn't known yet it is rendered in the background and a null image is returned.
+	*	@ref ThumbnailReady is emitted once the thumbnail is available.
+	*	A null image is also returned if the file could not be drawn, for instance if OpenGL framebuffers aren't supported.
+	*/
+	QImage GetThumbnail(AssetProvider* provider, const QFileInfo& fileInfo);
+
+	/**
+	*	@brief Discards requests that haven't started rendering yet.
+	*/
+	void CancelPendingRequests();
+
+signals:
+	void ThumbnailReady(const QString& fileName);
+
+private:
+	struct Entry
+	{
+		qint64 Size{};
+		qint64 LastModified{};
+		QImage Image;
+	};
+
+	void OnThumbnailRendered(const QString& fileName, qint64 size, qint64 lastModified, const QImage& image);
+
+private:
+	ColorSettings* const _colorSettings;
+
+	QThread _thread;
+	std::unique_ptr<QOffscreenSurface> _surface;
+	std::unique_ptr<ThumbnailRenderer> _renderer;
+
+	// Requests queued before the current generation are skipped by the render thread.
+	std::atomic<quint64> _generation{0};
+
+	// Keyed by absolute file name. Cost is in kilobytes.
+	QCache<QString, Entry> _thumbnails;
+	QSet<QString> _pendingRequests;
+};
@@ -10,6 +10,9 @@
 #include <Windows.h>
 #include <fcntl.h>
 #include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 
 FILE* utf8_fopen(const char* filename, const char* mode)
@@ -88,3 +91,83 @@ std::tuple<std::unique_ptr<std::byte[]>, size_t> ReadFileIntoBuffer(FILE* file)
 
 	return { std::move(buffer), size };
 }
+
+std::tuple<const std::byte*, size_t> MapFileIntoMemory(FILE* file, bool readAhead)
+{
+	assert(file);
+
+#ifdef WIN32
+	const auto fileHandle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return {};
+	}
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart <= 0)
+	{
+		return {};
+	}
+
+	const HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!mapping)
+	{
+		return {};
+	}
+
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	// The view keeps the mapping alive.
+	CloseHandle(mapping);
+
+	if (!data)
+	{
+		return {};
+	}
+
+	return { static_cast<const std::byte*>(data), static_cast<size_t>(size.QuadPart) };
+#else
+	const int fd = fileno(file);
+
+	struct stat info;
+
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0)
+	{
+		return {};
+	}
+
+	const size_t size = static_cast<size_t>(info.st_size);
+
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	if (data == MAP_FAILED)
+	{
+		return {};
+	}
+
+	// If the caller is going to use the whole file ask the kernel to start reading it in now.
+	if (readAhead)
+	{
+		madvise(data, size, MADV_WILLNEED);
+	}
+
+	return { static_cast<const std::byte*>(data), size };
+#endif
+}
+
+void UnmapFileFromMemory(const std::byte* data, size_t size)
+{
+	if (!data)
+	{
+		return;
+	}
+
+#ifdef WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(const_cast<std::byte*>(data), size);
+#endif
+}
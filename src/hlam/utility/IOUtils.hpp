@@ -37,3 +37,13 @@ inline FILE* utf8_exclusive_read_fopen(const char8_t* filename, bool asBinary)
 }
 
 std::tuple<std::unique_ptr<std::byte[]>, size_t> ReadFileIntoBuffer(FILE* file);
+
+/**
+*	@brief Maps the entire contents of the given file into memory as read-only data.
+*	The mapping remains valid after the file has been closed and must be released with @see UnmapFileFromMemory.
+*	@param readAhead Whether to start reading the entire file in right away. Disable this if only parts of the file are used.
+*	@return Pointer to the start of the mapping and its size in bytes, or a null pointer if the file could not be mapped.
+*/
+std::tuple<const std::byte*, size_t> MapFileIntoMemory(FILE* file, bool readAhead = true);
+
+void UnmapFileFromMemory(const std::byte* data, size_t size);
@@ -0,0 +1,157 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "utility/IOUtils.hpp"
+#include "utility/Profiling.hpp"
+
+namespace profiling
+{
+namespace
+{
+// Limits memory usage if a session is left running. Roughly 32 MiB worth of events.
+constexpr std::size_t MaxEvents = 1 << 20;
+
+struct Event
+{
+	const char* Name;
+	Clock::time_point Start;
+	Clock::time_point End;
+	std::uint32_t ThreadId;
+};
+
+struct Session
+{
+	std::mutex Mutex;
+	std::vector<Event> Events;
+	std::unordered_map<std::thread::id, std::uint32_t> ThreadIds;
+	std::size_t DroppedEventsCount = 0;
+	Clock::time_point StartTime;
+};
+
+std::atomic<bool> Recording{false};
+
+Session& GetSession()
+{
+	static Session session;
+	return session;
+}
+
+void WriteEscaped(FILE* file, const char* text)
+{
+	for (; *text; ++text)
+	{
+		switch (*text)
+		{
+		case '"': std::fputs("\\\"", file); break;
+		case '\\': std::fputs("\\\\", file); break;
+		default: std::fputc(*text, file); break;
+		}
+	}
+}
+}
+
+bool IsRecording()
+{
+	return Recording.load(std::memory_order_relaxed);
+}
+
+void StartRecording()
+{
+	auto& session = GetSession();
+
+	{
+		const std::lock_guard lock{session.Mutex};
+		session.Events.clear();
+		session.ThreadIds.clear();
+		session.DroppedEventsCount = 0;
+		session.StartTime = Clock::now();
+	}
+
+	Recording.store(true, std::memory_order_relaxed);
+}
+
+bool StopRecording(const char* fileName)
+{
+	Recording.store(false, std::memory_order_relaxed);
+
+	auto& session = GetSession();
+
+	std::vector<Event> events;
+	std::size_t droppedEventsCount;
+	Clock::time_point startTime;
+
+	{
+		const std::lock_guard lock{session.Mutex};
+		events.swap(session.Events);
+		droppedEventsCount = session.DroppedEventsCount;
+		startTime = session.StartTime;
+	}
+
+	const FilePtr file{utf8_fopen(fileName, "w")};
+
+	if (!file)
+	{
+		return false;
+	}
+
+	const auto toMicroseconds = [](Clock::duration duration)
+	{
+		return std::chrono::duration<double, std::micro>(duration).count();
+	};
+
+	fmt::print(file.get(), "{{\"displayTimeUnit\":\"ms\",\"otherData\":{{\"droppedEvents\":{}}},\"traceEvents\":[",
+		droppedEventsCount);
+
+	bool first = true;
+
+	for (const auto& event : events)
+	{
+		if (!first)
+		{
+			std::fputc(',', file.get());
+		}
+
+		first = false;
+
+		std::fputs("\n{\"name\":\"", file.get());
+		WriteEscaped(file.get(), event.Name);
+		fmt::print(file.get(), "\",\"cat\":\"hlam\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+			toMicroseconds(event.Start - startTime), toMicroseconds(event.End - event.Start), event.ThreadId);
+	}
+
+	std::fputs("\n]}\n", file.get());
+
+	return std::ferror(file.get()) == 0;
+}
+
+void RecordEvent(const char* name, Clock::time_point start, Clock::time_point end)
+{
+	auto& session = GetSession();
+
+	const std::lock_guard lock{session.Mutex};
+
+	// The session may have been stopped while this event was being timed.
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	if (session.Events.size() >= MaxEvents)
+	{
+		++session.DroppedEventsCount;
+		return;
+	}
+
+	const auto threadId = session.ThreadIds.try_emplace(
+		std::this_thread::get_id(), static_cast<std::uint32_t>(session.ThreadIds.size() + 1)).first->second;
+
+	session.Events.push_back({name, start, end, threadId});
+}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+
+/**
+*	@file
+*	Lightweight scoped timers that can be recorded to a Chrome trace file.
+*	Timers are only active if the program was built with HLAM_ENABLE_PROFILING defined.
+*/
+
+namespace profiling
+{
+using Clock = std::chrono::steady_clock;
+
+/**
+*	@brief Whether the program was built with profiling support.
+*/
+constexpr bool IsAvailable()
+{
+#ifdef HLAM_ENABLE_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+*	@brief Whether a profiling session is being recorded.
+*/
+bool IsRecording();
+
+/**
+*	@brief Starts recording a profiling session. Events from a previous session are discarded.
+*/
+void StartRecording();
+
+/**
+*	@brief Stops recording and writes the session to @p fileName in the Chrome trace event format.
+*	The file can be opened in chrome://tracing or the Perfetto UI.
+*	@return Whether the file was written successfully
+*/
+bool StopRecording(const char* fileName);
+
+/**
+*	@brief Adds an event to the session being recorded. @p name must remain valid until the session is stopped.
+*/
+void RecordEvent(const char* name, Clock::time_point start, Clock::time_point end);
+
+/**
+*	@brief Records the time spent in the scope it's declared in. Use HLAM_PROFILE_SCOPE instead of using this directly.
+*/
+class ScopedTimer final
+{
+public:
+	explicit ScopedTimer(const char* name)
+		: _name(name)
+		, _recording(IsRecording())
+	{
+		if (_recording)
+		{
+			_start = Clock::now();
+		}
+	}
+
+	~ScopedTimer()
+	{
+		if (_recording)
+		{
+			RecordEvent(_name, _start, Clock::now());
+		}
+	}
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+	const char* const _name;
+	const bool _recording;
+	Clock::time_point _start;
+};
+}
+
+#define HLAM_PROFILE_CONCAT_IMPL(a, b) a##b
+#define HLAM_PROFILE_CONCAT(a, b) HLAM_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef HLAM_ENABLE_PROFILING
+/**
+*	@brief Records the time spent in the current scope under the given name, which must be a string literal.
+*/
+#define HLAM_PROFILE_SCOPE(name) const profiling::ScopedTimer HLAM_PROFILE_CONCAT(profileScopedTimer, __LINE__){name}
+#else
+#define HLAM_PROFILE_SCOPE(name)
+#endif
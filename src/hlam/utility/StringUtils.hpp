@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <cctype>
 #include <cstring>
+#include <string>
+#include <string_view>
 
 inline const char* UTIL_CopyString(char* dest, const char* source, std::size_t destSizeInBytes)
 {
@@ -18,3 +22,18 @@ inline const char* UTIL_CopyString(char (&dest)[Size], const char* source)
 {
 	return UTIL_CopyString(dest, source, sizeof(dest));
 }
+
+/**
+*	@brief Returns a copy of @p text with ASCII characters converted to lowercase.
+*/
+inline std::string UTIL_ToLower(std::string_view text)
+{
+	std::string result{text};
+
+	std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c)
+		{
+			return static_cast<char>(std::tolower(c));
+		});
+
+	return result;
+}
@@ -1,14 +1,8 @@
 #include "utility/WorldTime.hpp"
 
-void WorldTime::TimeChanged(double currentTime)
+void WorldTime::AdvanceTime(float stepTime)
 {
-	double frameTime = currentTime - GetPreviousRealTime();
-
-	if (frameTime > 1.0)
-		frameTime = 0.1;
-
 	SetPreviousTime(GetTime());
-	SetTime(static_cast<float>(GetTime() + frameTime));
-	SetFrameTime(static_cast<float>(frameTime));
-	SetPreviousRealTime(GetRealTime());
+	SetTime(GetTime() + stepTime);
+	SetFrameTime(stepTime);
 }
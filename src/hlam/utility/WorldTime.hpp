@@ -61,9 +61,17 @@ public:
 	void SetPreviousRealTime(double realTime) { _prevRealTime = realTime; }
 
 	/**
-	*	@brief Call with the new current time to update world time.
+	*	@brief Gets how far rendering is between the previous and the current simulation step, in the range [0, 1].
+	*	Used to interpolate entity state when drawing frames in between simulation steps.
 	*/
-	void TimeChanged(double currentTime);
+	float GetInterpolationFactor() const { return _interpolationFactor; }
+
+	void SetInterpolationFactor(float interpolationFactor) { _interpolationFactor = interpolationFactor; }
+
+	/**
+	*	@brief Advances the current time by a single simulation step.
+	*/
+	void AdvanceTime(float stepTime);
 
 private:
 	float _currentTime = 1.0f;
@@ -71,4 +79,5 @@ private:
 	float _frameTime = 0.0f;
 	double _realTime = 0.0f;
 	double _prevRealTime = 0.0f;
+	float _interpolationFactor = 1.0f;
 };
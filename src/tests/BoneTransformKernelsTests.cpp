@@ -0,0 +1,190 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include <glm/common.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "formats/studiomodel/BoneTransformKernels.hpp"
+
+using namespace studiomdl;
+
+namespace
+{
+// The vectorized kernels approximate the trigonometric functions, so they are compared with a tolerance.
+constexpr float Tolerance = 1e-5f;
+
+constexpr int Iterations = 1000;
+
+int FailureCount = 0;
+
+void Check(bool condition, const char* test, std::size_t bone)
+{
+	if (!condition)
+	{
+		if (FailureCount < 10)
+		{
+			std::printf("%s: bone %zu differs from glm\n", test, bone);
+		}
+
+		++FailureCount;
+	}
+}
+
+bool IsClose(float lhs, float rhs)
+{
+	return std::abs(lhs - rhs) <= Tolerance;
+}
+
+bool IsClose(const BoneQuaternions& quaternions, std::size_t bone, const glm::quat& expected)
+{
+	return IsClose(quaternions[0][bone], expected.x) && IsClose(quaternions[1][bone], expected.y)
+		&& IsClose(quaternions[2][bone], expected.z) && IsClose(quaternions[3][bone], expected.w);
+}
+
+glm::quat GetQuaternion(const BoneQuaternions& quaternions, std::size_t bone)
+{
+	return {quaternions[3][bone], quaternions[0][bone], quaternions[1][bone], quaternions[2][bone]};
+}
+
+void SetQuaternion(BoneQuaternions& quaternions, std::size_t bone, const glm::quat& q)
+{
+	quaternions[0][bone] = q.x;
+	quaternions[1][bone] = q.y;
+	quaternions[2][bone] = q.z;
+	quaternions[3][bone] = q.w;
+}
+
+void TestAnglesToQuaternions(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> angleDistribution{-2 * glm::pi<float>(), 2 * glm::pi<float>()};
+
+	for (int iteration = 0; iteration < Iterations; ++iteration)
+	{
+		BoneVectors angles;
+		BoneQuaternions quaternions;
+
+		for (auto& component : angles)
+		{
+			for (auto& angle : component)
+			{
+				angle = angleDistribution(random);
+			}
+		}
+
+		AnglesToQuaternions(MAXSTUDIOBONES, angles, quaternions);
+
+		for (std::size_t bone = 0; bone < MAXSTUDIOBONES; ++bone)
+		{
+			const glm::quat expected{glm::vec3{angles[0][bone], angles[1][bone], angles[2][bone]}};
+
+			Check(IsClose(quaternions, bone, expected), "AnglesToQuaternions", bone);
+		}
+	}
+}
+
+void TestSlerpQuaternions(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> angleDistribution{-glm::pi<float>(), glm::pi<float>()};
+	std::uniform_real_distribution<float> offsetDistribution{-1e-3f, 1e-3f};
+	std::uniform_real_distribution<float> fractionDistribution{0.f, 1.f};
+
+	const auto randomQuaternion = [&]
+	{
+		return glm::quat{glm::vec3{angleDistribution(random), angleDistribution(random), angleDistribution(random)}};
+	};
+
+	for (int iteration = 0; iteration < Iterations; ++iteration)
+	{
+		BoneQuaternions from;
+		BoneQuaternions to;
+
+		for (std::size_t bone = 0; bone < MAXSTUDIOBONES; ++bone)
+		{
+			const glm::quat q = randomQuaternion();
+
+			SetQuaternion(to, bone, q);
+
+			// Cover identical, nearly identical, opposite hemisphere and unrelated rotations.
+			switch (bone % 4)
+			{
+			case 0: SetQuaternion(from, bone, q); break;
+			case 1: SetQuaternion(from, bone, glm::normalize(q * glm::quat{glm::vec3{offsetDistribution(random)}})); break;
+			case 2: SetQuaternion(from, bone, -randomQuaternion()); break;
+			case 3: SetQuaternion(from, bone, randomQuaternion()); break;
+			}
+		}
+
+		const float s = fractionDistribution(random);
+
+		BoneQuaternions result = to;
+
+		SlerpQuaternions(MAXSTUDIOBONES, s, from, result);
+
+		for (std::size_t bone = 0; bone < MAXSTUDIOBONES; ++bone)
+		{
+			const glm::quat expected = glm::slerp(GetQuaternion(to, bone), GetQuaternion(from, bone), s);
+
+			Check(IsClose(result, bone, expected), "SlerpQuaternions", bone);
+		}
+	}
+}
+
+void TestLerpVectors(std::mt19937& random)
+{
+	std::uniform_real_distribution<float> distribution{-1000.f, 1000.f};
+	std::uniform_real_distribution<float> fractionDistribution{0.f, 1.f};
+
+	for (int iteration = 0; iteration < Iterations; ++iteration)
+	{
+		BoneVectors from;
+		BoneVectors to;
+
+		for (std::size_t component = 0; component < 3; ++component)
+		{
+			for (std::size_t bone = 0; bone < MAXSTUDIOBONES; ++bone)
+			{
+				from[component][bone] = distribution(random);
+				to[component][bone] = distribution(random);
+			}
+		}
+
+		const float s = fractionDistribution(random);
+
+		BoneVectors result = to;
+
+		LerpVectors(MAXSTUDIOBONES, s, from, result);
+
+		for (std::size_t bone = 0; bone < MAXSTUDIOBONES; ++bone)
+		{
+			const glm::vec3 expected = glm::mix(
+				glm::vec3{to[0][bone], to[1][bone], to[2][bone]},
+				glm::vec3{from[0][bone], from[1][bone], from[2][bone]},
+				s);
+
+			// Positions are in model units, so allow for rounding relative to their size.
+			Check(std::abs(result[0][bone] - expected.x) <= 1e-3f
+				&& std::abs(result[1][bone] - expected.y) <= 1e-3f
+				&& std::abs(result[2][bone] - expected.z) <= 1e-3f, "LerpVectors", bone);
+		}
+	}
+}
+}
+
+int main()
+{
+	std::mt19937 random{12345};
+
+	TestAnglesToQuaternions(random);
+	TestSlerpQuaternions(random);
+	TestLerpVectors(random);
+
+	if (FailureCount > 0)
+	{
+		std::printf("%d checks failed\n", FailureCount);
+		return 1;
+	}
+
+	return 0;
+}